@@ -0,0 +1,106 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include <opencv2/core.hpp>
+
+#include "benchmark_utils.hpp"
+#include "listener_processing/DepthMedianFilter.h"
+
+namespace
+{
+    // Copy of the median filter GridFrame applied before DepthMedianFilter replaced it, gathering each window into a
+    // freshly allocated vector and sorting it
+    float floorMedianFilter(std::vector<float>& window)
+    {
+        const auto max_it = std::max_element(window.begin(), window.end());
+        if (max_it != window.end() && *max_it > 0.0f)
+        {
+            std::sort(window.begin(), window.end());
+            const size_t length = window.size();
+            if (length % 2 == 1)
+            {
+                return window[std::floor(length / 2)];
+            }
+            return window[std::floor(length / 2) - 1];
+        }
+        return 0.0f;
+    }
+
+    void applyCustomFilter(const cv::Mat& image, cv::Mat& new_image, const int kernel_size)
+    {
+        const int half_kernel_size = std::floor((kernel_size + 1) / 2);
+        for (int i = 0; i < image.rows; ++i)
+        {
+            for (int j = 0; j < image.cols; ++j)
+            {
+                const int window_top = std::max(0, i - half_kernel_size);
+                const int window_lft = std::max(0, j - half_kernel_size);
+                const int window_btm = std::min(image.rows, i + half_kernel_size);
+                const int window_rgt = std::min(image.cols, j + half_kernel_size);
+                std::vector<float> window;
+                for (int n = window_top; n < window_btm; ++n)
+                {
+                    for (int m = window_lft; m < window_rgt; ++m)
+                    {
+                        float pixel = image.at<float>(n, m);
+                        if (pixel > 0)
+                        {
+                            window.push_back(pixel);
+                        }
+                    }
+                }
+                new_image.at<float>(i, j) = floorMedianFilter(window);
+            }
+        }
+    }
+}
+
+// Compares DepthMedianFilter with the former GridFrame filter on random depth images the size of a Cepton mode 4 grid,
+// from sparse lidar-like densities up to fully valid images
+int main()
+{
+    constexpr int rows = 368;
+    constexpr int cols = 1000;
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> depth(0.5f, 30.0f);
+
+    std::printf("%8s %4s %12s %12s %12s %6s\n", "density", "k", "former ms", "1 thread ms", "all ms", "equal");
+    for (const float density : {0.15f, 0.5f, 1.0f})
+    {
+        std::bernoulli_distribution valid(density);
+        cv::Mat depth_image(rows, cols, CV_32FC1);
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                depth_image.at<float>(i, j) = valid(rng) ? depth(rng) : 0.0f;
+            }
+        }
+
+        for (const int kernel_size : {3, 5, 7})
+        {
+            cv::Mat former_image(rows, cols, CV_32FC1);
+            cv::Mat filtered_image(rows, cols, CV_32FC1);
+            const DepthMedianFilter single_thread_filter(kernel_size, 1);
+            const DepthMedianFilter filter(kernel_size);
+            const double former_ms = benchmark_utils::medianMilliseconds([&]()
+            {
+                applyCustomFilter(depth_image, former_image, kernel_size);
+            }, 5);
+            const double single_thread_ms = benchmark_utils::medianMilliseconds([&]()
+            {
+                single_thread_filter.filter(depth_image, filtered_image);
+            }, 20);
+            const double all_ms = benchmark_utils::medianMilliseconds([&]()
+            {
+                filter.filter(depth_image, filtered_image);
+            }, 20);
+            const bool equal = std::equal(former_image.begin<float>(), former_image.end<float>(), filtered_image.begin<float>());
+            std::printf("%7.0f%% %4d %12.3f %12.3f %12.3f %6s\n", 100.0f * density, kernel_size, former_ms, single_thread_ms, all_ms, equal ? "yes" : "no");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <cstdio>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "benchmark_utils.hpp"
+#include "listener_utils/PlyReader.h"
+#include "listener_processing/GridProjector.h"
+#include "listener_processing/ProjectionLut.h"
+
+// Compares organizing the Cepton sample cloud through a ProjectionLut with projecting every point directly, for the
+// sample as recorded and tiled into denser clouds whose copies are jittered in range and carry their own beam IDs
+int main()
+{
+    const PlyReader ply_reader(std::string(LISTENERLIBLITE_RESOURCES_DIR) + "/cepton_test_data.ply");
+    std::vector<float> pattern(3 * ply_reader.getVertexCount());
+    ply_reader.readPoints(pattern.data());
+    const size_t num_pattern_beams = ply_reader.getVertexCount();
+
+    // Cepton modes 2 and 4
+    const int resolutions[][3] = {{184, 500, 433}, {368, 1000, 866}};
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> range_scale(0.99f, 1.01f);
+
+    std::printf("%8s %10s %8s %12s %12s\n", "points", "grid", "threads", "direct ms", "lut ms");
+    for (const int num_copies : {1, 8})
+    {
+        std::vector<float> points;
+        std::vector<uint32_t> beam_ids;
+        for (int c = 0; c < num_copies; ++c)
+        {
+            for (size_t b = 0; b < num_pattern_beams; ++b)
+            {
+                const float scale = range_scale(rng);
+                points.insert(points.end(), {scale * pattern[3 * b], scale * pattern[3 * b + 1], scale * pattern[3 * b + 2]});
+                beam_ids.push_back(static_cast<uint32_t>(c * num_pattern_beams + b));
+            }
+        }
+
+        for (const auto& resolution : resolutions)
+        {
+            const int rows = resolution[0];
+            const int cols = resolution[1];
+            Eigen::Matrix3f intrinsic;
+            intrinsic << static_cast<float>(resolution[2]), 0.0f, cols / 2.0f, 0.0f, static_cast<float>(resolution[2]), rows / 2.0f, 0.0f, 0.0f, 1.0f;
+            Eigen::Tensor<float, 3> grid(rows, cols, 3);
+
+            for (const unsigned int num_threads : {1u, 0u})
+            {
+                GridProjector projector(intrinsic, rows, cols, num_threads);
+                ProjectionLut lut(intrinsic, rows, cols, beam_ids.size());
+                const double direct_ms = benchmark_utils::medianMilliseconds([&]()
+                {
+                    grid.setZero();
+                    projector.project(points.data(), beam_ids.size(), grid);
+                });
+                const double lut_ms = benchmark_utils::medianMilliseconds([&]()
+                {
+                    grid.setZero();
+                    projector.project(points.data(), beam_ids.data(), beam_ids.size(), lut, grid);
+                });
+                std::printf("%8zu %5dx%-4d %8s %12.3f %12.3f\n", beam_ids.size(), rows, cols, num_threads == 0 ? "all" : "1", direct_ms, lut_ms);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef BENCHMARKUTILS_HPP
+#define BENCHMARKUTILS_HPP
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+namespace benchmark_utils
+{
+    /*!
+     * @brief Helper function to time a callable, reporting the median of several runs after one warm-up run.
+     *
+     * @param func Callable to time
+     * @param num_runs Number of timed runs
+     * @return Median run time in milliseconds
+     */
+    template <typename Func>
+    double medianMilliseconds(Func&& func, const int num_runs = 50)
+    {
+        func();
+        std::vector<double> times;
+        times.reserve(num_runs);
+        for (int r = 0; r < num_runs; ++r)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            func();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        return times[times.size() / 2];
+    }
+}
+
+#endif // BENCHMARKUTILS_HPP
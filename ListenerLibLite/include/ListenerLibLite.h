@@ -5,6 +5,7 @@
 #include "emulation_listeners.h"
 #include "listener_frames.h"
 #include "listener_utils.h"
+#include "listener_processing.h"
 #include "sensor_interfaces.h"
 
 #endif //LISTENERLIBLITE_H
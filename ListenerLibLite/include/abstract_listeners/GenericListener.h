@@ -2,6 +2,7 @@
 #define GENERICLISTENER_H
 
 class CompositeFrame;
+class ProcessingStage;
 
 #include <string>
 #include <vector>
@@ -10,9 +11,12 @@ class CompositeFrame;
 #include <queue>
 #include <memory>
 #include <chrono>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 
+#include "listener_utils/AsyncFrameWriter.h"
+
 /*!
  * @brief Abstract base class that represents a general template for sensor listeners.
  * 
@@ -32,6 +36,11 @@ class GenericListener
 	bool m_newFrame = false;
 	std::mutex m_queueMutex;
 	std::condition_variable m_queueEvent;
+	std::condition_variable m_queueSpaceEvent;
+	std::atomic<size_t> m_nextSequenceNumber{0};
+
+	std::vector<std::shared_ptr<ProcessingStage>> m_stageVec;
+	std::mutex m_stageMutex;
 
 protected:
 
@@ -42,11 +51,25 @@ protected:
 	
 	/*!
 	 * @brief Protected method used by an implemented subclasses to add the given CompositeFrame object to its frame queue.
+	 *
+	 * Assigns the CompositeFrame the listener's next sequence number, then runs all registered ProcessingStage objects on
+	 * it in registration order before queueing it.
 	 * 
 	 * @param p_composite_frame Pointer to an object containing individual data frames returned by the sensor in standardized format
 	 */
 	void addToQueue(std::shared_ptr<CompositeFrame> p_composite_frame);
 
+	/*!
+	 * @brief Protected method used by subclasses producing frames faster than real time to wait for the consumer.
+	 *
+	 * Blocks until fewer than the given number of frames are queued or the timeout expires.
+	 *
+	 * @param max_queued Number of queued frames above which to wait
+	 * @param timeout Maximum time to wait
+	 * @return true if there is room in the queue, false if the timeout expired first
+	 */
+	bool waitForQueueSpace(size_t max_queued, const std::chrono::milliseconds& timeout);
+
 public:
 
 	/*!
@@ -97,6 +120,20 @@ public:
 	 */
 	void setTimeoutDuration(const std::chrono::milliseconds& timeout_duration);
 
+	/*!
+	 * @brief Registers a processing stage to be run on every CompositeFrame before it is added to the frame queue.
+	 *
+	 * Stages run in registration order on the thread producing the frames.
+	 *
+	 * @param p_stage Pointer to the ProcessingStage object, which should not be shared with other listeners
+	 */
+	void addProcessingStage(std::shared_ptr<ProcessingStage> p_stage);
+
+	/*!
+	 * @brief Removes all registered processing stages.
+	 */
+	void clearProcessingStages();
+
 	/*!
 	 * @brief Abstract method that subclasses must implement with sensor-specific API calls to start the sensor stream.
 	 * 
@@ -171,10 +208,15 @@ public:
 
 	/*!
 	 * @brief Writes live sensor stream to file in provided directory.
+	 *
+	 * Consumes every queued frame in order with GenericListener::getNextFrame and hands it to an AsyncFrameWriter, so
+	 * encoding runs in the background and only frames dropped by a DROP overflow policy are lost. Stops once no frame
+	 * arrives within the queue timeout, then finishes writing and prints the writer statistics.
 	 * 
 	 * @param dump_dir Path to directory where frames will be saved
+	 * @param writer_params Encoder thread count, queue bound in frames, overflow behaviour, and file layout of the background writer
 	 */
-	void dumpStream(const std::string& dump_dir);
+	void dumpStream(const std::string& dump_dir, const WriterParameters& writer_params = WriterParameters());
 };
 
 #endif // GENERICLISTENER_H
\ No newline at end of file
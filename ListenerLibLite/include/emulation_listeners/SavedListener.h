@@ -2,21 +2,100 @@
 #define SAVEDLISTENER_H
 
 class SensorInterface;
+class RecordingReader;
+class DatasetIndex;
+class GenericDataFrame;
 
 #include <string>
 #include <vector>
+#include <map>
+#include <deque>
 #include <unordered_map>
 #include <memory>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "listener_utils/general_utils.hpp"
 #include "abstract_listeners/ThreadListener.h"
 #include "abstract_listeners/SingleListener.h"
 
+/*!
+ * @brief Enum class identifying the clock a SavedListener replays frames by.
+ *
+ * FIXED_RATE: One frame per period of the sensor framerate, scheduled against absolute deadlines so that the rate does not drift
+ * RECORDED: Frames spaced as their recorded timestamps, available for recording containers and indexed recorded directories
+ * AS_FAST_AS_POSSIBLE: Frames published as soon as they are decoded, waiting only for the consumer to drain the queue
+ */
+enum class PlaybackTiming
+{
+	FIXED_RATE,
+	RECORDED,
+	AS_FAST_AS_POSSIBLE
+};
+
+/*!
+ * @brief Container for the read-ahead and timing settings of a SavedListener.
+ *
+ * m_prefetchFrames: Number of frames decoded ahead of the one being published, at least 1
+ * m_numThreads: Number of decoder threads, 0 means use all hardware threads
+ * m_timing: Clock frames are replayed by
+ * m_speed: Playback speed multiplier of FIXED_RATE and RECORDED timing
+ * m_maxQueuedFrames: Number of unconsumed frames at which AS_FAST_AS_POSSIBLE playback waits for the consumer
+ * m_retainedFrames: Number of published frames kept decoded behind the cursor for backward seeks and steps, at the cost of
+ * publishing every frame as a copy
+ * m_beginFrame: Index of the first frame to play
+ * m_endFrame: One past the index of the last frame to play, clamped to the number of saved frames
+ * m_startPaused: Whether the stream starts paused, publishing frames only when stepped or seeked
+ * m_loop: Whether playback returns to the start of the range after its last frame instead of stopping
+ * m_cacheBytes: Memory budget in bytes for decoded frames kept for later passes over the range, 0 disables the cache
+ */
+struct PlaybackParameters
+{
+	size_t m_prefetchFrames = 8;
+	unsigned int m_numThreads = 0;
+	PlaybackTiming m_timing = PlaybackTiming::FIXED_RATE;
+	float m_speed = 1.0f;
+	size_t m_maxQueuedFrames = 8;
+	size_t m_retainedFrames = 0;
+	size_t m_beginFrame = 0;
+	size_t m_endFrame = std::numeric_limits<size_t>::max();
+	bool m_startPaused = false;
+	bool m_loop = false;
+	size_t m_cacheBytes = 0;
+};
+
 /*!
  * @brief Implemented subclass that emulates an arbitrary sensor by adding previously saved data to queue.
  * 
  * Inherits SingleListener and ThreadListener. Initialized with parameters of sensor to be emulated via
  * constructor and by loading relevant camera parameters and extrinsic matrix.
+ *
+ * Saved data is either a directory of per-FrameID folders as written by CompositeFrame::saveAll, or a single recording
+ * container as read by RecordingReader, whose stored camera parameters, extrinsic matrix, and frame timestamps are used.
+ * Directories are opened through their cached DatasetIndex, which aligns the folders by frame number and carries frame
+ * timestamps for directories recorded by AsyncFrameWriter.
+ *
+ * Frames are loaded and resized ahead of time by a pool of decoder threads, up to m_prefetchFrames frames ahead of the
+ * stream, with each FrameID of a frame decoded as a separate job. The stream thread only publishes frames that are
+ * already decoded, so file loading, image decompression, and point cloud projection do not eat into the frame period.
+ *
+ * Each published CompositeFrame is stamped with its scheduled presentation time rather than the time it happened to be
+ * published, unless its data frames carry their recorded timestamps. A frame published more than one period late
+ * restarts the schedule from the current time, so that a stall is not followed by a burst of frames.
+ *
+ * Playback follows a cursor over the frame indices that can be moved at any time with SavedListener::seek and
+ * SavedListener::step, and is limited to the range set by SavedListener::setRange. The prefetch window follows the
+ * cursor, so frames ahead of it are already decoded when playback or stepping reaches them, and frames kept by
+ * m_retainedFrames make stepping back just as fast. Stopping and restarting the stream resumes from the cursor.
+ *
+ * In loop mode the prefetch window wraps around to the start of the range, so playback continues past the last frame
+ * without a stall. Published frames are kept in a decoded-frame cache until m_cacheBytes is spent, and every later pass
+ * serves them as copies from memory instead of decoding them again; the whole range is served from memory when it fits.
+ * Frames of later passes are stamped with their scheduled presentation time, so timestamps keep increasing across loops.
+ * The cache outlives stopping and restarting the stream.
  */
 class SavedListener final : public ThreadListener, public SingleListener
 {
@@ -24,29 +103,145 @@ class SavedListener final : public ThreadListener, public SingleListener
 
 	size_t m_numFiles;
 
-	std::unordered_map<FrameID, std::vector<std::string>> m_fileVectMap;
+	std::unique_ptr<DatasetIndex> m_datasetIndexPtr;
+	std::unique_ptr<RecordingReader> m_recordingPtr;
+	std::vector<FrameID> m_frameIDs;
+
+	struct PrefetchSlot
+	{
+		size_t m_index;
+		std::unordered_map<FrameID, std::shared_ptr<GenericDataFrame>> m_dataFrames;
+		size_t m_remaining = 0;
+		bool m_failed = false;
+		bool m_cancelled = false;
+	};
+
+	struct DecodeJob
+	{
+		std::shared_ptr<PrefetchSlot> m_slotPtr;
+		FrameID m_frameID;
+	};
+
+	const PlaybackParameters m_playbackParams;
+
+	std::map<size_t, std::shared_ptr<PrefetchSlot>> m_window;
+	std::deque<std::shared_ptr<PrefetchSlot>> m_retained;
+	std::unordered_map<size_t, std::shared_ptr<PrefetchSlot>> m_cache;
+	size_t m_cachedBytes = 0;
+	std::deque<DecodeJob> m_decodeJobs;
+	bool m_stopDecoding = false;
+	mutable std::mutex m_prefetchMutex;
+	std::condition_variable m_decodeEvent;
+	std::condition_variable m_readyEvent;
+	std::vector<std::thread> m_decoders;
+
+	size_t m_cursor = 0;
+	size_t m_beginIndex = 0;
+	size_t m_endIndex = 0;
+	size_t m_lastPublished = 0;
+	bool m_hasPublished = false;
+	bool m_paused;
+	bool m_stepPending = false;
+
+	bool hasRecordedTimestamps() const;
+	std::chrono::microseconds getRecordedTimestamp(size_t index) const;
+	std::shared_ptr<GenericDataFrame> loadDataFrame(size_t index, FrameID frame_id) const;
+	void schedule(size_t index);
+	size_t getWindowOffset(size_t index) const;
+	void updateWindow();
+	bool cache(const std::shared_ptr<PrefetchSlot>& p_slot);
+	void decoderLoop();
+	void startDecoders();
+	void stopDecoders();
 
 public:
 
 	/*!
 	 * @brief Constructor method, initializes subclass and superclass members.
 	 * 
-	 * @param frame_id_vec Vector of identifiers that inform what frame types will be used, empty means assume raw point cloud data
-	 * @param data_dir Directory path containing frame data folders and sensor data to be used
+	 * @param frame_id_vec Vector of identifiers that inform what frame types will be used, empty means assume raw point cloud data,
+	 * or all recorded frame types for a recording container
+	 * @param data_dir Directory path containing frame data folders and sensor data to be used, or path to a recording container
 	 * @param p_sensor_interface Pointer to object containing information about a connected or hypothetical physical sensor
 	 * @param name Unique name of emulated sensor
 	 * @param resize_factor A scaling factor the sensor applies to all produced data
-	 * @param repeat Boolean informing whether last frame of save data should be repeated indefinitely
+	 * @param repeat Boolean informing whether last frame of save data should be repeated indefinitely, which is decoded once
+	 * and republished as copies with fresh timestamps
+	 * @param playback_params Read-ahead depth, decoder thread count, and replay timing
 	 */
-	SavedListener(std::vector<FrameID> frame_id_vec, const std::string& data_dir, std::shared_ptr<SensorInterface> p_sensor_interface, const std::string& name = "", const float resize_factor = 1.0f, const bool repeat = false);
+	SavedListener(std::vector<FrameID> frame_id_vec, const std::string& data_dir, std::shared_ptr<SensorInterface> p_sensor_interface, const std::string& name = "", const float resize_factor = 1.0f, const bool repeat = false, const PlaybackParameters& playback_params = PlaybackParameters());
+
+	/*!
+	 * @brief Destructor method.
+	 */
+	~SavedListener() override;
 
 	/*!
 	 * @brief Implements ThreadListener::streamLoop.
 	 *
-	 * In another thread, reads in data frames from internal file lists using the appropriate loading methods
-	 * and adds them to queue as a CompositeFrame. Sleeps after each addition to emulate given framerate.
+	 * In another thread, starts the decoder threads, waits for each prefetched frame to finish decoding, and adds it to
+	 * queue as a CompositeFrame at the time given by the playback timing.
 	 */
 	void streamLoop() override;
+
+	/*!
+	 * @brief Getter for the number of saved frames available for playback.
+	 *
+	 * @return Number of frames, regardless of the playback range
+	 */
+	size_t getNumFrames() const;
+
+	/*!
+	 * @brief Getter for the playback cursor.
+	 *
+	 * @return Index of the next frame to be published
+	 */
+	size_t getCursor() const;
+
+	/*!
+	 * @brief Moves the playback cursor to a frame, publishing it immediately if playback is paused.
+	 *
+	 * @param index Index of the frame, clamped to the playback range
+	 */
+	void seek(size_t index);
+
+	/*!
+	 * @brief Moves the playback cursor to the first frame recorded at or after a time, publishing it immediately if playback is paused.
+	 *
+	 * Only available for recording containers and indexed recorded directories, whose frames carry recorded timestamps.
+	 *
+	 * @param timestamp Epoch time in microseconds to seek to
+	 */
+	void seek(const std::chrono::microseconds& timestamp);
+
+	/*!
+	 * @brief Pauses playback and publishes the frame a given number of frames from the last published one.
+	 *
+	 * @param offset Number of frames to move, negative to step back, clamped to the playback range
+	 */
+	void step(long offset = 1);
+
+	/*!
+	 * @brief Limits playback to a range of frames, moving the cursor to its start if it lies outside.
+	 *
+	 * @param begin Index of the first frame to play
+	 * @param end One past the index of the last frame to play, clamped to the number of saved frames
+	 */
+	void setRange(size_t begin, size_t end);
+
+	/*!
+	 * @brief Pauses or resumes playback. While paused, frames are only published by SavedListener::seek and SavedListener::step.
+	 *
+	 * @param paused Whether playback should be paused
+	 */
+	void setPaused(bool paused);
+
+	/*!
+	 * @brief Getter for whether playback is paused.
+	 *
+	 * @return true if playback is paused
+	 */
+	bool isPaused() const;
 };
 
 #endif // SAVEDLISTENER_H
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "listener_frames/GridFrame.h"
 #include "listener_frames/MaskFrame.h"
 #include "listener_frames/TempFrame.h"
+#include "listener_frames/NormalFrame.h"
 #include "listener_frames/CompositeFrame.h"
 
 #endif //LISTENER_FRAMES_H
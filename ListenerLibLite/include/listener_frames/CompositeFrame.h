@@ -3,14 +3,22 @@
 
 struct CamParameters;
 class GenericDataFrame;
+class GridFrame;
+class MaskFrame;
+class NormalEstimator;
+class NormalFrame;
+class PointCloudBuffer;
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
+#include <utility>
 #include <chrono>
 
 #include <open3d/Open3D.h>
 
 #include "listener_utils/general_utils.hpp"
+#include "listener_utils/EncodingParameters.hpp"
 
 /*!
  * @brief Class that contains and provides processing methods for all data frames acquired at a given time by a sensor.
@@ -25,12 +33,19 @@ class GenericDataFrame;
  * GRAYSCALE_IMAGE: numpy.ndarray[uint8](M, N) - Normalized grayscale image  
  * RGB_IMAGE: numpy.ndarray[uint8](M, N, 3) - Integer RGB color frame  
  * TEMPERATURE_GRID: numpy.ndarray[float32](M, N) - Frame of float temperature values  
- * POINTCLOUD_MASK: numpy.ndarray[bool](M, N) - Boolean mask for organized point cloud
+ * POINTCLOUD_MASK: numpy.ndarray[bool](M, N) - Boolean mask for organized point cloud  
+ * NORMAL_GRID: numpy.ndarray[float32](M, N, 3) - Organized unit surface normals, added by a NormalEstimator stage or
+ * CompositeFrame::getOrEstimateNormals
+ *
+ * Coarser versions of the organized point cloud, such as those built by GridPyramid, can be stored alongside it as
+ * additional pyramid levels, each with its own point cloud mask.
  */
 class CompositeFrame
 {
 	std::unordered_map<FrameID, std::shared_ptr<GenericDataFrame>> m_dataMap;
+	std::vector<std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>>> m_pyramidLevels;
 	std::chrono::microseconds m_timestamp;
+	size_t m_sequenceNumber = 0;
 
 protected:
 
@@ -53,6 +68,20 @@ public:
 	 */
 	const std::chrono::microseconds& getTimestamp() const;
 
+	/*!
+	 * @brief Getter for the position of this instance in the stream of frames queued by its listener.
+	 *
+	 * @return Sequence number, increasing by one for every frame queued by the listener
+	 */
+	size_t getSequenceNumber() const;
+
+	/*!
+	 * @brief Setter for the sequence number, assigned by GenericListener when the instance is queued.
+	 *
+	 * @param sequence_number Position of this instance in the stream of frames queued by its listener
+	 */
+	void setSequenceNumber(size_t sequence_number);
+
 	/*!
 	 * @brief Adds a GenericDataFrame object to this instance's internal frame dictionary. If the frame is a 'POINTCLOUD_GRID',
 	 * a 'POINTCLOUD_MASK' that masks out all (0, 0, 0) points is automatically created and added as well.
@@ -86,6 +115,54 @@ public:
 	 */
 	bool has(FrameID frame_id) const;
 
+	/*!
+	 * @brief Getter for the identifiers of all GenericDataFrame objects in the internal data map.
+	 *
+	 * @return Vector of the FrameID keys contained in the internal data map, in no particular order
+	 */
+	std::vector<FrameID> getFrameIDs() const;
+
+	/*!
+	 * @brief Getter for the instance's 'NORMAL_GRID' frame that estimates it on first access.
+	 *
+	 * If the instance has no 'NORMAL_GRID', one is estimated from its 'POINTCLOUD_GRID' and 'POINTCLOUD_MASK' frames
+	 * with the given NormalEstimator and stored, so later calls return the same frame without estimating again.
+	 *
+	 * @param estimator NormalEstimator whose settings are used if normals have not been estimated yet
+	 * @return Pointer to the instance's NormalFrame
+	 */
+	std::shared_ptr<NormalFrame> getOrEstimateNormals(const NormalEstimator& estimator);
+
+	/*!
+	 * @brief Appends a coarser organized point cloud and its mask as the next level of the instance's grid pyramid.
+	 *
+	 * @param p_grid_frame Pointer to the organized point cloud of the level
+	 * @param p_mask_frame Pointer to the boolean mask of the level's organized point cloud
+	 */
+	void addPyramidLevel(std::shared_ptr<GridFrame> p_grid_frame, std::shared_ptr<MaskFrame> p_mask_frame);
+
+	/*!
+	 * @brief Getter for the number of levels in the instance's grid pyramid.
+	 *
+	 * Level 0 is the 'POINTCLOUD_GRID' itself, so the count is 0 without a point cloud and 1 without coarser levels.
+	 *
+	 * @return Number of pyramid levels, including the full resolution point cloud
+	 */
+	size_t getPyramidSize() const;
+
+	/*!
+	 * @brief Getter for one level of the instance's grid pyramid, from finest to coarsest.
+	 *
+	 * @param level Pyramid level, 0 being the 'POINTCLOUD_GRID' and 'POINTCLOUD_MASK' frames
+	 * @return Pair of pointers to the level's GridFrame and MaskFrame
+	 */
+	std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> getPyramidLevel(size_t level) const;
+
+	/*!
+	 * @brief Removes all coarser levels of the instance's grid pyramid.
+	 */
+	void clearPyramid();
+
 	/*!
 	 * @brief Method to resize resolution in place for all GenericDataFrame objects in the instance.
 	 *
@@ -98,17 +175,30 @@ public:
 	/*!
 	 * @brief Writes all raw data in instance to file with format based on FrameID.
 	 *
-	 * File name includes the identifier string representation and the current frame number.
+	 * File name includes the identifier string representation and the current frame number. Writes synchronously on
+	 * the calling thread; AsyncFrameWriter writes the same layout in the background.
 	 * 
 	 * @param save_dir Path to directory where all data will be saved in individual data type directories
 	 * @param frame_number Identifies instance number based on total number of instances created by a given sensor
+	 * @param encoding_params File formats and encoder settings passed to each data frame
+	 */
+	void saveAll(const std::string& save_dir, unsigned int frame_number, const EncodingParameters& encoding_params = EncodingParameters()) const;
+
+	/*!
+	 * @brief Converts the instance's masked organized point cloud into an unorganized float32 PointCloudBuffer.
+	 *
+	 * The buffer's color channel is filled from the instance's RGB image if it is mappable, and its intensity channel
+	 * from the instance's grayscale image, if the buffer has those channels.
+	 *
+	 * @param buffer Handle to PointCloudBuffer object to be populated with instance's organized point cloud
 	 */
-	void saveAll(const std::string& save_dir, unsigned int frame_number) const;
+	void toPointCloudBuffer(PointCloudBuffer& buffer) const;
 
 	/*!
 	 * @brief Converts the instance's organized point cloud into an unorganized one and populates an Open3D PointCloud.
      * 
-	 * Also gives the PointCloud colors corresponding to the instance's RGB image.
+	 * Also gives the PointCloud colors corresponding to the instance's RGB image. Implemented as an opt-in adapter
+	 * over CompositeFrame::toPointCloudBuffer.
 	 * 
 	 * @param pcd Handle to Open3D PointCloud object to be populated with instance's organized point cloud
 	 */
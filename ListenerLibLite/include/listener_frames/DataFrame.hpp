@@ -9,12 +9,14 @@ struct CamParameters;
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/tensor_utils.hpp"
 #include "listener_frames/GenericDataFrame.h"
 
 /*!
  * @brief Templated container class for a specific data frame type acquired by a sensor.
  * 
- * Adds internal data tensor to GenericDataFrame specialized for raw data type.
+ * Adds internal data tensor to GenericDataFrame specialized for raw data type. The tensor is column-major, with the
+ * layout described by listener_utils::planeIndex.
  * 
  * @tparam T Primitive data type of internal data tensor
  */
@@ -41,6 +43,32 @@ protected:
         m_dataTensorPtr->setZero();
     }
 
+    /*!
+     * @brief Method to adopt an already populated tensor as the internal data tensor, taking its dimensions.
+     *
+     * @param p_tensor 3-dimensional Eigen::Tensor containing the pixel data in the frame
+     */
+    void setTensor(const std::shared_ptr<Eigen::Tensor<T, 3>> p_tensor)
+    {
+        m_rows = static_cast<int>(p_tensor->dimension(0));
+        m_cols = static_cast<int>(p_tensor->dimension(1));
+        m_channels = static_cast<int>(p_tensor->dimension(2));
+        m_dataTensorPtr = p_tensor;
+    }
+
+    /*!
+     * @brief Method for subclasses implementing GenericDataFrame::clone to copy the internal data tensor into a new instance.
+     *
+     * @return Pointer to a new instance of the given subclass holding a copy of the internal data tensor
+     */
+    template <typename Frame>
+    std::shared_ptr<GenericDataFrame> cloneAs() const
+    {
+        const auto p_copy = std::make_shared<Frame>(std::make_shared<Eigen::Tensor<T, 3>>(*m_dataTensorPtr), m_camParamsPtr, m_extrinsicPtr);
+        p_copy->setLoadedTimestamp(m_loadedTimestamp);
+        return p_copy;
+    }
+
 public:
 
     /*!
@@ -86,6 +114,16 @@ public:
         return *m_dataTensorPtr;
     }
 
+    /*!
+     * @brief Implements GenericDataFrame::getNumBytes.
+     *
+     * @return Size of the internal data tensor in bytes, 0 if none was created
+     */
+    size_t getNumBytes() const override
+    {
+        return m_dataTensorPtr ? static_cast<size_t>(m_dataTensorPtr->size()) * sizeof(T) : 0;
+    }
+
     /*!
      * @brief Getter for the data value in the internal Eigen::Tensor at the specified indices.
      *
@@ -127,6 +165,26 @@ public:
         fromCvMat(*p_mat);
     }
 
+    /*!
+     * @brief Method to resize resolution in place for all raw data in the instance to an exact size.
+     *
+     * Image resampling performed using nearest-neighbor interpolation to preserve sharp edges.
+     *
+     * @param rows New number of rows in data tensor
+     * @param cols New number of columns in data tensor
+     */
+    void resize(const int rows, const int cols) override
+    {
+        if (rows == m_rows && cols == m_cols)
+        {
+            return;
+        }
+        const std::shared_ptr<cv::Mat> p_mat = asCvMat();
+        cv::resize(*p_mat, *p_mat, cv::Size(cols, rows), 0, 0, cv::INTER_NEAREST);
+        initializeTensor(p_mat->rows, p_mat->cols, p_mat->channels());
+        fromCvMat(*p_mat);
+    }
+
     /*!
      * @brief Method to get a boolean mask of this instance to mask out zero points.
      * 
@@ -11,6 +11,8 @@ class SensorInterface;
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/EncodingParameters.hpp"
+
 /*!
  * @brief Abstract container class for a generic data frame type acquired by a sensor.
  *
@@ -91,6 +93,20 @@ public:
      */
     const std::chrono::microseconds& getLoadedTimestamp() const;
 
+    /*!
+     * @brief Setter for the timestamp of data loaded from a recording, adopted by a CompositeFrame the frame is added to.
+     *
+     * @param timestamp Epoch time in microseconds at which the data was created
+     */
+    void setLoadedTimestamp(const std::chrono::microseconds& timestamp);
+
+    /*!
+     * @brief Setter for the camera parameters, for processing that changes the frame's resolution or projection.
+     *
+     * @param p_cam_params Pointer to container for intrinsic matrix and distortion coefficients matching the frame's data
+     */
+    void setCamParams(std::shared_ptr<CamParameters> p_cam_params);
+
     /*!
      * @brief Abstract method to resize resolution in place for all raw data in the instance.
      * 
@@ -100,6 +116,16 @@ public:
      */
     virtual void resize(const float factor) = 0;
 
+    /*!
+     * @brief Abstract method to resize resolution in place for all raw data in the instance to an exact size.
+     *
+     * Image resampling should be performed using nearest-neighbor interpolation to preserve sharp edges.
+     *
+     * @param rows New number of rows in data tensor
+     * @param cols New number of columns in data tensor
+     */
+    virtual void resize(const int rows, const int cols) = 0;
+
     /*!
      * @brief Abstract method to convert the internal data tensor to an OpenCV matrix.
      * 
@@ -125,8 +151,9 @@ public:
      * @brief Abstract method that subclasses must implement to save internal raw data in an appropriate format.
      * 
      * @param file_path File path minus extension to which data will be saved
+     * @param encoding_params File formats and encoder settings, of which subclasses use those relevant to their data
      */
-    virtual void save(const std::string& file_path) = 0;
+    virtual void save(const std::string& file_path, const EncodingParameters& encoding_params = EncodingParameters()) = 0;
 
     /*!
      * @brief Abstract method that subclasses must implement to load internal raw data in an appropriate format.
@@ -135,6 +162,23 @@ public:
      * @param sensor_interface Object describing properties of the sensor whose data will be loaded
      */
     virtual void load(const std::string& file_path, const SensorInterface& sensor_interface) = 0;
+
+    /*!
+     * @brief Abstract method that subclasses must implement to create an independent copy of the instance.
+     *
+     * The copy shares camera parameters and extrinsic matrix but owns a separate copy of the data tensor, so either can
+     * be modified without affecting the other.
+     *
+     * @return Pointer to a new data frame of the same type
+     */
+    virtual std::shared_ptr<GenericDataFrame> clone() const = 0;
+
+    /*!
+     * @brief Abstract method that subclasses must implement to report the memory held by the data tensor.
+     *
+     * @return Size of the internal data tensor in bytes
+     */
+    virtual size_t getNumBytes() const = 0;
 };
 
 #endif // GENERICDATAFRAME_H
\ No newline at end of file
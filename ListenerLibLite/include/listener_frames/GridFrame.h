@@ -2,8 +2,11 @@
 #define GRIDFRAME_H
 
 class SensorInterface;
+class ScanningLidarInterface;
 
+#include <vector>
 #include <memory>
+#include <cstdint>
 
 #include <Eigen/Dense>
 #include <opencv2/core.hpp>
@@ -18,11 +21,7 @@ class SensorInterface;
  */
 class GridFrame final : public DataFrame<float>
 {
-	static float floorMedianFilter(std::vector<float>& window);
-
-	std::shared_ptr<cv::Mat> applyCustomFilter(cv::Mat& image, int kernel_size = 3) const;
-
-	void organizePcd(std::vector<Eigen::Vector3d>& point_array, int filter_size);
+	void organizePcd(std::vector<float>& points, const std::vector<uint32_t>& beam_ids, const ScanningLidarInterface& scan_lidar_interface);
 
 public:
 
@@ -56,8 +55,9 @@ public:
 	 * @brief Overrides GenericDataFrame::save for this specific frame type.
 	 * 
 	 * @param file_path File path minus extension to which data will be saved
+	 * @param encoding_params File formats and encoder settings
 	 */
-	void save(const std::string& file_path) override;
+	void save(const std::string& file_path, const EncodingParameters& encoding_params = EncodingParameters()) override;
 
 	/*!
 	 * @brief Overrides GenericDataFrame::save for this specific frame type.
@@ -66,6 +66,13 @@ public:
 	 * @param sensor_interface Object describing properties of the sensor whose data will be loaded
 	 */
 	void load(const std::string& file_path, const SensorInterface& sensor_interface) override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::clone for this specific frame type.
+	 *
+	 * @return Pointer to a new GridFrame holding a copy of the data tensor
+	 */
+	std::shared_ptr<GenericDataFrame> clone() const override;
 };
 
 #endif // GRIDFRAME_H
\ No newline at end of file
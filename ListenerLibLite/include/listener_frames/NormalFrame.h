@@ -0,0 +1,73 @@
+#ifndef NORMALFRAME_H
+#define NORMALFRAME_H
+
+class SensorInterface;
+
+#include <memory>
+
+#include <Eigen/Dense>
+#include <opencv2/core.hpp>
+
+#include "listener_frames/DataFrame.hpp"
+
+/*!
+ * @brief Container class for surface normals estimated from an organized point cloud acquired by a sensor.
+ * 
+ * Data stored in instance of this class is of the FrameID:  
+ * NORMAL_GRID: numpy.ndarray[float32](M, N, 3) - Organized unit surface normals
+ */
+class NormalFrame final : public DataFrame<float>
+{
+public:
+
+	using DataFrame::DataFrame;
+
+	/*!
+	 * @brief Constructor to create an instance of this class by loading from a file.
+	 *
+	 * @param file_path String path to file from which data is loaded.
+	 * @param p_cam_params Pointer to container for intrinsic matrix and distortion coefficients of the frame's creator sensor
+	 * @param p_extrinsic Pointer to the 4x4 extrinsic matrix of the sensor that acquired the frame relative to its identity sensor
+	 * @param sensor_interface Object describing properties of the sensor whose data will be loaded
+	 */
+	NormalFrame(const std::string& file_path, std::shared_ptr<CamParameters> p_cam_params, std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface);
+
+	/*!
+	 * @brief Overrides GenericDataFrame::asCvMat for this specific frame type.
+	 * 
+	 * @return Pointer to cv::Mat object created from data tensor
+	 */
+	std::shared_ptr<cv::Mat> asCvMat() const override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::fromCvMat for this specific frame type.
+	 * 
+	 * @param mat Reference to existing cv::Mat object
+	 */
+	void fromCvMat(const cv::Mat& mat) override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::save for this specific frame type.
+	 * 
+	 * @param file_path File path minus extension to which data will be saved
+	 * @param encoding_params File formats and encoder settings
+	 */
+	void save(const std::string& file_path, const EncodingParameters& encoding_params = EncodingParameters()) override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::save for this specific frame type.
+	 *
+	 * @param file_path File path from which data will be loaded
+	 * @param sensor_interface Object describing properties of the sensor whose data will be loaded
+	 */
+	void load(const std::string& file_path, const SensorInterface& sensor_interface) override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::clone for this specific frame type.
+	 *
+	 * @return Pointer to a new NormalFrame holding a copy of the data tensor
+	 */
+	std::shared_ptr<GenericDataFrame> clone() const override;
+};
+
+#endif // NORMALFRAME_H
\ No newline at end of file
@@ -50,8 +50,9 @@ public:
 	 * @brief Overrides GenericDataFrame::save for this specific frame type.
 	 * 
 	 * @param file_path File path minus extension to which data will be saved
+	 * @param encoding_params File formats and encoder settings
 	 */
-	void save(const std::string& file_path) override;
+	void save(const std::string& file_path, const EncodingParameters& encoding_params = EncodingParameters()) override;
 
 	/*!
 	 * @brief Overrides GenericDataFrame::save for this specific frame type.
@@ -60,6 +61,13 @@ public:
 	 * @param sensor_interface Object describing properties of the sensor whose data will be loaded
 	 */
 	void load(const std::string& file_path, const SensorInterface& sensor_interface) override;
+
+	/*!
+	 * @brief Overrides GenericDataFrame::clone for this specific frame type.
+	 *
+	 * @return Pointer to a new TempFrame holding a copy of the data tensor
+	 */
+	std::shared_ptr<GenericDataFrame> clone() const override;
 };
 
 #endif // TEMPFRAME_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+#ifndef LISTENER_PROCESSING_H
+#define LISTENER_PROCESSING_H
+
+#include "listener_processing/ProcessingStage.h"
+#include "listener_processing/GridDownsampler.h"
+#include "listener_processing/GridPyramid.h"
+#include "listener_processing/NormalEstimator.h"
+#include "listener_processing/PointCloudFuser.h"
+#include "listener_processing/TemporalFilter.h"
+#include "listener_processing/DepthHoleFiller.h"
+#include "listener_processing/DepthMedianFilter.h"
+#include "listener_processing/GridProjector.h"
+#include "listener_processing/ProjectionLut.h"
+#include "listener_processing/ScanAccumulator.h"
+
+#endif //LISTENER_PROCESSING_H
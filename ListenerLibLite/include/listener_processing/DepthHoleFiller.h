@@ -0,0 +1,102 @@
+#ifndef DEPTHHOLEFILLER_H
+#define DEPTHHOLEFILLER_H
+
+class CompositeFrame;
+
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "listener_processing/ProcessingStage.h"
+
+/*!
+ * @brief Enum class identifying the interpolation strategy used by a DepthHoleFiller.
+ *
+ * JOINT_BILATERAL: Weighted mean of the valid neighbours in a window, weighted by pixel distance and, if a guide image is
+ *                  given, by guide intensity similarity
+ * NEAREST_VALID: Mean of the valid neighbours at the smallest pixel distance found in a window
+ * PUSH_PULL: Multi-scale fill, averaging valid pixels down an image pyramid and pulling coarse values back into holes
+ */
+enum class HoleFillMode
+{
+	JOINT_BILATERAL,
+	NEAREST_VALID,
+	PUSH_PULL
+};
+
+/*!
+ * @brief Container for the settings of a DepthHoleFiller.
+ */
+struct HoleFillParameters
+{
+	HoleFillMode m_mode = HoleFillMode::JOINT_BILATERAL;
+
+	int m_radius = 2;
+	float m_maxDepthJumpFactor = 0.1f;
+	float m_spatialSigma = 1.0f;
+	float m_guideSigma = 20.0f;
+	int m_minValidNeighbours = 1;
+
+	unsigned int m_numThreads = 0;
+};
+
+/*!
+ * @brief Processing stage that fills holes in sparse depth images, such as projected scanning LiDAR depth.
+ *
+ * Inherits ProcessingStage. Only pixels with zero depth are written; valid depths are never changed. Holes are filled from
+ * valid pixels at most m_radius pixels away, or from pyramid cells of at most twice that size in PUSH_PULL mode. To avoid
+ * smearing depth across object boundaries, each hole only uses neighbours within m_maxDepthJumpFactor times the depth of
+ * its nearest foreground neighbour, with 0 disabling the guard, so that holes at a discontinuity take the foreground depth.
+ * Rows are processed in parallel, and window sums use precomputed weight tables in branchless loops that vectorize.
+ */
+class DepthHoleFiller final : public ProcessingStage
+{
+	const HoleFillParameters m_params;
+
+	std::vector<float> m_spatialWeights;
+	std::vector<int> m_ringDistances;
+	std::vector<float> m_guideWeights;
+
+	void fillJointBilateral(const float* p_src, float* p_dst, const unsigned char* p_guide, int rows, int cols) const;
+
+	void fillNearestValid(const float* p_src, float* p_dst, int rows, int cols) const;
+
+	void fillPushPull(float* p_depth, int rows, int cols) const;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the hole filling settings and precompute window weights.
+	 *
+	 * @param params Fill mode, window radius, discontinuity guard, weight sigmas, minimum neighbours, and thread count
+	 */
+	explicit DepthHoleFiller(const HoleFillParameters& params = HoleFillParameters());
+
+	/*!
+	 * @brief Getter for the hole filling settings.
+	 *
+	 * @return Reference to the hole filling settings
+	 */
+	const HoleFillParameters& getParams() const;
+
+	/*!
+	 * @brief Fills the holes of a depth image in place.
+	 *
+	 * @param depth_image Single channel float depth image where zero marks a missing depth
+	 * @param guide_image Optional single channel 8-bit image with the same resolution guiding JOINT_BILATERAL weights
+	 */
+	void fill(cv::Mat& depth_image, const cv::Mat& guide_image = cv::Mat()) const;
+
+	/*!
+	 * @brief Implements ProcessingStage::process.
+	 *
+	 * Fills holes in the depth of the CompositeFrame's 'POINTCLOUD_GRID' in place, deprojecting each filled pixel with the
+	 * grid's pinhole intrinsics and adding it to 'POINTCLOUD_MASK'. A 'GRAYSCALE_IMAGE' with the same resolution is used as the
+	 * guide image if present.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame to fill
+	 */
+	void process(CompositeFrame& composite_frame) override;
+};
+
+#endif // DEPTHHOLEFILLER_H
@@ -0,0 +1,55 @@
+#ifndef DEPTHMEDIANFILTER_H
+#define DEPTHMEDIANFILTER_H
+
+#include <vector>
+#include <utility>
+
+#include <opencv2/core.hpp>
+
+/*!
+ * @brief Engine that applies a floor median filter to a depth image, ignoring missing depths.
+ *
+ * Each output pixel is the lower median of the nonzero depths in its window, or zero if the window has none. For a kernel
+ * size k, the window spans 2 * floor((k + 1) / 2) pixels per side starting that many pixels above and left of its centre
+ * pixel, clamped to the image bounds, which matches the filter previously applied when organizing point clouds.
+ *
+ * No memory is allocated per pixel. Rows are processed in parallel, and each thread filters batches of neighbouring pixels
+ * at once: the nonzero depths of each pixel's window are gathered into one lane of a small scratch array, padded to a power
+ * of two, and sorted with a Batcher odd-even merge network of vectorized Eigen array min/max operations. Sparse windows
+ * therefore only pay for a network sized to the fullest window in the batch.
+ */
+class DepthMedianFilter
+{
+	const int m_kernelSize;
+	const int m_halfWindow;
+	const unsigned int m_numThreads;
+
+	std::vector<std::vector<std::pair<int, int>>> m_networks;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the kernel size and precompute sorting networks.
+	 *
+	 * @param kernel_size Kernel size k of the floor median filter, typically between 3 and 7
+	 * @param num_threads Maximum number of threads to split rows across, 0 means use all hardware threads
+	 */
+	explicit DepthMedianFilter(int kernel_size = 3, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Getter for the kernel size.
+	 *
+	 * @return Kernel size k of the floor median filter
+	 */
+	int getKernelSize() const;
+
+	/*!
+	 * @brief Applies the floor median filter to a depth image.
+	 *
+	 * @param depth_image Single channel float depth image where zero marks a missing depth
+	 * @param filtered_image Handle to cv::Mat object to be populated with the filtered depth image, may alias depth_image
+	 */
+	void filter(const cv::Mat& depth_image, cv::Mat& filtered_image) const;
+};
+
+#endif // DEPTHMEDIANFILTER_H
@@ -0,0 +1,114 @@
+#ifndef GRIDDOWNSAMPLER_H
+#define GRIDDOWNSAMPLER_H
+
+class CompositeFrame;
+class GridFrame;
+class MaskFrame;
+class PointCloudBuffer;
+
+#include <memory>
+#include <utility>
+
+#include "listener_processing/ProcessingStage.h"
+
+/*!
+ * @brief Enum class identifying the averaging strategy used by a GridDownsampler.
+ *
+ * BLOCK: Averages the valid points of each square pixel neighbourhood into one pixel of a smaller organized grid
+ * VOXEL: Averages the valid points falling into each cubic voxel into one point
+ */
+enum class DownsampleMode
+{
+	BLOCK,
+	VOXEL
+};
+
+/*!
+ * @brief Container for the settings of a GridDownsampler.
+ *
+ * m_pointBudget only applies to BLOCK mode, where zero means no budget.
+ */
+struct DownsampleParameters
+{
+	DownsampleMode m_mode = DownsampleMode::BLOCK;
+
+	int m_blockSize = 2;
+	float m_voxelSize = 0.05f;
+
+	size_t m_pointBudget = 0;
+	unsigned int m_numThreads = 0;
+};
+
+/*!
+ * @brief Processing stage that downsamples an organized point cloud in float32 without converting it to Open3D.
+ *
+ * Inherits ProcessingStage. In BLOCK mode, each block of m_blockSize x m_blockSize pixels is reduced to the mean of its
+ * masked points, producing a smaller organized grid. If m_pointBudget is nonzero, the block size is increased as needed so
+ * that the output grid never has more pixels than the budget, regardless of sensor resolution. In VOXEL mode, masked points
+ * are hashed into cubic voxels of side m_voxelSize and each voxel is reduced to the mean of its points. VOXEL mode has no
+ * point budget, since its number of points depends on the scene rather than the sensor resolution, and m_pointBudget is
+ * ignored. Both modes are multithreaded, over output rows and over hash partitions that each own their bucket of points.
+ */
+class GridDownsampler final : public ProcessingStage
+{
+	const DownsampleParameters m_params;
+
+	int getEffectiveBlockSize(int rows, int cols) const;
+
+	std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> downsampleBlock(const GridFrame& grid_frame, const MaskFrame& mask_frame) const;
+
+	std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> downsampleVoxel(const GridFrame& grid_frame, const MaskFrame& mask_frame) const;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the downsampling settings.
+	 *
+	 * @param params Downsampling mode, block or voxel size, point budget, and thread count
+	 */
+	explicit GridDownsampler(const DownsampleParameters& params = DownsampleParameters());
+
+	/*!
+	 * @brief Getter for the downsampling settings.
+	 *
+	 * @return Reference to the downsampling settings
+	 */
+	const DownsampleParameters& getParams() const;
+
+	/*!
+	 * @brief Downsamples an organized point cloud into a new organized point cloud and mask.
+	 *
+	 * In BLOCK mode the result has the reduced block resolution and intrinsics scaled to match. In VOXEL mode the result
+	 * keeps the input resolution, with each voxel's mean written to the first pixel of the voxel in row-major order and
+	 * all of the voxel's other pixels masked out.
+	 *
+	 * @param grid_frame Organized point cloud frame
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are used
+	 * @return Pair of pointers to the downsampled GridFrame and its MaskFrame
+	 */
+	std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> downsample(const GridFrame& grid_frame, const MaskFrame& mask_frame) const;
+
+	/*!
+	 * @brief Downsamples an organized point cloud directly into an unorganized point buffer.
+	 *
+	 * If the buffer stores pixel indices, they refer to the downsampled organized grid.
+	 *
+	 * @param grid_frame Organized point cloud frame
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are used
+	 * @param buffer Handle to PointCloudBuffer object to be populated with the downsampled points
+	 */
+	void downsample(const GridFrame& grid_frame, const MaskFrame& mask_frame, PointCloudBuffer& buffer) const;
+
+	/*!
+	 * @brief Implements ProcessingStage::process.
+	 *
+	 * Replaces the CompositeFrame's 'POINTCLOUD_GRID' and 'POINTCLOUD_MASK' frames with their downsampled versions. In
+	 * BLOCK mode, all other frames with the input grid's resolution are resized to the output resolution with
+	 * nearest-neighbour sampling so they stay aligned with the grid, and their intrinsics are scaled like the grid's.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame to downsample
+	 */
+	void process(CompositeFrame& composite_frame) override;
+};
+
+#endif // GRIDDOWNSAMPLER_H
@@ -0,0 +1,107 @@
+#ifndef GRIDPROJECTOR_H
+#define GRIDPROJECTOR_H
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <opencv2/core.hpp>
+
+class ProjectionLut;
+
+/*!
+ * @brief Engine that organizes an unorganized scanning LiDAR point cloud into an organized grid with a pinhole model.
+ *
+ * Pinhole projection, bounds checking, and nearest point selection are done in a single parallel pass over the raw
+ * coordinates, with each pixel keeping the point of smallest positive depth through an atomic minimum on a packed
+ * (depth, index) key. The selected points are then either written to the grid as they are, or turned into a depth image
+ * that is filtered and deprojected directly through the pinhole model, without any intermediate point containers.
+ */
+class GridProjector
+{
+	const Eigen::Matrix3f m_intrinsic;
+	const int m_rows;
+	const int m_cols;
+	const unsigned int m_numThreads;
+
+	std::unique_ptr<std::atomic<uint64_t>[]> m_nearestKeys;
+
+	template <typename T>
+	void selectNearest(const T* p_points, size_t num_points, const std::function<void(int, int, int32_t*)>& pixel_lookup);
+
+	template <typename T>
+	void writeNearest(const T* p_points, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter);
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the projection model and grid resolution.
+	 *
+	 * @param intrinsic 3x3 pinhole intrinsic matrix of the organized grid
+	 * @param rows Number of rows in the organized grid
+	 * @param cols Number of columns in the organized grid
+	 * @param num_threads Maximum number of threads to use, 0 means use all hardware threads
+	 */
+	GridProjector(const Eigen::Matrix3f& intrinsic, int rows, int cols, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Projects points into an organized grid, keeping the nearest point per pixel.
+	 *
+	 * Points with non-positive depth or projecting outside the grid are dropped. If a depth filter is given, the nearest
+	 * depths are written to a depth image that the filter modifies in place, and every pixel with positive filtered depth
+	 * is deprojected along its pinhole ray. Otherwise the nearest points are copied to the grid unchanged.
+	 *
+	 * @tparam T Floating point type of the input coordinates
+	 * @param p_points Pointer to the first of num_points contiguous (x, y, z) coordinate triplets
+	 * @param num_points Number of points to project
+	 * @param grid Organized point cloud tensor with the engine's resolution and 3 channels, zeroed by the caller
+	 * @param depth_filter Optional function filtering the single channel float depth image in place
+	 */
+	template <typename T>
+	void project(const T* p_points, size_t num_points, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter = nullptr);
+
+	/*!
+	 * @brief Projects points measured by the beams of a fixed-pattern scanning LiDAR into an organized grid, keeping the nearest point per pixel.
+	 *
+	 * Behaves like GridProjector::project, but verifies the frame against a ProjectionLut and then takes each point's
+	 * pixel from the table inside the parallel pass that selects the nearest points, instead of projecting it.
+	 *
+	 * @param p_points Pointer to the first of num_points contiguous conditioned (x, y, z) coordinate triplets
+	 * @param p_beam_ids Pointer to the driver beam ID of each conditioned point
+	 * @param num_points Number of points to project
+	 * @param lut Projection lookup table built for the engine's projection model and grid resolution
+	 * @param grid Organized point cloud tensor with the engine's resolution and 3 channels, zeroed by the caller
+	 * @param depth_filter Optional function filtering the single channel float depth image in place
+	 */
+	void project(const float* p_points, const uint32_t* p_beam_ids, size_t num_points, ProjectionLut& lut, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter = nullptr);
+
+	/*!
+	 * @brief Adds points to an organized grid that already holds points, keeping the nearest point per pixel across both.
+	 *
+	 * Uses the same pinhole model, bounds check, and nearest point rule as GridProjector::project, but takes the grid's
+	 * depth channel as the depth buffer and visits only the given points on the calling thread, so that small batches can
+	 * be added to a grid as they arrive without a pass over every pixel.
+	 *
+	 * @tparam T Floating point type of the input coordinates
+	 * @param p_points Pointer to the first of num_points contiguous (x, y, z) coordinate triplets
+	 * @param num_points Number of points to add
+	 * @param grid Organized point cloud tensor with the engine's resolution and 3 channels, holding (0, 0, 0) at empty pixels
+	 */
+	template <typename T>
+	void accumulate(const T* p_points, size_t num_points, Eigen::Tensor<float, 3>& grid) const;
+
+	/*!
+	 * @brief Writes the point along each pixel's pinhole ray at the pixel's depth into an organized grid.
+	 *
+	 * Pixels with non-positive depth are written as (0, 0, 0).
+	 *
+	 * @param depth_image Single channel float depth image with the engine's resolution
+	 * @param grid Organized point cloud tensor with the engine's resolution and 3 channels
+	 */
+	void deproject(const cv::Mat& depth_image, Eigen::Tensor<float, 3>& grid) const;
+};
+
+#endif // GRIDPROJECTOR_H
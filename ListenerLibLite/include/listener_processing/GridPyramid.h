@@ -0,0 +1,91 @@
+#ifndef GRIDPYRAMID_H
+#define GRIDPYRAMID_H
+
+class CompositeFrame;
+class GridFrame;
+class MaskFrame;
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "listener_processing/ProcessingStage.h"
+
+/*!
+ * @brief Enum class identifying how a GridPyramid reduces the points falling into each coarse pixel.
+ *
+ * MIN_DEPTH: Keeps the nearest point, as if the point cloud had been projected at the coarse resolution
+ * MEDIAN: Keeps the point of lower median depth, rejecting isolated foreground and background outliers
+ */
+enum class PyramidReduction
+{
+	MIN_DEPTH,
+	MEDIAN
+};
+
+/*!
+ * @brief Container for the settings of a GridPyramid.
+ *
+ * m_scales: Resolution of each coarser level relative to the input grid, in decreasing order. For Cepton and Movia
+ *           interfaces in mode 4, scales of 0.75, 0.5, 0.25, and 0.1 give the focal lengths of modes 3 to 0
+ */
+struct PyramidParameters
+{
+	PyramidReduction m_reduction = PyramidReduction::MIN_DEPTH;
+
+	std::vector<float> m_scales = {0.5f, 0.25f};
+
+	unsigned int m_numThreads = 0;
+};
+
+/*!
+ * @brief Processing stage that derives coarser organized point clouds from a single fine scanning LiDAR projection.
+ *
+ * Inherits ProcessingStage. Each coarse level has its focal lengths scaled by the level's scale and its principal point at
+ * the centre of its scaled resolution, matching how scanning LiDAR modes differ only in scale. Every valid point of the
+ * fine grid is reprojected into each level, which is exact for any scale, and points are bucketed by coarse pixel with a
+ * counting sort before each bucket is reduced in parallel. The levels keep actual measured points rather than averaging
+ * across depth discontinuities, so a MIN_DEPTH level matches projecting the original scan at the level's resolution
+ * wherever the fine grid kept the nearest point.
+ */
+class GridPyramid final : public ProcessingStage
+{
+	const PyramidParameters m_params;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the pyramid settings.
+	 *
+	 * @param params Reduction strategy, level scales, and thread count
+	 */
+	explicit GridPyramid(const PyramidParameters& params = PyramidParameters());
+
+	/*!
+	 * @brief Getter for the pyramid settings.
+	 *
+	 * @return Reference to the pyramid settings
+	 */
+	const PyramidParameters& getParams() const;
+
+	/*!
+	 * @brief Reduces an organized point cloud into every coarser level of the pyramid.
+	 *
+	 * @param grid_frame Organized point cloud frame at the finest resolution
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are used
+	 * @return Vector of pairs of pointers to each level's GridFrame and MaskFrame, from finest to coarsest
+	 */
+	std::vector<std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>>> build(const GridFrame& grid_frame, const MaskFrame& mask_frame) const;
+
+	/*!
+	 * @brief Implements ProcessingStage::process.
+	 *
+	 * Replaces the CompositeFrame's coarser pyramid levels with the levels built from its 'POINTCLOUD_GRID' and
+	 * 'POINTCLOUD_MASK' frames.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame to add pyramid levels to
+	 */
+	void process(CompositeFrame& composite_frame) override;
+};
+
+#endif // GRIDPYRAMID_H
@@ -0,0 +1,92 @@
+#ifndef NORMALESTIMATOR_H
+#define NORMALESTIMATOR_H
+
+class CompositeFrame;
+class GridFrame;
+class MaskFrame;
+class NormalFrame;
+
+#include <memory>
+
+#include "listener_processing/ProcessingStage.h"
+
+/*!
+ * @brief Enum class identifying the neighbourhood used by a NormalEstimator to compute tangent vectors.
+ *
+ * CENTRAL_DIFFERENCE: Differences between the points m_radius pixels away on either side of each pixel
+ * AVERAGE_3D_GRADIENT: Differences between the mean points of the windows on either side of each pixel, via integral images
+ */
+enum class NormalMethod
+{
+	CENTRAL_DIFFERENCE,
+	AVERAGE_3D_GRADIENT
+};
+
+/*!
+ * @brief Container for the settings of a NormalEstimator.
+ *
+ * A neighbour is rejected as lying across a depth discontinuity if its depth differs from the centre pixel's depth by
+ * more than m_maxDepthChangeFactor times the centre depth per pixel of distance.
+ */
+struct NormalEstimationParameters
+{
+	NormalMethod m_method = NormalMethod::AVERAGE_3D_GRADIENT;
+
+	int m_radius = 2;
+	float m_maxDepthChangeFactor = 0.02f;
+
+	unsigned int m_numThreads = 0;
+};
+
+/*!
+ * @brief Processing stage that estimates surface normals of an organized point cloud in O(N) from pixel neighbours.
+ *
+ * Inherits ProcessingStage. Tangent vectors along the grid's columns and rows are computed from masked neighbours that do
+ * not lie across a depth discontinuity, falling back to one-sided differences at edges. Their cross product is normalized
+ * and oriented towards the sensor. Pixels that are masked out or have no valid neighbours in either direction get a zero
+ * normal. Work is split into column tiles processed in parallel, with branch-free inner loops over contiguous rows.
+ */
+class NormalEstimator final : public ProcessingStage
+{
+	const NormalEstimationParameters m_params;
+
+	void estimateCentralDifference(const float* p_grid, const bool* p_mask, float* p_normals, int rows, int cols) const;
+
+	void estimateAverageGradient(const float* p_grid, const bool* p_mask, float* p_normals, int rows, int cols) const;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the normal estimation settings.
+	 *
+	 * @param params Neighbourhood method, radius, depth discontinuity threshold, and thread count
+	 */
+	explicit NormalEstimator(const NormalEstimationParameters& params = NormalEstimationParameters());
+
+	/*!
+	 * @brief Getter for the normal estimation settings.
+	 *
+	 * @return Reference to the normal estimation settings
+	 */
+	const NormalEstimationParameters& getParams() const;
+
+	/*!
+	 * @brief Estimates unit surface normals of an organized point cloud.
+	 *
+	 * @param grid_frame Organized point cloud frame
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are valid
+	 * @return Pointer to NormalFrame with the same resolution, camera parameters, and extrinsic as the point cloud
+	 */
+	std::shared_ptr<NormalFrame> estimate(const GridFrame& grid_frame, const MaskFrame& mask_frame) const;
+
+	/*!
+	 * @brief Implements ProcessingStage::process.
+	 *
+	 * Adds a 'NORMAL_GRID' frame estimated from the CompositeFrame's 'POINTCLOUD_GRID' and 'POINTCLOUD_MASK' frames.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame to add normals to
+	 */
+	void process(CompositeFrame& composite_frame) override;
+};
+
+#endif // NORMALESTIMATOR_H
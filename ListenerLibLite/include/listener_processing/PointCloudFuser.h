@@ -0,0 +1,76 @@
+#ifndef POINTCLOUDFUSER_H
+#define POINTCLOUDFUSER_H
+
+class CompositeFrame;
+class GenericListener;
+
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#include "listener_utils/PointCloudBuffer.h"
+
+/*!
+ * @brief Engine that merges the point clouds of several sensors into one cloud expressed in their shared identity frame.
+ *
+ * Each input CompositeFrame's masked 'POINTCLOUD_GRID' is transformed by the extrinsic matrix its frames carry, which is
+ * relative to the identity sensor of the SingleListener that produced it. All points are written into one internal
+ * PointCloudBuffer that is reused between calls, with each point tagged by the index of its source frame in the input.
+ * Sensors are processed in parallel, and transforms use vectorized Eigen array operations in float32.
+ */
+class PointCloudFuser
+{
+	const unsigned int m_numThreads;
+	const std::chrono::microseconds m_maxTimeSkew;
+
+	PointCloudBuffer m_buffer;
+
+	std::vector<size_t> m_sourceOffsets;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the fused cloud layout and preallocate its storage.
+	 *
+	 * @param layout Memory layout of the fused point coordinates
+	 * @param has_color true if RGB colors of mappable sensors should be fused, false if not
+	 * @param capacity Number of points to preallocate storage for
+	 * @param max_time_skew Largest allowed difference between input frame timestamps, zero disables the check
+	 * @param num_threads Maximum number of threads to use, 0 means use all hardware threads
+	 */
+	explicit PointCloudFuser(PointLayout layout = PointLayout::SOA, bool has_color = false, size_t capacity = 0, const std::chrono::microseconds& max_time_skew = std::chrono::microseconds::zero(), unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Fuses the point clouds of a set of synchronized CompositeFrames into the identity frame.
+	 *
+	 * Frames without a 'POINTCLOUD_GRID' contribute no points but keep their source tag index.
+	 *
+	 * @param composite_frames Pointers to the CompositeFrames to fuse, one per sensor
+	 * @return Reference to the internal buffer holding the fused points with per-point source tags
+	 */
+	const PointCloudBuffer& fuse(const std::vector<std::shared_ptr<CompositeFrame>>& composite_frames);
+
+	/*!
+	 * @brief Gets the latest frame from each listener and fuses their point clouds into the identity frame.
+	 *
+	 * @param listeners Pointers to streaming listeners sharing one identity sensor, in source tag order
+	 * @return Reference to the internal buffer holding the fused points with per-point source tags
+	 */
+	const PointCloudBuffer& fuse(const std::vector<std::shared_ptr<GenericListener>>& listeners);
+
+	/*!
+	 * @brief Getter for the result of the last fusion.
+	 *
+	 * @return Reference to the internal buffer holding the fused points with per-point source tags
+	 */
+	const PointCloudBuffer& getBuffer() const;
+
+	/*!
+	 * @brief Getter for the index of the first point of each source in the fused buffer.
+	 *
+	 * @return Vector with one offset per input frame plus a final entry equal to the number of fused points
+	 */
+	const std::vector<size_t>& getSourceOffsets() const;
+};
+
+#endif // POINTCLOUDFUSER_H
@@ -0,0 +1,32 @@
+#ifndef PROCESSINGSTAGE_H
+#define PROCESSINGSTAGE_H
+
+class CompositeFrame;
+
+/*!
+ * @brief Abstract base class for a processing stage applied to every CompositeFrame a listener produces.
+ *
+ * Stages are registered with GenericListener::addProcessingStage and run in registration order on the producing thread
+ * before each CompositeFrame is added to the listener's queue. A stage instance belongs to a single listener, so
+ * subclasses may keep per-stream state between frames.
+ */
+class ProcessingStage
+{
+public:
+
+	/*!
+	 * @brief Virtual default destructor.
+	 */
+	virtual ~ProcessingStage();
+
+	/*!
+	 * @brief Abstract method that subclasses must implement to process a CompositeFrame in place.
+	 *
+	 * May add, replace, or modify the data frames contained in the CompositeFrame.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame about to be added to the listener's queue
+	 */
+	virtual void process(CompositeFrame& composite_frame) = 0;
+};
+
+#endif // PROCESSINGSTAGE_H
@@ -0,0 +1,119 @@
+#ifndef PROJECTIONLUT_H
+#define PROJECTIONLUT_H
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include <Eigen/Dense>
+
+/*!
+ * @brief Cached pinhole projection of the beams of a fixed-pattern scanning LiDAR, indexed by beam ID.
+ *
+ * Beam IDs are the fixed channel or scan step identifiers reported by the sensor driver with each point, never the
+ * position of a point in the cloud, since clouds only contain the beams that returned. A beam is a fixed direction and
+ * conditioning only permutes and flips axes, so a beam projects to the same pixel at any range, up to the rounding of
+ * its range-scaled coordinates, which can move a beam lying on a pixel boundary to the neighbouring pixel. The grid pixel
+ * of each of m_numBeams beams is stored the first time it returns a point with positive depth, and later frames replace
+ * the perspective divisions and bounds checks with a table lookup. Pixels are row-major grid indices, negative if the
+ * beam falls outside the grid.
+ *
+ * Each frame is verified before it is looked up. One in verifyStride of the beams is projected again, rotating through
+ * the beams so that every beam is checked once every verifyStride frames, and a checked beam whose pixel changed is
+ * stored again without touching the other beams. Only if most checked beams changed, the IDs do not identify fixed
+ * beams, and the table is cleared so that the frame is projected point by point and stored anew. Entries are atomic so
+ * that frames and ranges of points can be looked up from several threads at once.
+ */
+class ProjectionLut
+{
+	static constexpr size_t verifyStride = 64;
+	static constexpr size_t reportStride = 100;
+
+	const Eigen::Matrix3f m_intrinsic;
+	const int m_rows;
+	const int m_cols;
+	const size_t m_numBeams;
+
+	std::unique_ptr<std::atomic<int32_t>[]> m_pixels;
+	std::atomic<size_t> m_verifyPhase = 0;
+	std::atomic<size_t> m_numRestores = 0;
+	std::atomic<size_t> m_numResets = 0;
+
+	int32_t projectPixel(float x, float y, float z) const;
+
+	void clear();
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the projection model, grid resolution, and number of beams in the scan pattern.
+	 *
+	 * @param intrinsic 3x3 pinhole intrinsic matrix of the organized grid
+	 * @param rows Number of rows in the organized grid
+	 * @param cols Number of columns in the organized grid
+	 * @param num_beams Number of distinct beam IDs reported by the sensor driver
+	 */
+	ProjectionLut(const Eigen::Matrix3f& intrinsic, int rows, int cols, size_t num_beams);
+
+	/*!
+	 * @brief Getter for the number of beams in the cached pattern.
+	 *
+	 * @return Number of distinct beam IDs reported by the sensor driver
+	 */
+	size_t getNumBeams() const;
+
+	/*!
+	 * @brief Checks whether the table was built for a projection model, grid resolution, and number of beams.
+	 *
+	 * @param intrinsic 3x3 pinhole intrinsic matrix of the organized grid
+	 * @param rows Number of rows in the organized grid
+	 * @param cols Number of columns in the organized grid
+	 * @param num_beams Number of distinct beam IDs reported by the sensor driver
+	 * @return true if the table can be used for the given projection, false if not
+	 */
+	bool matches(const Eigen::Matrix3f& intrinsic, int rows, int cols, size_t num_beams) const;
+
+	/*!
+	 * @brief Checks the next rotating subset of cached beams against the projection of a frame's conditioned points.
+	 *
+	 * Checked beams whose pixel changed are stored again, and the table is cleared if most checked beams changed. Must be
+	 * called once per frame before its points are looked up.
+	 *
+	 * @param p_points Pointer to the first of num_points contiguous conditioned (x, y, z) coordinate triplets
+	 * @param p_beam_ids Pointer to the driver beam ID of each conditioned point
+	 * @param num_points Number of conditioned points
+	 * @param num_threads Maximum number of threads to use, 0 means use all hardware threads
+	 */
+	void verify(const float* p_points, const uint32_t* p_beam_ids, size_t num_points, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Looks up the grid pixels of conditioned points from the beams they were measured by.
+	 *
+	 * Beams seen for the first time are projected and stored. Points with non-positive depth get a negative pixel, and
+	 * points with beam IDs outside the table are projected without being stored. Disjoint ranges of a frame's points can
+	 * be looked up concurrently.
+	 *
+	 * @param p_points Pointer to the first of num_points contiguous conditioned (x, y, z) coordinate triplets
+	 * @param p_beam_ids Pointer to the driver beam ID of each conditioned point
+	 * @param num_points Number of conditioned points
+	 * @param p_pixels Pointer to room for num_points values receiving the row-major grid pixel of each point
+	 */
+	void lookup(const float* p_points, const uint32_t* p_beam_ids, size_t num_points, int32_t* p_pixels);
+
+	/*!
+	 * @brief Getter for the number of checked beams that were stored again because their pixel changed.
+	 *
+	 * @return Number of stored again beams since construction
+	 */
+	size_t getNumRestores() const;
+
+	/*!
+	 * @brief Getter for the number of times the table was cleared because the beam IDs disagreed with it.
+	 *
+	 * @return Number of cleared tables since construction
+	 */
+	size_t getNumResets() const;
+};
+
+#endif // PROJECTIONLUT_H
@@ -0,0 +1,125 @@
+#ifndef SCANACCUMULATOR_H
+#define SCANACCUMULATOR_H
+
+struct CamParameters;
+class CompositeFrame;
+class ScanningLidarInterface;
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <functional>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/TensorPool.hpp"
+#include "listener_processing/GridProjector.h"
+
+/*!
+ * @brief Container for the frame boundary settings of a ScanAccumulator.
+ *
+ * m_frameDuration: Sensor time after the first batch of a frame at which the frame is emitted, 0 disables the budget
+ * m_maxFramePoints: Number of accumulated points at which the frame is emitted, 0 disables the limit
+ */
+struct AccumulatorParameters
+{
+	std::chrono::microseconds m_frameDuration{0};
+	size_t m_maxFramePoints = 0;
+};
+
+/*!
+ * @brief Engine that organizes a scanning LiDAR stream batch by batch as packets or partial sweeps arrive.
+ *
+ * Each batch is conditioned with the sensor interface's ScanningLidarInterface::conditionPoints steps and projected
+ * straight into the grid tensor being accumulated with the same pinhole model and nearest point rule as GridFrame
+ * loading, so a frame is ready as soon as its last packet arrives instead of after a full scan is written to and read
+ * back from file. A frame is completed when the caller marks a frame boundary, or when the time or point budget of
+ * AccumulatorParameters is reached. The completed grid is then filtered like a loaded frame if the sensor interface
+ * applies processing, wrapped in a CompositeFrame with normalized depth grayscale and RGB images, and handed to the
+ * emit callback, while accumulation continues in another tensor from a TensorPool. An emitted grid returns to the pool
+ * when the last frame holding it is released, otherwise a new one is allocated.
+ *
+ * Batches must be added from a single thread, which is also the thread the emit callback runs on.
+ */
+class ScanAccumulator
+{
+	static constexpr size_t poolSize = 2;
+
+	const std::shared_ptr<const ScanningLidarInterface> m_sensorInterfacePtr;
+	const std::shared_ptr<CamParameters> m_camParamsPtr;
+	const std::shared_ptr<Eigen::Matrix4f> m_extrinsicPtr;
+	const AccumulatorParameters m_params;
+	const std::function<void(std::shared_ptr<CompositeFrame>)> m_emit;
+
+	const int m_rows;
+	const int m_cols;
+	GridProjector m_projector;
+
+	listener_utils::TensorPool<float> m_gridPool;
+	std::shared_ptr<Eigen::Tensor<float, 3>> m_gridPtr;
+
+	std::vector<float> m_batch;
+	size_t m_framePoints = 0;
+	std::chrono::microseconds m_frameStart{0};
+
+	void insertBatch();
+
+	void emitFrame();
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the sensor, projection model, frame boundaries, and frame consumer.
+	 *
+	 * @param p_sensor_interface Object describing the scanning LiDAR, providing conditioning and filtering settings
+	 * @param p_cam_params Pointer to container for the intrinsic matrix of the organized grid
+	 * @param p_extrinsic Pointer to the 4x4 extrinsic matrix of the sensor relative to its identity sensor
+	 * @param emit Function called with every completed CompositeFrame, typically adding it to a listener's queue
+	 * @param params Time and point budgets after which a frame is completed without an explicit boundary
+	 */
+	ScanAccumulator(std::shared_ptr<const ScanningLidarInterface> p_sensor_interface, std::shared_ptr<CamParameters> p_cam_params,
+		std::shared_ptr<Eigen::Matrix4f> p_extrinsic, std::function<void(std::shared_ptr<CompositeFrame>)> emit,
+		const AccumulatorParameters& params = AccumulatorParameters());
+
+	/*!
+	 * @brief Getter for the frame boundary settings.
+	 *
+	 * @return Reference to the frame boundary settings
+	 */
+	const AccumulatorParameters& getParams() const;
+
+	/*!
+	 * @brief Getter for the number of points projected into the frame currently being accumulated.
+	 *
+	 * @return Number of conditioned points added since the last completed frame
+	 */
+	size_t getPendingPoints() const;
+
+	/*!
+	 * @brief Projects a batch of points into the frame being accumulated, completing frames as boundaries are reached.
+	 *
+	 * If the batch's timestamp is past the time budget of a non-empty frame, that frame is completed before the batch is
+	 * added. The first batch of a frame sets the frame's timestamp.
+	 *
+	 * @tparam T Floating point type of the input coordinates, float or double
+	 * @param p_points Pointer to the first of num_points contiguous raw (x, y, z) coordinate triplets
+	 * @param num_points Number of points in the batch
+	 * @param timestamp Epoch time in microseconds at which the batch was acquired by the sensor
+	 * @param frame_end True if the batch is the last of a scan, completing the frame after it is added
+	 */
+	template <typename T>
+	void addPoints(const T* p_points, size_t num_points, const std::chrono::microseconds& timestamp, bool frame_end = false);
+
+	/*!
+	 * @brief Completes the frame being accumulated, if it holds any points.
+	 */
+	void endFrame();
+
+	/*!
+	 * @brief Discards the frame being accumulated without emitting it.
+	 */
+	void reset();
+};
+
+#endif // SCANACCUMULATOR_H
@@ -0,0 +1,131 @@
+#ifndef TEMPORALFILTER_H
+#define TEMPORALFILTER_H
+
+class CompositeFrame;
+class GridFrame;
+class MaskFrame;
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/TensorPool.hpp"
+#include "listener_processing/ProcessingStage.h"
+
+/*!
+ * @brief Enum class identifying the temporal smoothing strategy used by a TemporalFilter.
+ *
+ * EXPONENTIAL: Exponential moving average of each pixel, restarted wherever the pixel drops out or its depth jumps
+ * MEDIAN: Lower median of the valid depths of each pixel over the history ring, applied along the current pixel's ray
+ * MASKED_MEAN: Mean of the valid points of each pixel over the history ring, ignoring frames where the pixel was masked out
+ */
+enum class TemporalFilterMode
+{
+	EXPONENTIAL,
+	MEDIAN,
+	MASKED_MEAN
+};
+
+/*!
+ * @brief Container for the settings of a TemporalFilter.
+ */
+struct TemporalFilterParameters
+{
+	TemporalFilterMode m_mode = TemporalFilterMode::EXPONENTIAL;
+
+	int m_historySize = 5;
+	float m_alpha = 0.4f;
+	float m_maxDepthChangeFactor = 0.05f;
+	int m_minValidSamples = 1;
+
+	unsigned int m_numThreads = 0;
+};
+
+/*!
+ * @brief Processing stage that smooths the organized point cloud of a listener over time.
+ *
+ * Inherits ProcessingStage. Instead of keeping whole CompositeFrames, the stage keeps a fixed-size ring of the last
+ * m_historySize grids of its listener, storing only what its mode needs, together with running per-pixel state. Each new
+ * frame updates that state in O(pixels) with branchless loops over contiguous channel planes that the compiler vectorizes,
+ * split across threads. Filtered grids and masks are written into tensors from a TensorPool, which takes each one back for
+ * reuse when the last CompositeFrame holding it is released.
+ *
+ * In EXPONENTIAL mode the newest point is weighted by m_alpha, and a pixel restarts from the newest point when its depth
+ * changes by more than m_maxDepthChangeFactor times its depth, with 0 disabling the check. In MEDIAN mode the current
+ * point is scaled along its ray to the median depth. In MASKED_MEAN mode a pixel is kept while it has at least
+ * m_minValidSamples valid samples in the ring, which also bridges short dropouts; MEDIAN mode applies the same minimum
+ * but only to pixels valid in the current frame. The history is cleared when the grid resolution changes.
+ */
+class TemporalFilter final : public ProcessingStage
+{
+	static constexpr int maxHistorySize = 16;
+	static constexpr size_t poolSize = 4;
+
+	const TemporalFilterParameters m_params;
+	const int m_historySize;
+
+	int m_rows = 0;
+	int m_cols = 0;
+	int m_head = 0;
+
+	std::vector<float> m_history;
+	std::vector<unsigned char> m_historyMask;
+	std::vector<double> m_sums;
+	std::vector<float> m_state;
+	std::vector<unsigned char> m_stateMask;
+	std::vector<unsigned short> m_counts;
+
+	listener_utils::TensorPool<float> m_gridPool;
+	listener_utils::TensorPool<bool> m_maskPool;
+
+	void initializeHistory(int rows, int cols);
+
+	void filterExponential(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask);
+
+	void filterMedian(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask);
+
+	void filterMaskedMean(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask);
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the temporal filtering settings.
+	 *
+	 * @param params Filter mode, history length, smoothing factor, depth change limit, minimum samples, and thread count
+	 */
+	explicit TemporalFilter(const TemporalFilterParameters& params = TemporalFilterParameters());
+
+	/*!
+	 * @brief Getter for the temporal filtering settings.
+	 *
+	 * @return Reference to the temporal filtering settings
+	 */
+	const TemporalFilterParameters& getParams() const;
+
+	/*!
+	 * @brief Clears the history ring and running state so that the next frame starts a new sequence.
+	 */
+	void reset();
+
+	/*!
+	 * @brief Adds an organized point cloud to the history and returns its temporally filtered version.
+	 *
+	 * @param grid_frame Organized point cloud frame, the newest in the sequence
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are valid
+	 * @return Pair of pointers to the filtered GridFrame and its MaskFrame, backed by pooled tensors
+	 */
+	std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> filter(const GridFrame& grid_frame, const MaskFrame& mask_frame);
+
+	/*!
+	 * @brief Implements ProcessingStage::process.
+	 *
+	 * Replaces the CompositeFrame's 'POINTCLOUD_GRID' and 'POINTCLOUD_MASK' frames with their filtered versions.
+	 *
+	 * @param composite_frame Reference to the CompositeFrame to filter
+	 */
+	void process(CompositeFrame& composite_frame) override;
+};
+
+#endif // TEMPORALFILTER_H
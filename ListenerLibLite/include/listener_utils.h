@@ -3,6 +3,21 @@
 
 #include "listener_utils/general_utils.hpp"
 #include "listener_utils/CamParameters.hpp"
+#include "listener_utils/EncodingParameters.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/PointCloudBuffer.h"
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/NpyReader.h"
+#include "listener_utils/NpyWriter.h"
+#include "listener_utils/GridCodec.h"
+#include "listener_utils/ImageCodec.h"
+#include "listener_utils/PlyReader.h"
+#include "listener_utils/PointConditioner.h"
+#include "listener_utils/RecordingFormat.hpp"
+#include "listener_utils/RecordingWriter.h"
+#include "listener_utils/RecordingReader.h"
+#include "listener_utils/DatasetIndex.h"
 #include "listener_utils/ListenerDisplayManager.h"
+#include "listener_utils/AsyncFrameWriter.h"
 
 #endif //LISTENER_UTILS_H
@@ -0,0 +1,203 @@
+#ifndef ASYNCFRAMEWRITER_H
+#define ASYNCFRAMEWRITER_H
+
+class CompositeFrame;
+class GenericDataFrame;
+class RecordingWriter;
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <unordered_set>
+#include <unordered_map>
+#include <condition_variable>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/EncodingParameters.hpp"
+#include "listener_utils/NpyWriter.h"
+
+/*!
+ * @brief Enum class identifying what an AsyncFrameWriter does with a frame submitted while its queue is full.
+ *
+ * BLOCK: Waits on the submitting thread until a queued frame is written, so that no frame is lost
+ * DROP: Discards the submitted frame immediately and counts it as dropped
+ */
+enum class WriterOverflow
+{
+	BLOCK,
+	DROP
+};
+
+/*!
+ * @brief Enum class identifying how an AsyncFrameWriter lays out recorded frames on disk.
+ *
+ * DIRECTORIES: One file per data frame in one directory per FrameID, as written by CompositeFrame::saveAll
+ * CONTAINER: All data frames appended to a single indexed recording file read by RecordingReader
+ */
+enum class WriterLayout
+{
+	DIRECTORIES,
+	CONTAINER
+};
+
+/*!
+ * @brief Container for the settings of an AsyncFrameWriter.
+ *
+ * m_npySync: How the NPY files of each frame are made durable with the DIRECTORIES layout; the files of a frame are
+ * written as one NpyWriter batch that is synced once its last data frame is written
+ */
+struct WriterParameters
+{
+	unsigned int m_numThreads = 0;
+	size_t m_maxQueuedFrames = 16;
+	WriterOverflow m_overflow = WriterOverflow::BLOCK;
+	WriterLayout m_layout = WriterLayout::DIRECTORIES;
+	EncodingParameters m_encodingParams;
+	NpySync m_npySync = NpySync::NONE;
+};
+
+/*!
+ * @brief Container for the backpressure and drop statistics of an AsyncFrameWriter.
+ *
+ * m_framesSubmitted: Frames passed to AsyncFrameWriter::submit
+ * m_framesWritten: Frames whose data frames were all written and, if requested, synced
+ * m_framesFailed: Frames of which a data frame failed to write or sync, left out of the DatasetIndex
+ * m_framesEmpty: Frames without data frames, of which nothing was written
+ * m_framesDropped: Frames discarded because the queue was full
+ * m_writeErrors: Data frames whose save method threw, and frames whose NPY files failed to sync
+ * m_peakQueuedFrames: Largest number of frames queued or being written at once
+ * m_blockedTime: Total time submitting threads waited for room in the queue
+ */
+struct WriterStatistics
+{
+	size_t m_framesSubmitted = 0;
+	size_t m_framesWritten = 0;
+	size_t m_framesFailed = 0;
+	size_t m_framesEmpty = 0;
+	size_t m_framesDropped = 0;
+	size_t m_writeErrors = 0;
+	size_t m_peakQueuedFrames = 0;
+	std::chrono::microseconds m_blockedTime{0};
+};
+
+/*!
+ * @brief Background recorder that writes CompositeFrame objects to file on a pool of encoder threads.
+ *
+ * Files are laid out as by CompositeFrame::saveAll, with one directory per FrameID that is created the first time the
+ * FrameID is submitted rather than checked for every frame. Each data frame of a submitted CompositeFrame is a separate
+ * job, so image compression and array writes of one frame run in parallel. At most m_maxQueuedFrames frames are queued
+ * or being written at once; beyond that, submission blocks or drops according to m_overflow, and both cases are reported
+ * through AsyncFrameWriter::getStatistics. The destructor writes every queued frame before returning.
+ *
+ * With the CONTAINER layout, frames are instead appended to a single recording named by AsyncFrameWriter::recordingName
+ * in the save directory. The recording takes its camera parameters and extrinsic matrix from the first submitted frame
+ * and its footer index is written when the AsyncFrameWriter is destroyed.
+ *
+ * With the DIRECTORIES layout, a DatasetIndex of the recorded files and their frame timestamps is written to the save
+ * directory when the AsyncFrameWriter is destroyed, so that SavedListener can open the recording without listing it and
+ * replay it by its timestamps. Frames of which any file failed to write or sync are left out of the index.
+ */
+class AsyncFrameWriter
+{
+	struct FrameProgress
+	{
+		std::atomic<int> m_remainingJobs;
+		std::atomic<bool> m_failed = false;
+
+		explicit FrameProgress(const int num_jobs)
+			: m_remainingJobs(num_jobs)
+		{
+		}
+	};
+
+	struct WriteJob
+	{
+		std::shared_ptr<GenericDataFrame> m_dataFramePtr;
+		std::string m_filePath;
+		std::shared_ptr<FrameProgress> m_progressPtr;
+		std::shared_ptr<NpyWriter> m_npyWriterPtr;
+		FrameID m_frameID;
+		unsigned int m_frameNumber;
+		std::chrono::microseconds m_timestamp;
+	};
+
+	const std::string m_saveDir;
+	const WriterParameters m_params;
+
+	std::unordered_set<FrameID> m_createdDirs;
+	std::unordered_map<unsigned int, std::chrono::microseconds> m_timestamps;
+	std::unordered_set<unsigned int> m_failedFrames;
+	std::unique_ptr<RecordingWriter> m_recordingPtr;
+
+	std::deque<WriteJob> m_jobs;
+	size_t m_queuedFrames = 0;
+	bool m_stopping = false;
+	WriterStatistics m_stats;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_jobEvent;
+	std::condition_variable m_doneEvent;
+
+	std::vector<std::thread> m_workers;
+
+	void workerLoop();
+
+public:
+
+	/*!
+	 * @brief File name of the recording written in the save directory with the CONTAINER layout.
+	 */
+	static constexpr const char* recordingName = "recording.lrec";
+
+	/*!
+	 * @brief Constructor method that starts the encoder threads.
+	 *
+	 * @param save_dir Path to directory where all data will be saved in individual data type directories
+	 * @param params Encoder thread count, queue bound in frames, overflow behaviour, file layout, and file formats
+	 */
+	explicit AsyncFrameWriter(const std::string& save_dir, const WriterParameters& params = WriterParameters());
+
+	/*!
+	 * @brief Destructor method that writes all queued frames and stops the encoder threads.
+	 */
+	~AsyncFrameWriter();
+
+	AsyncFrameWriter(const AsyncFrameWriter&) = delete;
+	AsyncFrameWriter& operator=(const AsyncFrameWriter&) = delete;
+
+	/*!
+	 * @brief Queues all data frames of a CompositeFrame to be written in the background.
+	 *
+	 * The CompositeFrame is kept alive until it has been written and should not be modified in the meantime.
+	 *
+	 * @param p_composite_frame Pointer to the CompositeFrame to write
+	 * @param frame_number Identifies instance number based on total number of instances created by a given sensor
+	 * @return true if the frame was queued, false if it was dropped because the queue was full
+	 */
+	bool submit(std::shared_ptr<CompositeFrame> p_composite_frame, unsigned int frame_number);
+
+	/*!
+	 * @brief Blocks until every queued frame has been written.
+	 */
+	void flush();
+
+	/*!
+	 * @brief Getter for the number of frames queued or being written.
+	 *
+	 * @return Current number of frames in flight
+	 */
+	size_t getQueuedFrames() const;
+
+	/*!
+	 * @brief Getter for the backpressure and drop statistics accumulated since construction.
+	 *
+	 * @return Copy of the writer statistics
+	 */
+	WriterStatistics getStatistics() const;
+};
+
+#endif // ASYNCFRAMEWRITER_H
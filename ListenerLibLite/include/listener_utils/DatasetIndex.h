@@ -0,0 +1,153 @@
+#ifndef DATASETINDEX_H
+#define DATASETINDEX_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+#include <unordered_map>
+
+#include "listener_utils/general_utils.hpp"
+
+/*!
+ * @brief Index of the per-FrameID files of a saved dataset, as written by CompositeFrame::saveAll or AsyncFrameWriter.
+ *
+ * Files of different FrameIDs are aligned into frames by the frame number at the end of their names, so a frame missing
+ * from one FrameID directory is dropped rather than shifting every later frame out of step. Files without frame numbers
+ * are aligned by their natural sort order instead, which requires every FrameID to have the same number of files. Each
+ * frame records its frame number, timestamp if known, and the name of its file for every FrameID.
+ *
+ * The index is cached in the dataset directory under DatasetIndex::fileName together with the modification time of
+ * every FrameID directory, so reopening an unchanged dataset reads one file instead of listing and sorting every
+ * directory. AsyncFrameWriter writes the index with frame timestamps when a recording finishes.
+ */
+class DatasetIndex
+{
+	struct FrameRecord
+	{
+		unsigned int m_frameNumber;
+		std::chrono::microseconds m_timestamp;
+		std::vector<std::string> m_fileNames;
+	};
+
+	std::string m_dataDir;
+	bool m_flat = false;
+	bool m_hasTimestamps = false;
+	std::vector<FrameID> m_frameIDs;
+	std::vector<int64_t> m_dirTimes;
+	std::vector<FrameRecord> m_frames;
+
+	DatasetIndex() = default;
+
+	std::string getFrameDir(FrameID frame_id) const;
+
+	size_t getColumn(FrameID frame_id) const;
+
+	static std::unique_ptr<DatasetIndex> read(const std::string& data_dir);
+
+public:
+
+	/*!
+	 * @brief File name of the index cached in a dataset directory.
+	 */
+	static constexpr const char* fileName = "dataset.lidx";
+
+	/*!
+	 * @brief Builds an index by listing the FrameID directories of a dataset.
+	 *
+	 * @param data_dir Directory containing one directory per FrameID, or the data files themselves if flat
+	 * @param frame_ids FrameIDs to index
+	 * @param flat true if the files of a single FrameID lie directly in data_dir
+	 * @return Index of the frames present for every FrameID
+	 */
+	static DatasetIndex scan(const std::string& data_dir, const std::vector<FrameID>& frame_ids, bool flat = false);
+
+	/*!
+	 * @brief Opens the cached index of a dataset, or builds and caches a new one if it is missing, out of date, or indexes other FrameIDs.
+	 *
+	 * Timestamps of a replaced index are carried over to the frames with the same frame numbers. A current cached index of
+	 * more FrameIDs is not replaced, so opening a subset of FrameIDs lists their directories every time. Failing to write
+	 * the cache is reported but not an error.
+	 *
+	 * @param data_dir Directory containing one directory per FrameID
+	 * @param frame_ids FrameIDs to index
+	 * @return Index of exactly the given FrameIDs
+	 */
+	static DatasetIndex open(const std::string& data_dir, const std::vector<FrameID>& frame_ids);
+
+	/*!
+	 * @brief Writes the index to DatasetIndex::fileName in its dataset directory.
+	 */
+	void save() const;
+
+	/*!
+	 * @brief Checks whether the FrameID directories are unchanged since the index was built.
+	 *
+	 * @return true if every FrameID directory has the modification time it had when indexed
+	 */
+	bool isCurrent() const;
+
+	/*!
+	 * @brief Sets frame timestamps from their frame numbers, for frames recorded with known timestamps.
+	 *
+	 * @param timestamps Map of frame numbers to epoch times in microseconds, frames missing from it keep their timestamps
+	 */
+	void setTimestamps(const std::unordered_map<unsigned int, std::chrono::microseconds>& timestamps);
+
+	/*!
+	 * @brief Removes frames from the index by their frame numbers, for frames whose files are incomplete.
+	 *
+	 * @param frame_numbers Set of frame numbers to leave out of the index
+	 */
+	void removeFrames(const std::unordered_set<unsigned int>& frame_numbers);
+
+	/*!
+	 * @brief Getter for the indexed FrameIDs.
+	 *
+	 * @return Vector of FrameIDs with files in every indexed frame
+	 */
+	const std::vector<FrameID>& getFrameIDs() const;
+
+	/*!
+	 * @brief Getter for whether frames carry recorded timestamps.
+	 *
+	 * @return true if the index was written with the timestamps the frames were recorded with
+	 */
+	bool hasTimestamps() const;
+
+	/*!
+	 * @brief Getter for the number of indexed frames.
+	 *
+	 * @return Number of frames present for every FrameID
+	 */
+	size_t getNumFrames() const;
+
+	/*!
+	 * @brief Getter for the frame number a frame was saved with.
+	 *
+	 * @param index Position of the frame in the index, from 0 to getNumFrames() - 1
+	 * @return Frame number from the file names, or the position for files without frame numbers
+	 */
+	unsigned int getFrameNumber(size_t index) const;
+
+	/*!
+	 * @brief Getter for the timestamp a frame was recorded with.
+	 *
+	 * @param index Position of the frame in the index, from 0 to getNumFrames() - 1
+	 * @return Epoch time in microseconds at which the frame was received by the sensor, 0 if unknown
+	 */
+	std::chrono::microseconds getTimestamp(size_t index) const;
+
+	/*!
+	 * @brief Getter for the path of the file holding one FrameID of a frame.
+	 *
+	 * @param index Position of the frame in the index, from 0 to getNumFrames() - 1
+	 * @param frame_id Identifier of the data frame
+	 * @return Path to the file
+	 */
+	std::string getPath(size_t index, FrameID frame_id) const;
+};
+
+#endif // DATASETINDEX_H
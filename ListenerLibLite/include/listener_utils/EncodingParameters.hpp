@@ -0,0 +1,67 @@
+#ifndef ENCODINGPARAMETERS_HPP
+#define ENCODINGPARAMETERS_HPP
+
+class NpyWriter;
+
+#include <memory>
+
+/*!
+ * @brief Enum class identifying the file format floating point grid frames are saved in.
+ *
+ * NPY: Uncompressed NumPy array, readable by any NumPy-based tool
+ * GRID_CODEC: Lossless compressed grid written by grid_codec, several times smaller and fast to decode
+ */
+enum class GridEncoding
+{
+	NPY,
+	GRID_CODEC
+};
+
+/*!
+ * @brief Enum class identifying the file format 8-bit image and mask frames are saved in.
+ *
+ * PNG: Deflate-compressed PNG image with tunable compression level and strategy, readable by any image tool
+ * QOI: Lossless Quite OK Image, several times faster to encode than PNG at a similar size for color images; single-channel
+ * images are stored as gray RGB
+ * RAW: Uncompressed frame storage behind a 16-byte header, written and read with a single copy
+ */
+enum class ImageEncoding
+{
+	PNG,
+	QOI,
+	RAW
+};
+
+/*!
+ * @brief Enum class identifying the zlib strategy used for PNG compression, matching OpenCV's PNG strategy flags.
+ */
+enum class PngStrategy
+{
+	DEFAULT,
+	FILTERED,
+	HUFFMAN_ONLY,
+	RLE,
+	FIXED
+};
+
+/*!
+ * @brief Container for the file formats and encoder settings used when saving data frames.
+ *
+ * m_gridEncoding: Format of point cloud and temperature grids
+ * m_gridQuantization: Step that GRID_CODEC values are stored as integer multiples of, 0 means store exact float values
+ * m_imageEncoding: Format of grayscale, RGB, and mask images
+ * m_pngCompression: PNG compression level from 0 (fastest) to 9 (smallest), -1 means use the OpenCV default
+ * m_pngStrategy: zlib strategy of PNG compression; HUFFMAN_ONLY and RLE are much faster than DEFAULT on large images
+ * m_npyWriterPtr: Batch NPY files are written through so that they are synced together, nullptr writes each file unsynced
+ */
+struct EncodingParameters
+{
+	GridEncoding m_gridEncoding = GridEncoding::NPY;
+	float m_gridQuantization = 0.0f;
+	ImageEncoding m_imageEncoding = ImageEncoding::PNG;
+	int m_pngCompression = -1;
+	PngStrategy m_pngStrategy = PngStrategy::DEFAULT;
+	std::shared_ptr<NpyWriter> m_npyWriterPtr;
+};
+
+#endif // ENCODINGPARAMETERS_HPP
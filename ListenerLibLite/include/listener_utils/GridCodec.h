@@ -0,0 +1,70 @@
+#ifndef GRIDCODEC_H
+#define GRIDCODEC_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+/*!
+ * @brief Dependency-free lossless codec for floating point grids such as depth images and organized point clouds.
+ *
+ * Values are read in the tensor's column-major order, so each channel is coded down the image columns, and mapped to
+ * integers: the order-preserving integer form of their float bits by default, or integer multiples of a quantization
+ * step. Each value is predicted by the one before it, and the zigzag-coded residuals are bit-packed in blocks of 32 at
+ * the smallest width that fits the block. Smooth surfaces therefore cost a few bits per value and runs of invalid zero
+ * points cost one byte per block. Blocks are grouped into independent segments that are encoded and decoded in parallel.
+ *
+ * Quantized grids are exact when their values are already multiples of the step, as with depth reported in integer
+ * sensor units, and otherwise round to the nearest step. Non-finite values in quantized grids decode as 0, the invalid
+ * point value, and values beyond 2^31 steps saturate. Unquantized grids keep every bit pattern, including NaNs.
+ */
+namespace grid_codec
+{
+	/*!
+	 * @brief File extension of grids saved by grid_codec::save.
+	 */
+	constexpr const char* fileExtension = ".grc";
+
+	/*!
+	 * @brief Compresses a grid into a self-describing buffer.
+	 *
+	 * @param tensor Grid to compress
+	 * @param quantization Step values are stored as integer multiples of, 0 means store exact float values
+	 * @param num_threads Maximum number of threads to split segments across, 0 means use all hardware threads
+	 * @return Compressed bytes, including header
+	 */
+	std::vector<uint8_t> encode(const Eigen::Tensor<float, 3>& tensor, float quantization = 0.0f, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Decompresses a buffer created by grid_codec::encode.
+	 *
+	 * @param p_data Pointer to the compressed bytes
+	 * @param size Number of compressed bytes
+	 * @param num_threads Maximum number of threads to split segments across, 0 means use all hardware threads
+	 * @return Pointer to a new tensor containing the grid
+	 */
+	std::shared_ptr<Eigen::Tensor<float, 3>> decode(const uint8_t* p_data, size_t size, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Compresses a grid and writes it to file.
+	 *
+	 * @param file_path Path to the file, including extension
+	 * @param tensor Grid to compress
+	 * @param quantization Step values are stored as integer multiples of, 0 means store exact float values
+	 */
+	void save(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor, float quantization = 0.0f);
+
+	/*!
+	 * @brief Maps a compressed grid file and decompresses it.
+	 *
+	 * @param file_path Path to the file
+	 * @return Pointer to a new tensor containing the grid
+	 */
+	std::shared_ptr<Eigen::Tensor<float, 3>> load(const std::string& file_path);
+}
+
+#endif // GRIDCODEC_H
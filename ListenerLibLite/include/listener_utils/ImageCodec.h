@@ -0,0 +1,79 @@
+#ifndef IMAGECODEC_H
+#define IMAGECODEC_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/EncodingParameters.hpp"
+
+/*!
+ * @brief Savers and loaders for 8-bit image frames in the formats selected by ImageEncoding.
+ *
+ * Images are read from and written to the planar column-major layout of frame storage directly, so no intermediate
+ * cv::Mat copies or color conversions are made: RAW files hold frame storage as is, QOI files are encoded and decoded in a
+ * single pass over the pixels, and PNG files are converted to OpenCV's interleaved BGR layout in a single pass before
+ * compression.
+ */
+namespace image_codec
+{
+	/*!
+	 * @brief File extension of images saved with the QOI encoding.
+	 */
+	constexpr const char* qoiExtension = ".qoi";
+
+	/*!
+	 * @brief File extension of images saved with the RAW encoding.
+	 */
+	constexpr const char* rawExtension = ".raw";
+
+	/*!
+	 * @brief Encodes an image in the Quite OK Image format.
+	 *
+	 * @param p_planar Pointer to the image in planar column-major order, as in an Eigen::Tensor
+	 * @param rows Number of rows in the image
+	 * @param cols Number of columns in the image
+	 * @param channels Number of channels in the image, 1 or 3
+	 * @param scale Factor every value is multiplied by, such as 255 to store a 0 or 1 mask as a visible image
+	 * @return Encoded bytes, including header and end marker
+	 */
+	std::vector<uint8_t> encodeQoi(const unsigned char* p_planar, int rows, int cols, int channels, unsigned char scale = 1);
+
+	/*!
+	 * @brief Decodes an image in the Quite OK Image format.
+	 *
+	 * @param p_data Pointer to the encoded bytes
+	 * @param size Number of encoded bytes
+	 * @param channels Number of channels of the returned image, 1 to keep only the first channel or 3
+	 * @return Pointer to a new tensor containing the image
+	 */
+	std::shared_ptr<Eigen::Tensor<unsigned char, 3>> decodeQoi(const uint8_t* p_data, size_t size, int channels);
+
+	/*!
+	 * @brief Saves an image in the format selected by the encoding parameters.
+	 *
+	 * @param file_path File path minus extension, which is added according to the format
+	 * @param p_planar Pointer to the image in planar column-major order, as in an Eigen::Tensor
+	 * @param rows Number of rows in the image
+	 * @param cols Number of columns in the image
+	 * @param channels Number of channels in the image, 1 or 3 in RGB order
+	 * @param encoding_params File format and PNG settings
+	 * @param binary true if values are 0 or 1 and should be stored as 0 or 255 in viewable formats
+	 */
+	void save(const std::string& file_path, const unsigned char* p_planar, int rows, int cols, int channels, const EncodingParameters& encoding_params, bool binary = false);
+
+	/*!
+	 * @brief Loads an image saved in any of the supported formats, chosen by file extension.
+	 *
+	 * @param file_path Path to the file, including extension
+	 * @param channels Number of channels of the returned image, 1 or 3 in RGB order
+	 * @return Pointer to a new tensor containing the image
+	 */
+	std::shared_ptr<Eigen::Tensor<unsigned char, 3>> load(const std::string& file_path, int channels);
+}
+
+#endif // IMAGECODEC_H
@@ -0,0 +1,57 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+/*!
+ * @brief Read-only memory mapping of a whole file that is unmapped when the object is destroyed.
+ *
+ * Uses mmap on POSIX platforms and file mapping objects on Windows, so file contents are paged in on demand instead of
+ * being copied into a user buffer.
+ */
+class MappedFile
+{
+	const unsigned char* m_data = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#else
+	int m_fileDescriptor = -1;
+#endif
+
+public:
+
+	/*!
+	 * @brief Constructor method to map a file into memory.
+	 *
+	 * @param file_path Path to the file to map
+	 */
+	explicit MappedFile(const std::string& file_path);
+
+	/*!
+	 * @brief Destructor method to unmap the file and close its handles.
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/*!
+	 * @brief Getter for the mapped file contents.
+	 *
+	 * @return Pointer to the first byte of the file, nullptr if the file is empty
+	 */
+	const unsigned char* getData() const;
+
+	/*!
+	 * @brief Getter for the size of the mapped file.
+	 *
+	 * @return Size of the file in bytes
+	 */
+	size_t getSize() const;
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,69 @@
+#ifndef NPYREADER_H
+#define NPYREADER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/MappedFile.h"
+
+/*!
+ * @brief Native reader for little-endian float32 NPY files.
+ *
+ * The file is memory-mapped and its header validated once on construction, after which the array is available in place
+ * through NpyReader::getData. NpyReader::readTensor fills a column-major Eigen::Tensor straight from the mapped payload,
+ * with a single memcpy for Fortran-ordered files, whose layout matches the tensor, and a parallel tiled transpose for
+ * C-ordered files. Arrays of one to three dimensions are supported; missing trailing dimensions have size 1.
+ */
+class NpyReader
+{
+	const MappedFile m_file;
+
+	bool m_fortranOrder = false;
+	std::vector<size_t> m_shape;
+	size_t m_dataOffset = 0;
+
+	void parseHeader();
+
+public:
+
+	/*!
+	 * @brief Constructor method to map an NPY file and validate its header.
+	 *
+	 * @param file_path Path to the NPY file
+	 */
+	explicit NpyReader(const std::string& file_path);
+
+	/*!
+	 * @brief Getter for the shape of the array, padded with trailing 1s to three dimensions.
+	 *
+	 * @return Reference to vector of the array's rows, columns, and channels
+	 */
+	const std::vector<size_t>& getShape() const;
+
+	/*!
+	 * @brief Getter for whether the array is stored in Fortran (column-major) order.
+	 *
+	 * @return true if Fortran-ordered, false if C-ordered
+	 */
+	bool isFortranOrder() const;
+
+	/*!
+	 * @brief Getter for the array values in the mapped file, valid for the lifetime of the reader.
+	 *
+	 * @return Pointer to the first value of the array in file order
+	 */
+	const float* getData() const;
+
+	/*!
+	 * @brief Copies the array into a tensor of matching dimensions.
+	 *
+	 * @param tensor Column-major tensor sized to the array's shape
+	 * @param num_threads Maximum number of threads to split a C-ordered transpose across, 0 means use all hardware threads
+	 */
+	void readTensor(Eigen::Tensor<float, 3>& tensor, unsigned int num_threads = 0) const;
+};
+
+#endif // NPYREADER_H
@@ -0,0 +1,80 @@
+#ifndef NPYWRITER_H
+#define NPYWRITER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+/*!
+ * @brief Enum class identifying how an NpyWriter makes written files durable.
+ *
+ * NONE: Leaves written data in the page cache for the operating system to write back
+ * DATASYNC: Starts writeback of each file as it is written and waits for all of them with fdatasync when the batch finishes
+ * DROP_CACHE: As DATASYNC, then drops the written pages from the page cache so that long recordings do not evict other data
+ */
+enum class NpySync
+{
+	NONE,
+	DATASYNC,
+	DROP_CACHE
+};
+
+/*!
+ * @brief Native writer for little-endian float32 NPY files.
+ *
+ * Tensors are written in Fortran order, which matches the column-major layout of Eigen::Tensor, so each file is written
+ * from its header and the tensor's own buffer in a single vectored write without any intermediate copy. Files written by
+ * one NpyWriter form a batch that is synced together by NpyWriter::finish according to the sync policy, letting writeback
+ * of several frames overlap instead of waiting on each file in turn. Files of a batch may be written from several threads.
+ */
+class NpyWriter
+{
+	const NpySync m_sync;
+
+	std::vector<int> m_pendingFiles;
+	std::mutex m_pendingMutex;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the sync policy of the batch.
+	 *
+	 * @param sync How written files are made durable when the batch finishes
+	 */
+	explicit NpyWriter(NpySync sync = NpySync::NONE);
+
+	/*!
+	 * @brief Destructor method that finishes the batch.
+	 */
+	~NpyWriter();
+
+	NpyWriter(const NpyWriter&) = delete;
+	NpyWriter& operator=(const NpyWriter&) = delete;
+
+	/*!
+	 * @brief Writes a tensor to an NPY file as part of the batch, in Fortran order straight from the tensor's buffer.
+	 *
+	 * @param file_path Path to the NPY file, including extension
+	 * @param tensor Tensor to write
+	 */
+	void write(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor);
+
+	/*!
+	 * @brief Syncs and closes all files written since the last call according to the sync policy.
+	 */
+	void finish();
+
+	/*!
+	 * @brief Helper function to write a single tensor to an NPY file as part of a batch, or without syncing if none is given.
+	 *
+	 * @param file_path Path to the NPY file, including extension
+	 * @param tensor Tensor to write
+	 * @param p_batch Pointer to the NpyWriter whose batch the file joins, nullptr to write the file on its own
+	 */
+	static void save(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor, const std::shared_ptr<NpyWriter>& p_batch = nullptr);
+};
+
+#endif // NPYWRITER_H
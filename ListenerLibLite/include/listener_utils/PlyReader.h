@@ -0,0 +1,120 @@
+#ifndef PLYREADER_H
+#define PLYREADER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "listener_utils/MappedFile.h"
+
+/*!
+ * @brief Enum class identifying the scalar type of a PLY vertex property.
+ */
+enum class PlyType
+{
+	INT8,
+	UINT8,
+	INT16,
+	UINT16,
+	INT32,
+	UINT32,
+	FLOAT32,
+	FLOAT64
+};
+
+/*!
+ * @brief Container for the name, scalar type, and byte offset within a vertex record of a PLY vertex property.
+ */
+struct PlyProperty
+{
+	std::string m_name;
+	PlyType m_type;
+	size_t m_offset;
+};
+
+/*!
+ * @brief Native reader for the vertices of binary PLY files.
+ *
+ * The file is memory-mapped and its header parsed once on construction. Vertex properties are then converted straight from
+ * the mapped records into caller-provided float or double buffers, swapping bytes for big-endian files, with the vertex
+ * range optionally split across threads. Any number of fixed-size scalar vertex properties is supported, so channels
+ * such as intensity or timestamps can be read alongside the coordinates. ASCII files and vertex list properties are not
+ * supported; PlyReader::isBinary can be checked to fall back to another reader.
+ */
+class PlyReader
+{
+	const MappedFile m_file;
+
+	bool m_binary = false;
+	bool m_bigEndian = false;
+	size_t m_vertexCount = 0;
+	size_t m_vertexStride = 0;
+	size_t m_vertexDataOffset = 0;
+	std::vector<PlyProperty> m_properties;
+
+	void parseHeader();
+
+	const PlyProperty& findProperty(const std::string& name) const;
+
+public:
+
+	/*!
+	 * @brief Constructor method to map a PLY file and parse its header.
+	 *
+	 * @param file_path Path to the PLY file
+	 */
+	explicit PlyReader(const std::string& file_path);
+
+	/*!
+	 * @brief Getter for whether the file stores its elements in binary format.
+	 *
+	 * @return true if the format is binary little- or big-endian, false if ASCII
+	 */
+	bool isBinary() const;
+
+	/*!
+	 * @brief Getter for the number of vertices in the file.
+	 *
+	 * @return Number of vertices
+	 */
+	size_t getVertexCount() const;
+
+	/*!
+	 * @brief Getter for the scalar properties of each vertex in file order.
+	 *
+	 * @return Reference to vector of vertex property descriptions
+	 */
+	const std::vector<PlyProperty>& getProperties() const;
+
+	/*!
+	 * @brief Checks whether vertices have a property.
+	 *
+	 * @param name Name of the vertex property
+	 * @return true if the property is present, false if not
+	 */
+	bool hasProperty(const std::string& name) const;
+
+	/*!
+	 * @brief Converts one property of all vertices into a strided output buffer.
+	 *
+	 * @tparam T Output type, float or double
+	 * @param name Name of the vertex property
+	 * @param p_out Pointer to output buffer with room for getVertexCount() values spaced by stride elements
+	 * @param stride Distance in elements between consecutive output values
+	 * @param num_threads Maximum number of threads to split vertices across, 0 means use all hardware threads
+	 */
+	template <typename T>
+	void readProperty(const std::string& name, T* p_out, size_t stride = 1, unsigned int num_threads = 0) const;
+
+	/*!
+	 * @brief Converts the 'x', 'y', and 'z' properties of all vertices into an interleaved coordinate buffer.
+	 *
+	 * @tparam T Output type, float or double
+	 * @param p_xyz Pointer to output buffer with room for 3 * getVertexCount() values
+	 * @param num_threads Maximum number of threads to split vertices across, 0 means use all hardware threads
+	 */
+	template <typename T>
+	void readPoints(T* p_xyz, unsigned int num_threads = 0) const;
+};
+
+#endif // PLYREADER_H
@@ -0,0 +1,274 @@
+#ifndef POINTCLOUDBUFFER_H
+#define POINTCLOUDBUFFER_H
+
+class GridFrame;
+class MaskFrame;
+class RGBFrame;
+class GrayFrame;
+
+namespace open3d::geometry
+{
+	class PointCloud;
+}
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <Eigen/Dense>
+
+/*!
+ * @brief Enum class describing the memory layout of the point coordinates in a PointCloudBuffer.
+ *
+ * SOA: Separate contiguous x, y, and z arrays
+ * AOS: One interleaved array of (x, y, z, 1) points, padded to four floats for aligned vectorized access
+ */
+enum class PointLayout
+{
+	SOA,
+	AOS
+};
+
+/*!
+ * @brief Library-native unorganized point cloud container with float32 coordinates and optional per-point channels.
+ *
+ * All arrays are stored in aligned memory. Optional channels are RGB colors as unsigned chars, intensities as floats
+ * normalized to [0, 1], row-major pixel indices into the organized frame a point was taken from, and tags identifying
+ * the source sensor of each point. Conversion to an Open3D PointCloud is provided explicitly by PointCloudBuffer::toOpen3D.
+ */
+class PointCloudBuffer
+{
+public:
+
+	template <typename T>
+	using AlignedVector = std::vector<T, Eigen::aligned_allocator<T>>;
+
+	static constexpr int aosStride = 4;
+
+private:
+
+	const PointLayout m_layout;
+	const bool m_hasColor;
+	const bool m_hasIntensity;
+	const bool m_hasPixelIndex;
+	const bool m_hasSourceTag;
+
+	size_t m_size = 0;
+
+	AlignedVector<float> m_x;
+	AlignedVector<float> m_y;
+	AlignedVector<float> m_z;
+	AlignedVector<float> m_xyzw;
+	AlignedVector<unsigned char> m_colors;
+	AlignedVector<float> m_intensities;
+	AlignedVector<uint32_t> m_pixelIndices;
+	AlignedVector<uint16_t> m_sourceTags;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the point layout and which optional channels are stored.
+	 *
+	 * @param layout Memory layout of the point coordinates
+	 * @param has_color true if RGB colors should be stored per point, false if not
+	 * @param has_intensity true if intensities should be stored per point, false if not
+	 * @param has_pixel_index true if source pixel indices should be stored per point, false if not
+	 * @param has_source_tag true if source sensor tags should be stored per point, false if not
+	 */
+	explicit PointCloudBuffer(PointLayout layout = PointLayout::SOA, bool has_color = false, bool has_intensity = false, bool has_pixel_index = false, bool has_source_tag = false);
+
+	/*!
+	 * @brief Getter for the memory layout of the point coordinates.
+	 *
+	 * @return Point coordinate layout enum
+	 */
+	const PointLayout& getLayout() const;
+
+	/*!
+	 * @brief Getter for the number of points in the buffer.
+	 *
+	 * @return Number of points
+	 */
+	size_t getSize() const;
+
+	/*!
+	 * @brief Getter for whether RGB colors are stored per point.
+	 *
+	 * @return true if the color channel is present, false if not
+	 */
+	bool hasColor() const;
+
+	/*!
+	 * @brief Getter for whether intensities are stored per point.
+	 *
+	 * @return true if the intensity channel is present, false if not
+	 */
+	bool hasIntensity() const;
+
+	/*!
+	 * @brief Getter for whether source pixel indices are stored per point.
+	 *
+	 * @return true if the pixel index channel is present, false if not
+	 */
+	bool hasPixelIndex() const;
+
+	/*!
+	 * @brief Getter for whether source sensor tags are stored per point.
+	 *
+	 * @return true if the source tag channel is present, false if not
+	 */
+	bool hasSourceTag() const;
+
+	/*!
+	 * @brief Reserves storage for a number of points in all present channels without changing the size.
+	 *
+	 * @param capacity Number of points to reserve storage for
+	 */
+	void reserve(size_t capacity);
+
+	/*!
+	 * @brief Resizes all present channels to hold a number of points. New points are zeroed.
+	 *
+	 * @param size New number of points
+	 */
+	void resize(size_t size);
+
+	/*!
+	 * @brief Sets the number of points to zero while keeping allocated storage.
+	 */
+	void clear();
+
+	/*!
+	 * @brief Sets the coordinates of a point regardless of layout.
+	 *
+	 * @param index Index of the point
+	 * @param point Coordinates of the point
+	 */
+	void setPoint(size_t index, const Eigen::Vector3f& point);
+
+	/*!
+	 * @brief Getter for the coordinates of a point regardless of layout.
+	 *
+	 * @param index Index of the point
+	 * @return Coordinates of the point
+	 */
+	Eigen::Vector3f getPoint(size_t index) const;
+
+	/*!
+	 * @brief Getters for the contiguous x, y, and z arrays of a SOA buffer.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the buffer has AOS layout
+	 */
+	float* getXData();
+	const float* getXData() const;
+	float* getYData();
+	const float* getYData() const;
+	float* getZData();
+	const float* getZData() const;
+
+	/*!
+	 * @brief Getters for the interleaved (x, y, z, 1) array of an AOS buffer.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the buffer has SOA layout
+	 */
+	float* getXYZWData();
+	const float* getXYZWData() const;
+
+	/*!
+	 * @brief Getters for the interleaved RGB array.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the channel is not present
+	 */
+	unsigned char* getColorData();
+	const unsigned char* getColorData() const;
+
+	/*!
+	 * @brief Getters for the intensity array.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the channel is not present
+	 */
+	float* getIntensityData();
+	const float* getIntensityData() const;
+
+	/*!
+	 * @brief Getters for the row-major source pixel index array.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the channel is not present
+	 */
+	uint32_t* getPixelIndexData();
+	const uint32_t* getPixelIndexData() const;
+
+	/*!
+	 * @brief Getters for the source sensor tag array.
+	 *
+	 * @return Pointer to the first element of the array, nullptr if the channel is not present
+	 */
+	uint16_t* getSourceTagData();
+	const uint16_t* getSourceTagData() const;
+
+	/*!
+	 * @brief Counts the points selected by a point cloud mask.
+	 *
+	 * @param mask_frame Boolean mask of an organized point cloud
+	 * @return Number of 'true' pixels in the mask
+	 */
+	static size_t countMasked(const MaskFrame& mask_frame);
+
+	/*!
+	 * @brief Populates the buffer with the masked points of an organized point cloud in row-major pixel order.
+	 *
+	 * Rows are processed in parallel. Optional channels are filled from the given frames if present in the buffer,
+	 * and zeroed if the corresponding frame is not given.
+	 *
+	 * @param grid_frame Organized point cloud frame
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are kept
+	 * @param p_rgb_frame Pointer to RGB frame with the same resolution used for the color channel, can be nullptr
+	 * @param p_gray_frame Pointer to grayscale frame with the same resolution used for the intensity channel, can be nullptr
+	 */
+	void fromGridFrame(const GridFrame& grid_frame, const MaskFrame& mask_frame, std::shared_ptr<const RGBFrame> p_rgb_frame = nullptr, std::shared_ptr<const GrayFrame> p_gray_frame = nullptr);
+
+	/*!
+	 * @brief Writes the masked points of an organized point cloud into the buffer starting at an offset, without resizing.
+	 *
+	 * The buffer must already hold at least offset + PointCloudBuffer::countMasked(mask_frame) points. Channels are filled
+	 * as in PointCloudBuffer::fromGridFrame, except the source tag channel, which is left unchanged.
+	 *
+	 * @param offset Index of the first point to write
+	 * @param grid_frame Organized point cloud frame
+	 * @param mask_frame Boolean mask selecting which points of the organized point cloud are kept
+	 * @param p_rgb_frame Pointer to RGB frame with the same resolution used for the color channel, can be nullptr
+	 * @param p_gray_frame Pointer to grayscale frame with the same resolution used for the intensity channel, can be nullptr
+	 * @param num_threads Maximum number of threads to split rows across, 0 means use all hardware threads
+	 * @return Number of points written
+	 */
+	size_t writeGridFrame(size_t offset, const GridFrame& grid_frame, const MaskFrame& mask_frame, std::shared_ptr<const RGBFrame> p_rgb_frame = nullptr, std::shared_ptr<const GrayFrame> p_gray_frame = nullptr, unsigned int num_threads = 0);
+
+	/*!
+	 * @brief Applies a rigid or affine 4x4 transform in place to a range of points using vectorized Eigen array operations.
+	 *
+	 * @param transform 4x4 homogeneous transform applied to each point
+	 * @param begin Index of the first point to transform
+	 * @param end One past the index of the last point to transform
+	 */
+	void transform(const Eigen::Matrix4f& transform, size_t begin, size_t end);
+
+	/*!
+	 * @brief Sets the source sensor tag of a range of points.
+	 *
+	 * @param tag Source sensor tag
+	 * @param begin Index of the first point to tag
+	 * @param end One past the index of the last point to tag
+	 */
+	void setSourceTag(uint16_t tag, size_t begin, size_t end);
+
+	/*!
+	 * @brief Opt-in adapter that converts the buffer to an Open3D PointCloud.
+	 *
+	 * Colors are converted to the [0, 1] range expected by Open3D.
+	 *
+	 * @param pcd Handle to Open3D PointCloud object to be cleared and populated with the buffer's points and colors
+	 */
+	void toOpen3D(open3d::geometry::PointCloud& pcd) const;
+};
+
+#endif // POINTCLOUDBUFFER_H
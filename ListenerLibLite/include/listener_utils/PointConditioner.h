@@ -0,0 +1,76 @@
+#ifndef POINTCONDITIONER_H
+#define POINTCONDITIONER_H
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ * @brief Container for the declarative steps applied by a PointConditioner, in the order they are applied.
+ *
+ * m_decimation: Keep only every n-th input point, 1 keeps all points
+ * m_axisOrder and m_axisSigns: Output axis k is m_axisSigns[k] times input axis m_axisOrder[k]
+ * m_boxMin and m_boxMax: Keep only points strictly inside the axis-aligned box, in output axes
+ * m_minRange and m_maxRange: Keep only points whose distance to the origin is within the range, 0 disables the maximum
+ * m_removeDuplicates and m_duplicateResolution: Keep only the first point per cubic cell of the given side, or per exact
+ *                                               coordinates if the resolution is 0
+ */
+struct ConditionerParameters
+{
+	int m_decimation = 1;
+
+	std::array<int, 3> m_axisOrder = {0, 1, 2};
+	std::array<float, 3> m_axisSigns = {1.0f, 1.0f, 1.0f};
+
+	std::array<float, 3> m_boxMin = {-std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()};
+	std::array<float, 3> m_boxMax = {std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()};
+
+	float m_minRange = 0.0f;
+	float m_maxRange = 0.0f;
+
+	bool m_removeDuplicates = false;
+	float m_duplicateResolution = 0.0f;
+};
+
+/*!
+ * @brief Engine that conditions an unorganized point buffer in place according to a set of ConditionerParameters.
+ *
+ * All steps are fused into a single pass that reads each point once, applies the axis permutation, gates, and duplicate
+ * check, and compacts surviving points towards the front of the same buffer. Duplicates are found with an open
+ * addressing table of output indices keyed on quantized or exact coordinates, allocated once per call.
+ */
+class PointConditioner
+{
+	const ConditionerParameters m_params;
+
+public:
+
+	/*!
+	 * @brief Constructor method to set the conditioning steps.
+	 *
+	 * @param params Decimation, axis permutation and signs, box and range gates, and duplicate removal settings
+	 */
+	explicit PointConditioner(const ConditionerParameters& params = ConditionerParameters());
+
+	/*!
+	 * @brief Getter for the conditioning steps.
+	 *
+	 * @return Reference to the conditioning steps
+	 */
+	const ConditionerParameters& getParams() const;
+
+	/*!
+	 * @brief Conditions a buffer of interleaved (x, y, z) points in place.
+	 *
+	 * @tparam T Floating point type of the coordinates, float or double
+	 * @param p_xyz Pointer to the first of num_points contiguous coordinate triplets
+	 * @param num_points Number of points in the buffer
+	 * @param p_source_indices Optional pointer to room for num_points values receiving the input index of each kept point
+	 * @return Number of points kept, which now occupy the front of the buffer in their original order
+	 */
+	template <typename T>
+	size_t apply(T* p_xyz, size_t num_points, uint32_t* p_source_indices = nullptr) const;
+};
+
+#endif // POINTCONDITIONER_H
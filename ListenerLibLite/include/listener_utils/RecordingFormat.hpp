@@ -0,0 +1,106 @@
+#ifndef RECORDINGFORMAT_HPP
+#define RECORDINGFORMAT_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/*!
+ * @brief On-disk layout of the append-only recording container written by RecordingWriter and read by RecordingReader.
+ *
+ * A recording is a single little-endian file made of:
+ * - A FileHeader, followed by the stream's 3x3 intrinsic matrix, 4x4 extrinsic matrix, and distortion coefficients as
+ *   row-major float32 values, padded to the chunk alignment
+ * - One chunk per data frame, made of a ChunkHeader and the data frame's raw tensor in its in-memory column-major order,
+ *   each padded to the chunk alignment so that mapped payloads are aligned for any scalar type
+ * - A footer index of one IndexEntry per chunk, followed by a Trailer at the very end of the file
+ *
+ * A file without a valid Trailer, such as one whose writer was interrupted, is still readable by scanning its chunks.
+ */
+namespace recording_format
+{
+    constexpr char fileMagic[8] = {'L', 'L', 'R', 'E', 'C', 'O', 'R', 'D'};
+    constexpr char trailerMagic[8] = {'L', 'L', 'R', 'E', 'C', 'I', 'D', 'X'};
+    constexpr uint32_t chunkMagic = 0x4b4e4843u;
+    constexpr uint32_t formatVersion = 1;
+    constexpr size_t alignment = 64;
+
+    /*!
+     * @brief Identifier for the scalar type of a chunk's tensor.
+     */
+    enum class ScalarType : uint8_t
+    {
+        FLOAT32 = 0,
+        UINT8 = 1,
+        BOOL = 2
+    };
+
+    struct FileHeader
+    {
+        char m_magic[8];
+        uint32_t m_version;
+        uint32_t m_numDistortion;
+        uint64_t m_dataOffset;
+    };
+
+    struct ChunkHeader
+    {
+        uint32_t m_magic;
+        uint8_t m_frameID;
+        uint8_t m_scalarType;
+        uint16_t m_reserved;
+        uint32_t m_frameNumber;
+        int32_t m_rows;
+        int32_t m_cols;
+        int32_t m_channels;
+        int64_t m_timestamp;
+        uint64_t m_payloadSize;
+        uint64_t m_reservedTail;
+    };
+
+    struct IndexEntry
+    {
+        uint32_t m_frameNumber;
+        uint8_t m_frameID;
+        uint8_t m_scalarType;
+        uint16_t m_reserved;
+        int64_t m_timestamp;
+        uint64_t m_chunkOffset;
+    };
+
+    struct Trailer
+    {
+        uint64_t m_numEntries;
+        uint64_t m_indexOffset;
+        char m_magic[8];
+    };
+
+    static_assert(sizeof(FileHeader) == 24, "Unexpected recording file header size.");
+    static_assert(sizeof(ChunkHeader) == 48, "Unexpected recording chunk header size.");
+    static_assert(sizeof(IndexEntry) == 24, "Unexpected recording index entry size.");
+    static_assert(sizeof(Trailer) == 24, "Unexpected recording trailer size.");
+    static_assert(sizeof(bool) == 1, "Boolean tensors are recorded as one byte per value.");
+
+    /*!
+     * @brief Helper function to round a file offset up to the chunk alignment.
+     *
+     * @param offset Byte offset in the file
+     * @return Smallest aligned offset not before the given offset
+     */
+    inline uint64_t alignUp(const uint64_t offset)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /*!
+     * @brief Helper function to get the byte size of a scalar type.
+     *
+     * @param type Scalar type identifier
+     * @return Size in bytes of one value
+     */
+    inline size_t scalarSize(const ScalarType type)
+    {
+        return type == ScalarType::FLOAT32 ? 4 : 1;
+    }
+}
+
+#endif // RECORDINGFORMAT_HPP
@@ -0,0 +1,144 @@
+#ifndef RECORDINGREADER_H
+#define RECORDINGREADER_H
+
+struct CamParameters;
+class GenericDataFrame;
+
+#include <array>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+#include <Eigen/Dense>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/RecordingFormat.hpp"
+
+/*!
+ * @brief Memory-mapped reader for the recording container described in recording_format.
+ *
+ * The footer index is read once on construction, or rebuilt by scanning the chunks if the recording was not closed, and
+ * grouped into CompositeFrame records sorted by frame number, so any data frame of any frame is found in O(1). Data
+ * frames are created by copying their payload straight from the mapped file into a new tensor. Reads are const and can be
+ * made from several threads at once.
+ */
+class RecordingReader
+{
+	static constexpr size_t numFrameIDs = 6;
+
+	struct FrameRecord
+	{
+		unsigned int m_frameNumber;
+		std::chrono::microseconds m_timestamp;
+		std::array<int64_t, numFrameIDs> m_chunkOffsets;
+	};
+
+	const MappedFile m_file;
+
+	std::shared_ptr<CamParameters> m_camParamsPtr;
+	std::shared_ptr<Eigen::Matrix4f> m_extrinsicPtr;
+	std::vector<FrameRecord> m_frames;
+	std::vector<FrameID> m_frameIDs;
+	bool m_indexed = false;
+
+	void readHeader();
+
+	void readIndex(std::vector<recording_format::IndexEntry>& entries) const;
+
+	void scanChunks(std::vector<recording_format::IndexEntry>& entries) const;
+
+public:
+
+	/*!
+	 * @brief Constructor method to map a recording and index its frames.
+	 *
+	 * @param file_path Path to the recording file
+	 */
+	explicit RecordingReader(const std::string& file_path);
+
+	/*!
+	 * @brief Checks whether a path refers to a recording container by its extension.
+	 *
+	 * @param file_path Path to check
+	 * @return true if the path is an existing regular file with the recording extension, false if not
+	 */
+	static bool isRecording(const std::string& file_path);
+
+	/*!
+	 * @brief Getter for the camera parameters stored once for the recorded stream.
+	 *
+	 * @return Pointer to a new container for the intrinsic matrix and distortion coefficients of the recorded sensor
+	 */
+	std::shared_ptr<CamParameters> getCamParams() const;
+
+	/*!
+	 * @brief Getter for the extrinsic matrix stored once for the recorded stream.
+	 *
+	 * @return Pointer to a new 4x4 extrinsic matrix of the recorded sensor relative to its identity sensor
+	 */
+	std::shared_ptr<Eigen::Matrix4f> getExtrinsic() const;
+
+	/*!
+	 * @brief Getter for whether the footer index was read, rather than rebuilt from an unclosed recording.
+	 *
+	 * @return true if the recording was closed and its footer index used, false if chunks were scanned
+	 */
+	bool isIndexed() const;
+
+	/*!
+	 * @brief Getter for the number of CompositeFrames in the recording.
+	 *
+	 * @return Number of distinct frame numbers
+	 */
+	size_t getNumFrames() const;
+
+	/*!
+	 * @brief Getter for the types of data frames found in the recording.
+	 *
+	 * @return Vector of FrameIDs present in at least one frame, in FrameID order
+	 */
+	const std::vector<FrameID>& getFrameIDs() const;
+
+	/*!
+	 * @brief Getter for the frame number a CompositeFrame was recorded with.
+	 *
+	 * @param index Position of the frame in the recording, from 0 to getNumFrames() - 1
+	 * @return Recorded frame number
+	 */
+	unsigned int getFrameNumber(size_t index) const;
+
+	/*!
+	 * @brief Getter for the timestamp a CompositeFrame was recorded with.
+	 *
+	 * @param index Position of the frame in the recording, from 0 to getNumFrames() - 1
+	 * @return Epoch time in microseconds at which the frame was received by the sensor
+	 */
+	std::chrono::microseconds getTimestamp(size_t index) const;
+
+	/*!
+	 * @brief Checks whether a CompositeFrame of the recording contains a data frame of a certain type.
+	 *
+	 * @param index Position of the frame in the recording, from 0 to getNumFrames() - 1
+	 * @param frame_id Type of data frame to check for
+	 * @return true if the data frame was recorded, false if not
+	 */
+	bool has(size_t index, FrameID frame_id) const;
+
+	/*!
+	 * @brief Creates a data frame from its recorded chunk.
+	 *
+	 * The data frame's loaded timestamp is set to the recorded timestamp, which a CompositeFrame adopts when it is added.
+	 *
+	 * @param index Position of the frame in the recording, from 0 to getNumFrames() - 1
+	 * @param frame_id Type of data frame to read
+	 * @param p_cam_params Pointer to container for intrinsic matrix and distortion coefficients given to the data frame
+	 * @param p_extrinsic Pointer to the 4x4 extrinsic matrix given to the data frame
+	 * @return Pointer to the GenericDataFrame subclass matching the FrameID
+	 */
+	std::shared_ptr<GenericDataFrame> readFrame(size_t index, FrameID frame_id, std::shared_ptr<CamParameters> p_cam_params, std::shared_ptr<Eigen::Matrix4f> p_extrinsic) const;
+};
+
+#endif // RECORDINGREADER_H
@@ -0,0 +1,96 @@
+#ifndef RECORDINGWRITER_H
+#define RECORDINGWRITER_H
+
+struct CamParameters;
+class GenericDataFrame;
+class CompositeFrame;
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <fstream>
+#include <cstdint>
+
+#include <Eigen/Dense>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/RecordingFormat.hpp"
+
+/*!
+ * @brief Writer for the single-file, append-only recording container described in recording_format.
+ *
+ * The stream's camera parameters and extrinsic matrix are written once in the file header, and every appended data frame
+ * is written as one chunk tagged with its FrameID, frame number, and timestamp. The footer index is written when the
+ * writer is closed, replacing the per-frame directories of CompositeFrame::saveAll with a single file that can be
+ * mapped and seeked in O(1). Reopening an existing recording in append mode drops its footer and continues after its last
+ * chunk, and requires the same stream parameters as the recording. Appends are serialized, so one writer can be shared by several threads.
+ */
+class RecordingWriter
+{
+	std::ofstream m_file;
+	uint64_t m_offset = 0;
+	std::vector<recording_format::IndexEntry> m_index;
+	bool m_closed = false;
+	std::mutex m_mutex;
+
+	void writePadding(uint64_t aligned_offset);
+
+public:
+
+	/*!
+	 * @brief File extension of recording containers.
+	 */
+	static constexpr const char* fileExtension = ".lrec";
+
+	/*!
+	 * @brief Constructor method that creates a recording, or reopens one to append frames to it.
+	 *
+	 * @param file_path Path to the recording file
+	 * @param p_cam_params Pointer to container for intrinsic matrix and distortion coefficients of the recorded sensor
+	 * @param p_extrinsic Pointer to the 4x4 extrinsic matrix of the recorded sensor relative to its identity sensor
+	 * @param append true to append to an existing recording at the path, which throws if its stream parameters differ, false to overwrite
+	 */
+	RecordingWriter(const std::string& file_path, std::shared_ptr<CamParameters> p_cam_params, std::shared_ptr<Eigen::Matrix4f> p_extrinsic, bool append = false);
+
+	/*!
+	 * @brief Destructor method that closes the recording.
+	 */
+	~RecordingWriter();
+
+	RecordingWriter(const RecordingWriter&) = delete;
+	RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+	/*!
+	 * @brief Appends one data frame to the recording.
+	 *
+	 * @param frame_number Number of the CompositeFrame the data frame belongs to
+	 * @param timestamp Epoch time in microseconds at which the CompositeFrame was received by the sensor
+	 * @param frame_id Type of the data frame
+	 * @param data_frame Data frame to write
+	 */
+	void append(unsigned int frame_number, const std::chrono::microseconds& timestamp, FrameID frame_id, const GenericDataFrame& data_frame);
+
+	/*!
+	 * @brief Appends all data frames of a CompositeFrame to the recording.
+	 *
+	 * @param frame_number Number of the CompositeFrame
+	 * @param composite_frame CompositeFrame to write
+	 */
+	void append(unsigned int frame_number, const CompositeFrame& composite_frame);
+
+	/*!
+	 * @brief Getter for the number of chunks written so far.
+	 *
+	 * @return Number of data frames in the recording
+	 */
+	size_t getNumChunks();
+
+	/*!
+	 * @brief Writes the footer index and closes the file. Further appends throw.
+	 */
+	void close();
+};
+
+#endif // RECORDINGWRITER_H
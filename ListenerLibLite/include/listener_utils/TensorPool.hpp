@@ -0,0 +1,118 @@
+#ifndef TENSORPOOL_HPP
+#define TENSORPOOL_HPP
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+namespace listener_utils
+{
+    /*!
+     * @brief Pool of equally sized tensors that are handed out as shared pointers and come back when the last one is released.
+     *
+     * Each acquired tensor's shared pointer carries a deleter that returns the tensor to the pool's free list instead of
+     * freeing it, so a tensor is reused exactly when every frame holding it has been released, on whichever thread that
+     * happens. The free list is shared with those deleters, so tensors released after the pool is destroyed, or after it
+     * switched to another size, are simply freed. At most the pool's capacity of free tensors is kept.
+     *
+     * @tparam T Scalar type of the pooled tensors
+     */
+    template <typename T>
+    class TensorPool
+    {
+        struct FreeList
+        {
+            std::mutex m_mutex;
+            std::vector<std::unique_ptr<Eigen::Tensor<T, 3>>> m_tensors;
+            size_t m_capacity = 0;
+            Eigen::Index m_rows = 0;
+            Eigen::Index m_cols = 0;
+            Eigen::Index m_channels = 0;
+        };
+
+        std::shared_ptr<FreeList> m_freeListPtr;
+
+    public:
+
+        /*!
+         * @brief Constructor method to set the number of free tensors kept for reuse.
+         *
+         * @param capacity Maximum number of released tensors kept in the free list
+         */
+        explicit TensorPool(const size_t capacity)
+            : m_freeListPtr(std::make_shared<FreeList>())
+        {
+            m_freeListPtr->m_capacity = capacity;
+        }
+
+        /*!
+         * @brief Drops all free tensors, so that tensors in use are freed instead of reused when they are released.
+         */
+        void clear()
+        {
+            const std::lock_guard<std::mutex> lock(m_freeListPtr->m_mutex);
+            m_freeListPtr->m_tensors.clear();
+            m_freeListPtr->m_rows = 0;
+            m_freeListPtr->m_cols = 0;
+            m_freeListPtr->m_channels = 0;
+        }
+
+        /*!
+         * @brief Takes a free tensor of the requested size from the pool, allocating one if none is free.
+         *
+         * A size different from that of the previous call drops the free tensors of the old size. The contents of a reused
+         * tensor are those it was released with.
+         *
+         * @param rows Number of rows of the tensor
+         * @param cols Number of columns of the tensor
+         * @param channels Number of channels of the tensor
+         * @return Pointer to a tensor that returns to the pool when its last owner releases it
+         */
+        std::shared_ptr<Eigen::Tensor<T, 3>> acquire(const Eigen::Index rows, const Eigen::Index cols, const Eigen::Index channels)
+        {
+            std::unique_ptr<Eigen::Tensor<T, 3>> p_tensor;
+            {
+                const std::lock_guard<std::mutex> lock(m_freeListPtr->m_mutex);
+                FreeList& free_list = *m_freeListPtr;
+                if (free_list.m_rows != rows || free_list.m_cols != cols || free_list.m_channels != channels)
+                {
+                    free_list.m_tensors.clear();
+                    free_list.m_rows = rows;
+                    free_list.m_cols = cols;
+                    free_list.m_channels = channels;
+                }
+                else if (!free_list.m_tensors.empty())
+                {
+                    p_tensor = std::move(free_list.m_tensors.back());
+                    free_list.m_tensors.pop_back();
+                }
+            }
+            if (p_tensor == nullptr)
+            {
+                p_tensor = std::make_unique<Eigen::Tensor<T, 3>>(rows, cols, channels);
+            }
+
+            const std::weak_ptr<FreeList> p_weak_free_list = m_freeListPtr;
+            return std::shared_ptr<Eigen::Tensor<T, 3>>(p_tensor.release(), [p_weak_free_list](Eigen::Tensor<T, 3>* p_released)
+            {
+                std::unique_ptr<Eigen::Tensor<T, 3>> p_owned(p_released);
+                const std::shared_ptr<FreeList> p_free_list = p_weak_free_list.lock();
+                if (p_free_list == nullptr)
+                {
+                    return;
+                }
+                const std::lock_guard<std::mutex> lock(p_free_list->m_mutex);
+                if (p_free_list->m_tensors.size() < p_free_list->m_capacity && p_owned->dimension(0) == p_free_list->m_rows &&
+                    p_owned->dimension(1) == p_free_list->m_cols && p_owned->dimension(2) == p_free_list->m_channels)
+                {
+                    p_free_list->m_tensors.push_back(std::move(p_owned));
+                }
+            });
+        }
+    };
+}
+
+#endif // TENSORPOOL_HPP
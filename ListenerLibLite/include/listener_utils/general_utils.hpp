@@ -45,7 +45,8 @@ enum class FrameID
     GRAYSCALE_IMAGE,
     RGB_IMAGE,
     TEMPERATURE_GRID,
-    POINTCLOUD_MASK
+    POINTCLOUD_MASK,
+    NORMAL_GRID
 };
 
 namespace FrameIDUtils
@@ -62,7 +63,8 @@ namespace FrameIDUtils
             {FrameID::GRAYSCALE_IMAGE, "imgGray"},
             {FrameID::RGB_IMAGE, "imgRGB"},
             {FrameID::TEMPERATURE_GRID, "tempGrid"},
-            {FrameID::POINTCLOUD_MASK, "imgDepthMask"}
+            {FrameID::POINTCLOUD_MASK, "imgDepthMask"},
+            {FrameID::NORMAL_GRID, "normGrid"}
         };
         if (frameStringMap.find(frame_id) == frameStringMap.end()) {
             throw std::runtime_error("Tried to covert invalid FrameID to string.");
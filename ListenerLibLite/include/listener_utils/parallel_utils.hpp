@@ -0,0 +1,232 @@
+#ifndef PARALLELUTILS_HPP
+#define PARALLELUTILS_HPP
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+namespace listener_utils
+{
+    /*!
+     * @brief Helper function to resolve the number of worker threads to use for a parallel operation.
+     *
+     * @param num_threads Requested number of threads, 0 means use all hardware threads
+     * @return Number of threads to use, always at least 1
+     */
+    inline unsigned int getNumThreads(const unsigned int num_threads = 0)
+    {
+        if (num_threads > 0)
+        {
+            return num_threads;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    namespace detail
+    {
+        /*!
+         * @brief One parallelFor call, split into chunks that the calling thread and pool workers claim in turn.
+         *
+         * The first exception thrown by a chunk is kept for the caller, and chunks claimed after it are skipped.
+         */
+        class ParallelJob
+        {
+            const std::function<void(int, int)>& m_func;
+            const int m_begin;
+            const int m_end;
+            const int m_chunkSize;
+            const int m_numChunks;
+
+            std::atomic<int> m_nextChunk = 0;
+            std::atomic<int> m_numDone = 0;
+            std::atomic<bool> m_failed = false;
+
+            std::mutex m_mutex;
+            std::condition_variable m_doneCondition;
+            std::exception_ptr m_exception;
+
+        public:
+
+            ParallelJob(const std::function<void(int, int)>& func, const int begin, const int end, const int num_chunks)
+                : m_func(func), m_begin(begin), m_end(end), m_chunkSize((end - begin + num_chunks - 1) / num_chunks), m_numChunks(num_chunks)
+            {
+            }
+
+            bool runChunk()
+            {
+                const int chunk = m_nextChunk.fetch_add(1);
+                if (chunk >= m_numChunks)
+                {
+                    return false;
+                }
+                const int chunk_begin = std::min(m_end, m_begin + chunk * m_chunkSize);
+                const int chunk_end = std::min(m_end, chunk_begin + m_chunkSize);
+                if (chunk_begin < chunk_end && !m_failed.load())
+                {
+                    try
+                    {
+                        m_func(chunk_begin, chunk_end);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if (m_exception == nullptr)
+                        {
+                            m_exception = std::current_exception();
+                        }
+                        m_failed.store(true);
+                    }
+                }
+                if (m_numDone.fetch_add(1) + 1 == m_numChunks)
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_doneCondition.notify_all();
+                }
+                return true;
+            }
+
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_doneCondition.wait(lock, [this]() { return m_numDone.load() == m_numChunks; });
+                if (m_exception != nullptr)
+                {
+                    std::rethrow_exception(m_exception);
+                }
+            }
+        };
+
+        /*!
+         * @brief Process-wide pool of persistent workers shared by every parallelFor call.
+         *
+         * Workers help with the oldest queued job until its chunks are all claimed. Since the calling thread claims chunks of
+         * its own job as well, nested and concurrent calls always make progress, even when every worker is busy.
+         */
+        class ThreadPool
+        {
+            std::vector<std::thread> m_workers;
+            std::deque<std::shared_ptr<ParallelJob>> m_jobs;
+            std::mutex m_mutex;
+            std::condition_variable m_jobCondition;
+            bool m_stopping = false;
+
+            void workerLoop()
+            {
+                while (true)
+                {
+                    std::shared_ptr<ParallelJob> p_job;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_jobCondition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+                        if (m_jobs.empty())
+                        {
+                            return;
+                        }
+                        p_job = m_jobs.front();
+                    }
+                    if (!p_job->runChunk())
+                    {
+                        remove(p_job);
+                    }
+                }
+            }
+
+        public:
+
+            explicit ThreadPool(const unsigned int num_workers)
+            {
+                m_workers.reserve(num_workers);
+                for (unsigned int t = 0; t < num_workers; ++t)
+                {
+                    m_workers.emplace_back(&ThreadPool::workerLoop, this);
+                }
+            }
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stopping = true;
+                }
+                m_jobCondition.notify_all();
+                for (auto& worker : m_workers)
+                {
+                    worker.join();
+                }
+            }
+
+            void submit(const std::shared_ptr<ParallelJob>& p_job)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_jobs.push_back(p_job);
+                }
+                m_jobCondition.notify_all();
+            }
+
+            void remove(const std::shared_ptr<ParallelJob>& p_job)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                const auto it = std::find(m_jobs.begin(), m_jobs.end(), p_job);
+                if (it != m_jobs.end())
+                {
+                    m_jobs.erase(it);
+                }
+            }
+
+            static ThreadPool& instance()
+            {
+                static ThreadPool pool(getNumThreads() - 1);
+                return pool;
+            }
+        };
+    }
+
+    /*!
+     * @brief Helper function to split an index range into contiguous chunks and process them in parallel.
+     *
+     * Chunks run on the calling thread and on a persistent process-wide pool of hardware_concurrency - 1 workers, so no
+     * threads are started per call and concurrent or nested calls share the same workers. The function returns once all
+     * chunks are processed. Ranges smaller than the minimum chunk size are processed entirely on the calling thread. The
+     * first exception thrown by a chunk is rethrown on the calling thread after the other claimed chunks finish.
+     *
+     * @param begin First index of the range
+     * @param end One past the last index of the range
+     * @param func Callable taking the first and one past the last index of a chunk
+     * @param num_threads Maximum number of threads to use, 0 means use all hardware threads
+     * @param min_chunk Minimum number of indices processed by each thread
+     */
+    inline void parallelFor(const int begin, const int end, const std::function<void(int, int)>& func, const unsigned int num_threads = 0, const int min_chunk = 16)
+    {
+        const int length = end - begin;
+        if (length <= 0)
+        {
+            return;
+        }
+        const int max_chunks = std::max(1, length / std::max(1, min_chunk));
+        const int num_chunks = std::min(static_cast<int>(getNumThreads(num_threads)), max_chunks);
+        if (num_chunks == 1)
+        {
+            func(begin, end);
+            return;
+        }
+
+        detail::ThreadPool& pool = detail::ThreadPool::instance();
+        const auto p_job = std::make_shared<detail::ParallelJob>(func, begin, end, num_chunks);
+        pool.submit(p_job);
+        while (p_job->runChunk())
+        {
+        }
+        pool.remove(p_job);
+        p_job->wait();
+    }
+}
+
+#endif // PARALLELUTILS_HPP
@@ -0,0 +1,26 @@
+#ifndef TENSORUTILS_HPP
+#define TENSORUTILS_HPP
+
+#include <cstddef>
+
+namespace listener_utils
+{
+    /*!
+     * @brief Helper function for the offset of a pixel within one channel plane of a frame tensor.
+     *
+     * Frame data is stored in column-major Eigen::Tensor<T, 3> tensors of (rows, cols, channels), so each channel is a
+     * contiguous plane of rows * cols values running down the columns, and channel k of a pixel is found at
+     * planeIndex(row, col, rows) + k * rows * cols. The same layout is used by planar images and Fortran-ordered arrays.
+     *
+     * @param row Row of the pixel
+     * @param col Column of the pixel
+     * @param rows Number of rows in the tensor
+     * @return Offset of the pixel from the start of its channel plane
+     */
+    inline size_t planeIndex(const size_t row, const size_t col, const size_t rows)
+    {
+        return row + rows * col;
+    }
+}
+
+#endif // TENSORUTILS_HPP
@@ -10,7 +10,8 @@ struct CamParameters;
 /*!
  * @brief Object that contains information about a connected or hypothetical Movia sensor.
  * 
- * Inherits ScanningLidarInterface
+ * Inherits ScanningLidarInterface. Configures point conditioning to reformat the axes of unorganized Movia point clouds
+ * loaded from file, remove duplicate points, and keep depths between 0.2 and 84 meters.
  */
 class NASAMoviaInterface final : public ScanningLidarInterface
 {
@@ -28,13 +29,6 @@ public:
 	 * @param apply_processing true if data point cloud data should be cropped and processed, false if not
 	 */
 	explicit NASAMoviaInterface(int mode = 2, int framerate = 2, bool apply_processing = true);
-
-	/*!
-	 * @brief Method to reformat axes of unorganized Movia point clouds loaded from file.
-	 *
-	 * @param pcd Reference to Open3D PointCloud object that will be modified.
-	 */
-	void pcdConditioner(open3d::geometry::PointCloud& pcd) const override;
 };
 
 #endif // MOVIAINTERFACE_H
\ No newline at end of file
@@ -2,11 +2,19 @@
 #define SCANNINGLIDARINTERFACE_H
 
 struct CamParameters;
+class DepthHoleFiller;
+class ProjectionLut;
 
+#include <string>
+#include <vector>
 #include <unordered_map>
 #include <memory>
+#include <cstdint>
+
+#include <Eigen/Dense>
 
 #include "listener_utils/general_utils.hpp"
+#include "listener_utils/PointConditioner.h"
 #include "sensor_interfaces/SensorInterface.h"
 
 /*!
@@ -19,12 +27,24 @@ class ScanningLidarInterface : public SensorInterface
     const float m_crop_ratio;
     const float m_asp_ratio;
 
+    std::shared_ptr<const DepthHoleFiller> m_holeFillerPtr;
+
+    mutable std::shared_ptr<ProjectionLut> m_projectionLutPtr;
+
 protected:
 
     static const std::unordered_map<int, std::unordered_map<std::string, float>> modeMap;
 
     std::unordered_map<std::string, float> m_propertyMap;
 
+    ConditionerParameters m_conditionerParams;
+
+    bool m_useProjectionLut = false;
+
+    size_t m_numBeams = 0;
+
+    std::string m_beamIDProperty;
+
 public:
     /*!
      * @brief Constructor method.
@@ -45,6 +65,22 @@ public:
      */
     int getFilterSize() const;
 
+    /*!
+     * @brief Setter for the hole filling engine used instead of the floor median filter when organizing point cloud.
+     *
+     * The hole filler runs whenever one is set, even if processing is disabled and no median filter would be applied.
+     *
+     * @param p_hole_filler Pointer to configured DepthHoleFiller, nullptr to use the floor median filter
+     */
+    void setHoleFiller(std::shared_ptr<const DepthHoleFiller> p_hole_filler);
+
+    /*!
+     * @brief Getter for the hole filling engine used when organizing point cloud.
+     *
+     * @return Pointer to configured DepthHoleFiller, nullptr if the floor median filter is used
+     */
+    std::shared_ptr<const DepthHoleFiller> getHoleFiller() const;
+
     /*!
      * @brief Overrides SensorInterface::getDefaultCamParams.
      *
@@ -53,7 +89,81 @@ public:
     std::shared_ptr<CamParameters> getDefaultCamParams() const override;
 
     /*!
-     * @brief Dummy method to condition unorganized point cloud from file, shadow in subclasses for custom behavior.
+     * @brief Getter for the conditioning steps applied to unorganized point clouds loaded from file.
+     *
+     * @return Reference to the conditioning steps configured by the sensor subclass or user
+     */
+    const ConditionerParameters& getConditionerParams() const;
+
+    /*!
+     * @brief Setter for the conditioning steps applied to unorganized point clouds loaded from file.
+     *
+     * @param params Decimation, axis permutation and signs, box and range gates, and duplicate removal settings
+     */
+    void setConditionerParams(const ConditionerParameters& params);
+
+    /*!
+     * @brief Conditions an unorganized point buffer from file in place with one fused pass of the configured steps.
+     *
+     * @param points Reference to vector of interleaved (x, y, z) coordinates that will be conditioned and shrunk
+     */
+    void conditionPoints(std::vector<float>& points) const;
+
+    /*!
+     * @brief Conditions an unorganized point buffer from file in place and records which input point each kept point was.
+     *
+     * @param points Reference to vector of interleaved (x, y, z) coordinates that will be conditioned and shrunk
+     * @param source_indices Reference to vector that will hold the input index of each kept point
+     */
+    void conditionPoints(std::vector<float>& points, std::vector<uint32_t>& source_indices) const;
+
+    /*!
+     * @brief Getter for whether organized grids are built with a cached per-beam projection lookup table.
+     *
+     * @return true if point clouds carrying beam IDs are organized through a cached projection, false if every point is projected
+     */
+    bool getUseProjectionLut() const;
+
+    /*!
+     * @brief Setter for whether organized grids are built with a cached per-beam projection lookup table, disabled by default.
+     *
+     * Only binary PLY files whose vertices carry the driver's fixed channel or scan step ID of each point use the table,
+     * other point clouds, including ASCII PLY files parsed by Open3D, are projected point by point. Each ID must always
+     * be measured along the same direction, since a beam's pixel is stored on its first return and each beam is only
+     * checked against the direct projection once every 64 frames afterwards. Drivers whose beam directions vary between
+     * frames must keep the table disabled.
+     *
+     * @param use_projection_lut true to cache the projection of each beam, false to project every point
+     * @param num_beams Number of distinct beam IDs reported by the sensor driver, required if enabled
+     * @param beam_id_property Name of the PLY vertex property holding the beam ID of each point
+     */
+    void setUseProjectionLut(bool use_projection_lut, size_t num_beams = 0, const std::string& beam_id_property = "beam_id");
+
+    /*!
+     * @brief Getter for the name of the PLY vertex property holding the beam ID of each point.
+     *
+     * @return Reference to the property name set with ScanningLidarInterface::setUseProjectionLut
+     */
+    const std::string& getBeamIDProperty() const;
+
+    /*!
+     * @brief Getter for the cached projection lookup table of this sensor's scan pattern.
+     *
+     * The table is kept per interface, and so per mode, and is only replaced when the projection model or grid resolution
+     * differs from the cached one.
+     *
+     * @param intrinsic 3x3 pinhole intrinsic matrix of the organized grid
+     * @param rows Number of rows in the organized grid
+     * @param cols Number of columns in the organized grid
+     * @return Pointer to the matching ProjectionLut, nullptr if lookup tables are disabled
+     */
+    std::shared_ptr<ProjectionLut> getProjectionLut(const Eigen::Matrix3f& intrinsic, int rows, int cols) const;
+
+    /*!
+     * @brief Method to condition unorganized Open3D point cloud with the configured steps.
+     *
+     * Sensor subclasses should configure m_conditionerParams rather than override this method, since GridFrame loading
+     * conditions points through ScanningLidarInterface::conditionPoints.
      *
      * @param pcd Reference to Open3D PointCloud object that will be modified
      */
@@ -18,17 +18,34 @@
 #include "listener_frames/CompositeFrame.h"
 #include "listener_frames/GenericDataFrame.h"
 #include "listener_utils/ListenerDisplayManager.h"
+#include "listener_utils/AsyncFrameWriter.h"
+#include "listener_processing/ProcessingStage.h"
 
 std::set<std::string> GenericListener::activeSensors;
 
 void GenericListener::addToQueue(std::shared_ptr<CompositeFrame> p_composite_frame)
 {
+	p_composite_frame->setSequenceNumber(m_nextSequenceNumber++);
+	{
+		std::lock_guard stage_lock(m_stageMutex);
+		for (const auto& p_stage : m_stageVec)
+		{
+			p_stage->process(*p_composite_frame);
+		}
+	}
+
 	std::lock_guard lock(m_queueMutex);
 	m_queue.push(p_composite_frame);
 	m_newFrame = true;
 	m_queueEvent.notify_one();
 }
 
+bool GenericListener::waitForQueueSpace(const size_t max_queued, const std::chrono::milliseconds& timeout)
+{
+	std::unique_lock<std::mutex> lock(m_queueMutex);
+	return m_queueSpaceEvent.wait_for(lock, timeout, [this, max_queued] { return m_queue.size() < max_queued; });
+}
+
 GenericListener::GenericListener(const std::string& name, const int framerate) : m_name(name), m_framerate(framerate)
 {
 	// Add sensor's name to the static list of sensor names, checking if a sensor with the name exists already
@@ -70,6 +87,18 @@ void GenericListener::setTimeoutDuration(const std::chrono::milliseconds& timeou
 	m_timeoutDuration = timeout_duration;
 }
 
+void GenericListener::addProcessingStage(const std::shared_ptr<ProcessingStage> p_stage)
+{
+	std::lock_guard lock(m_stageMutex);
+	m_stageVec.push_back(p_stage);
+}
+
+void GenericListener::clearProcessingStages()
+{
+	std::lock_guard lock(m_stageMutex);
+	m_stageVec.clear();
+}
+
 std::unique_ptr<std::map<std::string, std::string>> GenericListener::getSensorInfo() const
 {
 	return std::make_unique<std::map<std::string, std::string>>();
@@ -125,6 +154,7 @@ std::shared_ptr<CompositeFrame> GenericListener::getNextFrame()
 	// If frames in queue, get next frame in FIFO queue
 	std::shared_ptr<CompositeFrame> p_composite_frame = m_queue.front();
 	m_queue.pop();
+	m_queueSpaceEvent.notify_all();
 	return p_composite_frame;
 }
 
@@ -144,6 +174,7 @@ std::shared_ptr<CompositeFrame> GenericListener::getLatestFrame()
 		m_queue.pop();
 	}
 	m_newFrame = false;
+	m_queueSpaceEvent.notify_all();
 	return p_composite_frame;
 }
 
@@ -191,8 +222,9 @@ void GenericListener::displayStream()
 	stopStream();
 }
 
-void GenericListener::dumpStream(const std::string& dump_dir)
+void GenericListener::dumpStream(const std::string& dump_dir, const WriterParameters& writer_params)
 {
+	AsyncFrameWriter writer(dump_dir, writer_params);
 	unsigned int frame_number = 0;
 	startStream();
 	while (true)
@@ -200,7 +232,7 @@ void GenericListener::dumpStream(const std::string& dump_dir)
 		std::shared_ptr<CompositeFrame> p_composite_frame;
 		try
 		{
-			p_composite_frame = getLatestFrame();
+			p_composite_frame = getNextFrame();
 		}
 		catch (const std::runtime_error& e)
 		{
@@ -209,7 +241,13 @@ void GenericListener::dumpStream(const std::string& dump_dir)
 		}
 
 		++frame_number;
-		p_composite_frame->saveAll(dump_dir, frame_number);
+		writer.submit(p_composite_frame, frame_number);
 	}
 	stopStream();
+	writer.flush();
+
+	const WriterStatistics stats = writer.getStatistics();
+	std::cout << "Recorded " << stats.m_framesWritten << " of " << stats.m_framesSubmitted << " frames from " << m_name
+			  << " (" << stats.m_framesDropped << " dropped, " << stats.m_framesFailed << " failed with " << stats.m_writeErrors << " write errors, peak queue "
+			  << stats.m_peakQueuedFrames << ", blocked " << stats.m_blockedTime.count() / 1000 << " ms)" << std::endl;
 }
\ No newline at end of file
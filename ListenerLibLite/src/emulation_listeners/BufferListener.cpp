@@ -6,8 +6,6 @@
 #include <memory>
 #include <thread>
 #include <filesystem>
-#define _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
-#include <experimental/filesystem>
 
 #include <natural_sort.hpp>
 #include <unsupported/Eigen/CXX11/Tensor>
@@ -4,106 +4,652 @@
 #include <vector>
 #include <chrono>
 #include <memory>
+#include <limits>
 #include <thread>
 #include <iostream>
+#include <mutex>
+#include <exception>
+#include <algorithm>
+#include <stdexcept>
 #include <filesystem>
-#define _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
-#include <experimental/filesystem>
-
-#include <natural_sort.hpp>
 
 #include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/RecordingReader.h"
+#include "listener_utils/DatasetIndex.h"
 #include "listener_frames/GrayFrame.h"
 #include "listener_frames/RGBFrame.h"
 #include "listener_frames/GridFrame.h"
 #include "listener_frames/TempFrame.h"
 #include "listener_frames/MaskFrame.h"
+#include "listener_frames/NormalFrame.h"
 #include "listener_frames/CompositeFrame.h"
+#include "listener_frames/GenericDataFrame.h"
 #include "sensor_interfaces/SensorInterface.h"
 #include "abstract_listeners/ThreadListener.h"
 #include "abstract_listeners/SingleListener.h"
 
-SavedListener::SavedListener(std::vector<FrameID> frame_id_vec, const std::string& data_dir, std::shared_ptr<SensorInterface> p_sensor_interface, const std::string& name, const float resize_factor, const bool repeat)
-	: GenericListener(name, p_sensor_interface->getFramerate()), ThreadListener(name, p_sensor_interface->getFramerate()), SingleListener(p_sensor_interface, name, resize_factor, data_dir), m_repeat(repeat)
+SavedListener::SavedListener(std::vector<FrameID> frame_id_vec, const std::string& data_dir, std::shared_ptr<SensorInterface> p_sensor_interface, const std::string& name, const float resize_factor, const bool repeat, const PlaybackParameters& playback_params)
+	: GenericListener(name, p_sensor_interface->getFramerate()), ThreadListener(name, p_sensor_interface->getFramerate()), SingleListener(p_sensor_interface, name, resize_factor, data_dir), m_repeat(repeat), m_playbackParams(playback_params), m_paused(playback_params.m_startPaused)
 {
-	// Collect and store vectors of files for each desired frame type
-	bool covert_format = true;
+	if (m_playbackParams.m_prefetchFrames == 0)
+	{
+		throw std::runtime_error("Saved listener must prefetch at least one frame.");
+	}
+	if (m_playbackParams.m_speed <= 0.0f)
+	{
+		throw std::runtime_error("Saved listener playback speed must be positive.");
+	}
+	if (m_playbackParams.m_maxQueuedFrames == 0)
+	{
+		throw std::runtime_error("Saved listener must allow at least one queued frame.");
+	}
+	if (m_playbackParams.m_loop && m_repeat)
+	{
+		throw std::runtime_error("Saved listener cannot both loop and repeat its last frame.");
+	}
+
+	// Recording containers carry their own stream parameters and are indexed instead of listed
+	if (RecordingReader::isRecording(data_dir))
+	{
+		m_recordingPtr = std::make_unique<RecordingReader>(data_dir);
+		setCamParams(m_recordingPtr->getCamParams());
+		m_extrinsicPtr = m_recordingPtr->getExtrinsic();
+		const std::vector<FrameID>& recorded_ids = m_recordingPtr->getFrameIDs();
+		for (const auto& frame_id : frame_id_vec)
+		{
+			if (std::find(recorded_ids.begin(), recorded_ids.end(), frame_id) == recorded_ids.end())
+			{
+				throw std::runtime_error("Recording " + data_dir + " contains no " + FrameIDUtils::toString(frame_id) + " data.");
+			}
+		}
+		m_frameIDs = frame_id_vec.empty() ? recorded_ids : frame_id_vec;
+		m_numFiles = m_recordingPtr->getNumFrames();
+		if (m_numFiles == 0)
+		{
+			throw std::runtime_error("Recording " + data_dir + " contains no frames.");
+		}
+		setRange(m_playbackParams.m_beginFrame, m_playbackParams.m_endFrame);
+		return;
+	}
+
+	// Index the files of each desired frame type, reusing the dataset's cached index while its directories are unchanged
 	if (frame_id_vec.empty())
 	{
-		frame_id_vec.push_back(FrameID::POINTCLOUD_GRID);
-		covert_format = false;
+		// Raw point cloud files lie directly in the data directory, which is listed on every open
+		m_frameIDs = {FrameID::POINTCLOUD_GRID};
+		m_datasetIndexPtr = std::make_unique<DatasetIndex>(DatasetIndex::scan(data_dir, m_frameIDs, true));
+	}
+	else
+	{
+		m_frameIDs = frame_id_vec;
+		m_datasetIndexPtr = std::make_unique<DatasetIndex>(DatasetIndex::open(data_dir, m_frameIDs));
+	}
+	m_numFiles = m_datasetIndexPtr->getNumFrames();
+	if (m_numFiles == 0)
+	{
+		throw std::runtime_error("Saved data in " + data_dir + " contains no frames.");
+	}
+	if (m_playbackParams.m_timing == PlaybackTiming::RECORDED && !hasRecordedTimestamps())
+	{
+		std::cerr << "Saved data in " << data_dir << " has no recorded timestamps, replaying at fixed rate." << std::endl;
+	}
+	setRange(m_playbackParams.m_beginFrame, m_playbackParams.m_endFrame);
+}
+
+SavedListener::~SavedListener() = default;
+
+bool SavedListener::hasRecordedTimestamps() const
+{
+	return m_recordingPtr || m_datasetIndexPtr->hasTimestamps();
+}
+
+std::chrono::microseconds SavedListener::getRecordedTimestamp(const size_t index) const
+{
+	return m_recordingPtr ? m_recordingPtr->getTimestamp(index) : m_datasetIndexPtr->getTimestamp(index);
+}
+
+std::shared_ptr<GenericDataFrame> SavedListener::loadDataFrame(const size_t index, const FrameID frame_id) const
+{
+	if (m_recordingPtr)
+	{
+		return m_recordingPtr->readFrame(index, frame_id, m_camParamsPtr, m_extrinsicPtr);
+	}
+	const std::string file_path = m_datasetIndexPtr->getPath(index, frame_id);
+	std::shared_ptr<GenericDataFrame> p_data_frame;
+	if (frame_id == FrameID::GRAYSCALE_IMAGE)
+	{
+		p_data_frame = std::make_shared<GrayFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else if (frame_id == FrameID::RGB_IMAGE)
+	{
+		p_data_frame = std::make_shared<RGBFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else if (frame_id == FrameID::POINTCLOUD_GRID)
+	{
+		p_data_frame = std::make_shared<GridFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else if (frame_id == FrameID::TEMPERATURE_GRID)
+	{
+		p_data_frame = std::make_shared<TempFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else if (frame_id == FrameID::POINTCLOUD_MASK)
+	{
+		p_data_frame = std::make_shared<MaskFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else if (frame_id == FrameID::NORMAL_GRID)
+	{
+		p_data_frame = std::make_shared<NormalFrame>(file_path, m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+	}
+	else
+	{
+		throw std::runtime_error("Unsupported frame type " + FrameIDUtils::toString(frame_id) + ".");
+	}
+	if (m_datasetIndexPtr->hasTimestamps())
+	{
+		p_data_frame->setLoadedTimestamp(m_datasetIndexPtr->getTimestamp(index));
+	}
+	return p_data_frame;
+}
+
+void SavedListener::schedule(const size_t index)
+{
+	// Called with m_prefetchMutex held
+	const auto p_slot = std::make_shared<PrefetchSlot>();
+	p_slot->m_index = index;
+	for (const auto& frame_id : m_frameIDs)
+	{
+		// Indexed directories have every frame type for every frame
+		if (!m_recordingPtr || m_recordingPtr->has(index, frame_id))
+		{
+			m_decodeJobs.push_back({p_slot, frame_id});
+			++p_slot->m_remaining;
+		}
+	}
+	m_window[index] = p_slot;
+	m_decodeEvent.notify_all();
+}
+
+size_t SavedListener::getWindowOffset(const size_t index) const
+{
+	// Called with m_prefetchMutex held; in loop mode the frames at the start of the range follow the last one
+	if (index >= m_cursor && index < m_endIndex)
+	{
+		return index - m_cursor;
+	}
+	if (m_playbackParams.m_loop && index >= m_beginIndex && index < m_cursor)
+	{
+		return m_endIndex - m_cursor + index - m_beginIndex;
+	}
+	return std::numeric_limits<size_t>::max();
+}
+
+void SavedListener::updateWindow()
+{
+	// Called with m_prefetchMutex held; cancels frames that fell out of the window and schedules the ones that entered it
+	const size_t window_size = std::min(m_playbackParams.m_prefetchFrames, m_playbackParams.m_loop ? m_endIndex - m_beginIndex : m_endIndex - m_cursor);
+	for (auto it = m_window.begin(); it != m_window.end();)
+	{
+		if (getWindowOffset(it->first) >= window_size)
+		{
+			it->second->m_cancelled = it->second->m_remaining > 0;
+			it = m_window.erase(it);
+		}
+		else
+		{
+			++it;
+		}
 	}
-	for (const auto& frame_id : frame_id_vec)
+	for (size_t offset = 0; offset < window_size; ++offset)
 	{
-		std::string file_dir = data_dir;
-		if (covert_format)
+		const size_t index = m_cursor + offset < m_endIndex ? m_cursor + offset : m_beginIndex + (m_cursor + offset - m_endIndex);
+		if (m_window.count(index) != 0)
+		{
+			continue;
+		}
+		const auto retained = std::find_if(m_retained.begin(), m_retained.end(), [index](const auto& p_slot) { return p_slot->m_index == index; });
+		const auto cached = m_cache.find(index);
+		if (retained != m_retained.end())
+		{
+			m_window[index] = *retained;
+		}
+		else if (cached != m_cache.end())
 		{
-			file_dir = data_dir + "/" + FrameIDUtils::toString(frame_id);
+			m_window[index] = cached->second;
 		}
-		std::vector<std::string> file_list = {};
-		for (const auto& file : std::filesystem::directory_iterator(file_dir))
+		else
 		{
-			file_list.push_back(file.path().string());
+			schedule(index);
 		}
-		SI::natural::sort(file_list);
-		m_numFiles = file_list.size();
-		m_fileVectMap[frame_id] = file_list;
+	}
+}
+
+bool SavedListener::cache(const std::shared_ptr<PrefetchSlot>& p_slot)
+{
+	// Called with m_prefetchMutex held
+	if (m_cache.count(p_slot->m_index) != 0)
+	{
+		return true;
+	}
+	if (p_slot->m_failed || m_playbackParams.m_cacheBytes == 0)
+	{
+		return false;
+	}
+	size_t num_bytes = 0;
+	for (const auto& pair : p_slot->m_dataFrames)
+	{
+		num_bytes += pair.second->getNumBytes();
+	}
+
+	// Frames outside the playback range make room first. Frames inside it are never evicted, since under looping
+	// playback every frame is reused exactly one pass later, after an LRU cache smaller than the range would have
+	// evicted it; keeping the frames that fit serves that fraction of every pass from memory instead.
+	for (auto it = m_cache.begin(); it != m_cache.end() && m_cachedBytes + num_bytes > m_playbackParams.m_cacheBytes;)
+	{
+		if (it->first < m_beginIndex || it->first >= m_endIndex)
+		{
+			for (const auto& pair : it->second->m_dataFrames)
+			{
+				m_cachedBytes -= pair.second->getNumBytes();
+			}
+			it = m_cache.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+	if (m_cachedBytes + num_bytes > m_playbackParams.m_cacheBytes)
+	{
+		return false;
+	}
+	m_cache[p_slot->m_index] = p_slot;
+	m_cachedBytes += num_bytes;
+	return true;
+}
+
+void SavedListener::decoderLoop()
+{
+	while (true)
+	{
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> lock(m_prefetchMutex);
+			m_decodeEvent.wait(lock, [this] { return m_stopDecoding || !m_decodeJobs.empty(); });
+			if (m_stopDecoding)
+			{
+				return;
+			}
+			job = std::move(m_decodeJobs.front());
+			m_decodeJobs.pop_front();
+			if (job.m_slotPtr->m_cancelled)
+			{
+				--job.m_slotPtr->m_remaining;
+				continue;
+			}
+		}
+
+		std::shared_ptr<GenericDataFrame> p_data_frame;
+		try
+		{
+			p_data_frame = loadDataFrame(job.m_slotPtr->m_index, job.m_frameID);
+			// Masks are not resized, as in CompositeFrame::resizeAll
+			if (m_resizeFactor != 1.0f && job.m_frameID != FrameID::POINTCLOUD_MASK)
+			{
+				p_data_frame->resize(m_resizeFactor);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "Failed to load " << FrameIDUtils::toString(job.m_frameID) << " of frame " << job.m_slotPtr->m_index << ": " << e.what() << std::endl;
+		}
+
+		std::lock_guard lock(m_prefetchMutex);
+		if (p_data_frame)
+		{
+			job.m_slotPtr->m_dataFrames[job.m_frameID] = p_data_frame;
+		}
+		else
+		{
+			job.m_slotPtr->m_failed = true;
+		}
+		if (--job.m_slotPtr->m_remaining == 0)
+		{
+			m_readyEvent.notify_all();
+		}
+	}
+}
+
+void SavedListener::startDecoders()
+{
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		m_stopDecoding = false;
+	}
+	const unsigned int num_threads = listener_utils::getNumThreads(m_playbackParams.m_numThreads);
+	m_decoders.reserve(num_threads);
+	for (unsigned int t = 0; t < num_threads; ++t)
+	{
+		m_decoders.emplace_back(&SavedListener::decoderLoop, this);
+	}
+}
+
+void SavedListener::stopDecoders()
+{
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		m_stopDecoding = true;
+		m_decodeJobs.clear();
+	}
+	m_decodeEvent.notify_all();
+	for (auto& decoder : m_decoders)
+	{
+		decoder.join();
+	}
+	m_decoders.clear();
+
+	// Frames left partially decoded by the cleared jobs are dropped
+	std::lock_guard lock(m_prefetchMutex);
+	for (auto it = m_window.begin(); it != m_window.end();)
+	{
+		it = it->second->m_remaining == 0 ? std::next(it) : m_window.erase(it);
 	}
 }
 
 void SavedListener::streamLoop()
 {
-	size_t i = 0;
+	startDecoders();
+	const bool recorded_timing = m_playbackParams.m_timing == PlaybackTiming::RECORDED && hasRecordedTimestamps();
+	const bool paced = m_playbackParams.m_timing != PlaybackTiming::AS_FAST_AS_POSSIBLE;
+	const std::chrono::microseconds period = std::chrono::microseconds(1000000) / m_framerate;
+	const auto start_time = std::chrono::steady_clock::now();
+	const auto start_epoch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+	auto deadline = start_time;
+	std::chrono::microseconds last_recorded{0};
+	size_t num_scheduled = 0;
+	size_t last_scheduled = 0;
+	size_t num_published = 0;
+	size_t last_published = 0;
+	size_t num_failed = 0;
+	size_t wrapped_index = std::numeric_limits<size_t>::max();
+	size_t num_passes = 0;
 	bool print_flag = true;
 	while (m_isStreaming)
 	{
-		// Add all data to CompositeFrame and add to queue with resizing
-		auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
-		const auto p_composite_frame = std::make_shared<CompositeFrame>(timestamp, m_sensorInterfacePtr->getRGBMappable());
-		for (const auto& pair : m_fileVectMap)
+		// Keep the prefetch window around the cursor full, then wait for the frame at the cursor to be decoded
+		std::shared_ptr<PrefetchSlot> p_slot;
+		bool stepped = false;
+		bool at_end = false;
+		bool copy = false;
+		size_t loop_start = std::numeric_limits<size_t>::max();
 		{
-			std::shared_ptr<GenericDataFrame> p_data_frame;
-			if (pair.first == FrameID::GRAYSCALE_IMAGE)
+			std::unique_lock<std::mutex> lock(m_prefetchMutex);
+			updateWindow();
+			if (m_paused && !m_stepPending)
 			{
-				p_data_frame = std::make_shared<GrayFrame>(pair.second[i], m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+				m_readyEvent.wait_for(lock, std::chrono::milliseconds(100));
+				continue;
 			}
-			else if (pair.first == FrameID::RGB_IMAGE)
+			p_slot = m_window.at(m_cursor);
+			if (!m_readyEvent.wait_for(lock, std::chrono::milliseconds(100), [this, &p_slot] { return p_slot->m_remaining == 0 || p_slot->m_index != m_cursor; }))
 			{
-				p_data_frame = std::make_shared<RGBFrame>(pair.second[i], m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+				continue;
 			}
-			else if (pair.first == FrameID::POINTCLOUD_GRID)
+			// The cursor may have been moved or playback paused while waiting
+			const auto current = m_window.find(m_cursor);
+			if (current == m_window.end() || current->second != p_slot || p_slot->m_remaining > 0 || (m_paused && !m_stepPending))
 			{
-				p_data_frame = std::make_shared<GridFrame>(pair.second[i], m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+				continue;
 			}
-			else if (pair.first == FrameID::TEMPERATURE_GRID)
+			stepped = m_stepPending;
+			m_stepPending = false;
+
+			// In repeat mode the last frame stays decoded and is republished as copies, and other published frames are
+			// cached for later passes and kept for stepping back if requested
+			at_end = m_cursor + 1 >= m_endIndex;
+			const bool repeating = at_end && m_repeat && !p_slot->m_failed;
+			bool cached = false;
+			if (!repeating)
 			{
-				p_data_frame = std::make_shared<TempFrame>(pair.second[i], m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+				m_window.erase(m_cursor);
+				cached = cache(p_slot);
 			}
-			else if (pair.first == FrameID::POINTCLOUD_MASK)
+			copy = repeating || cached || m_playbackParams.m_retainedFrames > 0;
+			if (m_playbackParams.m_retainedFrames > 0)
 			{
-				p_data_frame = std::make_shared<MaskFrame>(pair.second[i], m_camParamsPtr, m_extrinsicPtr, *m_sensorInterfacePtr);
+				m_retained.erase(std::remove(m_retained.begin(), m_retained.end(), p_slot), m_retained.end());
+				m_retained.push_back(p_slot);
+				while (m_retained.size() > m_playbackParams.m_retainedFrames)
+				{
+					m_retained.pop_front();
+				}
+			}
+			m_lastPublished = m_cursor;
+			m_hasPublished = true;
+			if (!at_end)
+			{
+				++m_cursor;
+			}
+			else if (!m_repeat && !stepped && !m_paused)
+			{
+				m_cursor = m_beginIndex;
+				if (m_playbackParams.m_loop)
+				{
+					loop_start = m_beginIndex;
+				}
 			}
-			p_composite_frame->addFrame(pair.first, p_data_frame);
 		}
-		p_composite_frame->resizeAll(m_resizeFactor);
-		addToQueue(p_composite_frame);
-		if (i + 1 < m_numFiles)
+
+		// Schedule the frame one period, or one recorded interval, after the previous one, or restart the schedule after a
+		// seek. Frames that failed to load keep their place in the schedule without being published, so that retrying a
+		// frame that keeps failing is paced like playback instead of spinning.
+		const bool sequential = num_scheduled > 0 && (p_slot->m_index == last_scheduled + 1 || p_slot->m_index == last_scheduled || p_slot->m_index == wrapped_index);
+		std::chrono::microseconds interval = period;
+		if (recorded_timing)
 		{
-			++i;
+			const std::chrono::microseconds recorded = getRecordedTimestamp(p_slot->m_index);
+			if (recorded > last_recorded && sequential)
+			{
+				interval = recorded - last_recorded;
+			}
+			last_recorded = recorded;
 		}
-		else if (m_repeat)
+		const auto scaled_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::micro>(interval) / m_playbackParams.m_speed);
+		if (!sequential || stepped)
 		{
-			if (print_flag)
+			deadline = std::max(deadline, std::chrono::steady_clock::now());
+		}
+		else
+		{
+			deadline += scaled_interval;
+		}
+
+		if (paced && !stepped)
+		{
+			const auto now = std::chrono::steady_clock::now();
+			if (now - deadline > scaled_interval)
+			{
+				deadline = now;
+			}
+			// Sleep in short steps so that stopping the stream is not delayed by long recorded gaps
+			while (m_isStreaming && std::chrono::steady_clock::now() < deadline)
+			{
+				std::this_thread::sleep_until(std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(100)));
+			}
+		}
+		else if (!paced && !p_slot->m_failed)
+		{
+			while (m_isStreaming && !waitForQueueSpace(m_playbackParams.m_maxQueuedFrames, std::chrono::milliseconds(100)))
+			{
+			}
+		}
+		if (!m_isStreaming)
+		{
+			break;
+		}
+		++num_scheduled;
+		last_scheduled = p_slot->m_index;
+
+		if (!p_slot->m_failed)
+		{
+			// Add all data to CompositeFrame and add to queue, copying kept data so that consumers cannot modify it. A
+			// republished frame or a frame of a later loop pass is stamped with its own deadline only, not the recorded
+			// timestamp of the original, so that timestamps keep increasing.
+			const bool republished = (num_published > 0 && p_slot->m_index == last_published) || num_passes > 0;
+			const auto timestamp = start_epoch + std::chrono::duration_cast<std::chrono::microseconds>(deadline - start_time);
+			const auto p_composite_frame = std::make_shared<CompositeFrame>(timestamp, m_sensorInterfacePtr->getRGBMappable());
+			for (const auto& pair : p_slot->m_dataFrames)
+			{
+				const std::shared_ptr<GenericDataFrame> p_data_frame = copy ? pair.second->clone() : pair.second;
+				if (republished)
+				{
+					p_data_frame->setLoadedTimestamp(std::chrono::microseconds::zero());
+				}
+				p_composite_frame->addFrame(pair.first, p_data_frame);
+			}
+			addToQueue(p_composite_frame);
+			++num_published;
+			last_published = p_slot->m_index;
+			num_failed = 0;
+		}
+		else
+		{
+			++num_failed;
+		}
+
+		// The first frame of the next loop pass continues the schedule of the last frame of this one. The pass is only
+		// counted once the last frame of this one is published, which still carries its recorded timestamp.
+		wrapped_index = loop_start;
+		if (loop_start != std::numeric_limits<size_t>::max())
+		{
+			++num_passes;
+		}
+
+		// Frames that failed once are retried when playback returns to them, which is pointless once a whole pass, or the
+		// repeated last frame, failed with nothing published in between
+		if (p_slot->m_failed && !stepped && (num_failed >= m_endIndex - m_beginIndex || (at_end && m_repeat)))
+		{
+			std::cerr << "Failed to load " << (at_end && m_repeat ? "last frame" : "any frame") << " of saved data, stopping stream." << std::endl;
+			m_isStreaming = false;
+		}
+		else if (at_end && !stepped)
+		{
+			if (m_playbackParams.m_loop)
+			{
+				if (print_flag && !m_paused)
+				{
+					std::cout << "Reached end of saved data, looping to start." << std::endl;
+					print_flag = false;
+				}
+			}
+			else if (!m_repeat)
+			{
+				if (!m_paused)
+				{
+					std::cout << "Reached end of saved data, stopping stream." << std::endl;
+					m_isStreaming = false;
+				}
+			}
+			else if (print_flag)
 			{
 				std::cout << "Reached end of saved data, repeating last frame." << std::endl;
 				print_flag = false;
 			}
 		}
+	}
+	stopDecoders();
+}
+
+size_t SavedListener::getNumFrames() const
+{
+	return m_numFiles;
+}
+
+size_t SavedListener::getCursor() const
+{
+	std::lock_guard lock(m_prefetchMutex);
+	return m_cursor;
+}
+
+void SavedListener::seek(const size_t index)
+{
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		m_cursor = std::clamp(index, m_beginIndex, m_endIndex - 1);
+		m_stepPending = m_paused;
+		updateWindow();
+	}
+	m_readyEvent.notify_all();
+}
+
+void SavedListener::seek(const std::chrono::microseconds& timestamp)
+{
+	if (!hasRecordedTimestamps())
+	{
+		throw std::runtime_error("Saved data has no recorded timestamps to seek by.");
+	}
+	size_t low = 0;
+	size_t high = m_numFiles;
+	while (low < high)
+	{
+		const size_t mid = low + (high - low) / 2;
+		if (getRecordedTimestamp(mid) < timestamp)
+		{
+			low = mid + 1;
+		}
 		else
 		{
-			std::cout << "Reached end of saved data, stopping stream." << std::endl;
-			m_isStreaming = false;
+			high = mid;
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1000) / m_framerate);
 	}
-}
\ No newline at end of file
+	seek(low);
+}
+
+void SavedListener::step(const long offset)
+{
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		const long long base = m_hasPublished ? static_cast<long long>(m_lastPublished) : static_cast<long long>(m_cursor) - 1;
+		const long long target = std::clamp(base + offset, static_cast<long long>(m_beginIndex), static_cast<long long>(m_endIndex) - 1);
+		m_cursor = static_cast<size_t>(target);
+		m_paused = true;
+		m_stepPending = true;
+		updateWindow();
+	}
+	m_readyEvent.notify_all();
+}
+
+void SavedListener::setRange(const size_t begin, size_t end)
+{
+	end = std::min(end, m_numFiles);
+	if (begin >= end)
+	{
+		throw std::runtime_error("Saved listener playback range [" + std::to_string(begin) + ", " + std::to_string(end) + ") is empty.");
+	}
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		m_beginIndex = begin;
+		m_endIndex = end;
+		if (m_cursor < m_beginIndex || m_cursor >= m_endIndex)
+		{
+			m_cursor = m_beginIndex;
+		}
+		updateWindow();
+	}
+	m_readyEvent.notify_all();
+}
+
+void SavedListener::setPaused(const bool paused)
+{
+	{
+		std::lock_guard lock(m_prefetchMutex);
+		m_paused = paused;
+	}
+	m_readyEvent.notify_all();
+}
+
+bool SavedListener::isPaused() const
+{
+	std::lock_guard lock(m_prefetchMutex);
+	return m_paused;
+}
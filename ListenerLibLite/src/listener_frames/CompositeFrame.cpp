@@ -1,7 +1,9 @@
 #include "listener_frames/CompositeFrame.h"
 
 #include <chrono>
+#include <vector>
 #include <memory>
+#include <utility>
 #include <stdexcept>
 #include <filesystem>
 
@@ -12,6 +14,10 @@
 #include "listener_frames/MaskFrame.h"
 #include "listener_frames/RGBFrame.h"
 #include "listener_frames/GridFrame.h"
+#include "listener_frames/GrayFrame.h"
+#include "listener_frames/NormalFrame.h"
+#include "listener_processing/NormalEstimator.h"
+#include "listener_utils/PointCloudBuffer.h"
 
 CompositeFrame::CompositeFrame(const std::chrono::microseconds& timestamp, const bool mappable)
 	: m_timestamp(timestamp), m_rgbMappable(mappable)
@@ -23,6 +29,16 @@ const std::chrono::microseconds& CompositeFrame::getTimestamp() const
 	return m_timestamp;
 }
 
+size_t CompositeFrame::getSequenceNumber() const
+{
+	return m_sequenceNumber;
+}
+
+void CompositeFrame::setSequenceNumber(const size_t sequence_number)
+{
+	m_sequenceNumber = sequence_number;
+}
+
 void CompositeFrame::addFrame(const FrameID frame_id, const std::shared_ptr<GenericDataFrame> p_data_frame)
 {
 	m_dataMap[frame_id] = p_data_frame;
@@ -66,6 +82,62 @@ bool CompositeFrame::has(const FrameID frame_id) const
 	return true;
 }
 
+std::vector<FrameID> CompositeFrame::getFrameIDs() const
+{
+	std::vector<FrameID> frame_id_vec;
+	frame_id_vec.reserve(m_dataMap.size());
+	for (const auto& pair : m_dataMap)
+	{
+		frame_id_vec.push_back(pair.first);
+	}
+	return frame_id_vec;
+}
+
+std::shared_ptr<NormalFrame> CompositeFrame::getOrEstimateNormals(const NormalEstimator& estimator)
+{
+	if (!has(FrameID::NORMAL_GRID))
+	{
+		const auto p_grid_frame = std::static_pointer_cast<GridFrame>(getFrame(FrameID::POINTCLOUD_GRID));
+		const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(getFrame(FrameID::POINTCLOUD_MASK));
+		addFrame(FrameID::NORMAL_GRID, estimator.estimate(*p_grid_frame, *p_mask_frame));
+	}
+	return std::static_pointer_cast<NormalFrame>(getFrame(FrameID::NORMAL_GRID));
+}
+
+void CompositeFrame::addPyramidLevel(const std::shared_ptr<GridFrame> p_grid_frame, const std::shared_ptr<MaskFrame> p_mask_frame)
+{
+	m_pyramidLevels.emplace_back(p_grid_frame, p_mask_frame);
+}
+
+size_t CompositeFrame::getPyramidSize() const
+{
+	if (!has(FrameID::POINTCLOUD_GRID))
+	{
+		return 0;
+	}
+	return 1 + m_pyramidLevels.size();
+}
+
+std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> CompositeFrame::getPyramidLevel(const size_t level) const
+{
+	if (level >= getPyramidSize())
+	{
+		std::cerr << "Tried to access pyramid level " << level << " of a CompositeFrame with " << getPyramidSize() << " levels." << std::endl;
+		throw std::runtime_error("Pyramid level not found in CompositeFrame.");
+	}
+	if (level == 0)
+	{
+		return {std::static_pointer_cast<GridFrame>(getFrame(FrameID::POINTCLOUD_GRID)),
+				std::static_pointer_cast<MaskFrame>(getFrame(FrameID::POINTCLOUD_MASK))};
+	}
+	return m_pyramidLevels[level - 1];
+}
+
+void CompositeFrame::clearPyramid()
+{
+	m_pyramidLevels.clear();
+}
+
 // ReSharper disable once CppMemberFunctionMayBeConst
 void CompositeFrame::resizeAll(const float factor)
 {
@@ -82,7 +154,7 @@ void CompositeFrame::resizeAll(const float factor)
 	}
 }
 
-void CompositeFrame::saveAll(const std::string& save_dir, const unsigned int frame_number) const
+void CompositeFrame::saveAll(const std::string& save_dir, const unsigned int frame_number, const EncodingParameters& encoding_params) const
 {
 	for (const auto& pair : m_dataMap)
 	{
@@ -92,35 +164,30 @@ void CompositeFrame::saveAll(const std::string& save_dir, const unsigned int fra
 			std::filesystem::create_directory(frame_dir);
 		}
 		std::string file_path = frame_dir + "/" + FrameIDUtils::toString(pair.first) + std::to_string(frame_number);
-		pair.second->save(file_path);
+		pair.second->save(file_path, encoding_params);
 	}
 }
 
-void CompositeFrame::toPointCloud(open3d::geometry::PointCloud& pcd) const
+void CompositeFrame::toPointCloudBuffer(PointCloudBuffer& buffer) const
 {
-	pcd.Clear();
-	Eigen::Vector3d point;
-	Eigen::Vector3d color;
-	for (int i = 0; i < m_dataMap.at(FrameID::POINTCLOUD_GRID)->getRows(); ++i)
+	std::shared_ptr<const RGBFrame> p_rgb_frame = nullptr;
+	if (buffer.hasColor() && m_rgbMappable && has(FrameID::RGB_IMAGE))
 	{
-		for (int j = 0; j < m_dataMap.at(FrameID::POINTCLOUD_GRID)->getCols(); ++j)
-		{
-			if (std::static_pointer_cast<MaskFrame>(getFrame(FrameID::POINTCLOUD_MASK))->getElement(i, j, 0))
-			{
-				for (int k = 0; k < 3; ++k)
-				{
-					point(k) = std::static_pointer_cast<GridFrame>(getFrame(FrameID::POINTCLOUD_GRID))->getElement(i, j, k);
-					if (m_rgbMappable)
-					{
-						color(k) = std::static_pointer_cast<RGBFrame>(getFrame(FrameID::RGB_IMAGE))->getElement(i, j, k);
-					}
-				}
-				pcd.points_.push_back(point);
-				if (m_rgbMappable)
-				{
-					pcd.colors_.push_back(color);
-				}
-			}
-		}
+		p_rgb_frame = std::static_pointer_cast<const RGBFrame>(getFrame(FrameID::RGB_IMAGE));
 	}
+	std::shared_ptr<const GrayFrame> p_gray_frame = nullptr;
+	if (buffer.hasIntensity() && has(FrameID::GRAYSCALE_IMAGE))
+	{
+		p_gray_frame = std::static_pointer_cast<const GrayFrame>(getFrame(FrameID::GRAYSCALE_IMAGE));
+	}
+	buffer.fromGridFrame(*std::static_pointer_cast<const GridFrame>(getFrame(FrameID::POINTCLOUD_GRID)),
+						 *std::static_pointer_cast<const MaskFrame>(getFrame(FrameID::POINTCLOUD_MASK)),
+						 p_rgb_frame, p_gray_frame);
+}
+
+void CompositeFrame::toPointCloud(open3d::geometry::PointCloud& pcd) const
+{
+	PointCloudBuffer buffer(PointLayout::SOA, m_rgbMappable);
+	toPointCloudBuffer(buffer);
+	buffer.toOpen3D(pcd);
 }
\ No newline at end of file
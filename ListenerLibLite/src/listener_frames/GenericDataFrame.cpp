@@ -44,4 +44,14 @@ std::shared_ptr<Eigen::Matrix4f> GenericDataFrame::getExtrinsic() const
 const std::chrono::microseconds& GenericDataFrame::getLoadedTimestamp() const
 {
     return m_loadedTimestamp;
+}
+
+void GenericDataFrame::setLoadedTimestamp(const std::chrono::microseconds& timestamp)
+{
+    m_loadedTimestamp = timestamp;
+}
+
+void GenericDataFrame::setCamParams(const std::shared_ptr<CamParameters> p_cam_params)
+{
+    m_camParamsPtr = p_cam_params;
 }
\ No newline at end of file
@@ -9,6 +9,8 @@ class SensorInterface;
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/ImageCodec.h"
+
 GrayFrame::GrayFrame(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface)
     : DataFrame(p_cam_params, p_extrinsic)
 {
@@ -39,15 +41,17 @@ void GrayFrame::fromCvMat(const cv::Mat& mat)
     }
 }
 
-void GrayFrame::save(const std::string& file_path)
+void GrayFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
 {
-    const std::shared_ptr<cv::Mat> p_mat = asCvMat();
-    cv::imwrite(file_path + ".png", *p_mat);
+    image_codec::save(file_path, getData().data(), m_rows, m_cols, m_channels, encoding_params);
 }
 
 void GrayFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
 {
-    const cv::Mat mat = cv::imread(file_path, cv::IMREAD_GRAYSCALE);
-    initializeTensor(mat.rows, mat.cols, mat.channels());
-    fromCvMat(mat);
+    setTensor(image_codec::load(file_path, 1));
+}
+
+std::shared_ptr<GenericDataFrame> GrayFrame::clone() const
+{
+    return cloneAs<GrayFrame>();
 }
\ No newline at end of file
@@ -6,150 +6,76 @@
 #include <algorithm>
 #include <stdexcept>
 #include <chrono>
+#include <functional>
+#include <cstdint>
 #include <filesystem>
 
-#include <npy.hpp>
 #include <Eigen/Dense>
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
-#include <opencv2/calib3d.hpp>
 #include <open3d/Open3D.h>
 
 #include "listener_utils/CamParameters.hpp"
+#include "listener_utils/PlyReader.h"
+#include "listener_utils/NpyReader.h"
+#include "listener_utils/NpyWriter.h"
+#include "listener_utils/GridCodec.h"
+#include "listener_processing/DepthHoleFiller.h"
+#include "listener_processing/DepthMedianFilter.h"
+#include "listener_processing/GridProjector.h"
+#include "listener_processing/ProjectionLut.h"
 #include "sensor_interfaces/SensorInterface.h"
 #include "sensor_interfaces/ScanningLidarInterface.h"
 
-float GridFrame::floorMedianFilter(std::vector<float>& window)
+void GridFrame::organizePcd(std::vector<float>& points, const std::vector<uint32_t>& beam_ids, const ScanningLidarInterface& scan_lidar_interface)
 {
-    const auto max_it = std::max_element(window.begin(), window.end());
-    if (max_it != window.end() && *max_it > 0.0f)
-    {
-        std::sort(window.begin(), window.end());
-        const size_t length = window.size();
-        if (length % 2 == 1)
-        {
-            return window[std::floor(length / 2)];
-        }
-        return window[std::floor(length / 2) - 1];
-    }
-    return 0.0f;
-}
+    const Eigen::Matrix3f& intrinsic = *(m_camParamsPtr->m_intrinsicPtr);
+    initializeTensor(static_cast<int>(intrinsic(1, 2) * 2), static_cast<int>(intrinsic(0, 2) * 2), 3);
 
-std::shared_ptr<cv::Mat> GridFrame::applyCustomFilter(cv::Mat& image, const int kernel_size) const
-{
-    auto clone_image = image.clone();
-    auto new_image = std::make_shared<cv::Mat>(clone_image);
-    const int half_kernel_size = std::floor((kernel_size + 1) / 2);
-    for (int i = 0; i < m_rows; ++i)
+    // Points carrying driver beam IDs look up their pixel from the beam they were measured by instead of projecting it
+    const std::shared_ptr<ProjectionLut> p_lut = beam_ids.empty() ? nullptr : scan_lidar_interface.getProjectionLut(intrinsic, m_rows, m_cols);
+    std::vector<uint32_t> kept_beam_ids;
+    if (p_lut != nullptr)
     {
-        for (int j = 0; j < m_cols; ++j)
+        scan_lidar_interface.conditionPoints(points, kept_beam_ids);
+        for (auto& index : kept_beam_ids)
         {
-            const int window_top = std::max(0, i - half_kernel_size);
-            const int window_lft = std::max(0, j - half_kernel_size);
-            const int window_btm = std::min(m_rows, i + half_kernel_size);
-            const int window_rgt = std::min(m_cols, j + half_kernel_size);
-            std::vector<float> window;
-            for (int n = window_top; n < window_btm; ++n)
-            {
-                for (int m = window_lft; m < window_rgt; ++m)
-                {
-                    float pixel = image.at<float>(n, m);
-                    if (pixel > 0)
-                    {
-                        window.push_back(pixel);
-                    }
-                }
-            }
-            new_image->at<float>(i, j) = floorMedianFilter(window);
+            index = beam_ids[index];
         }
     }
-    return new_image;
-}
-
-void GridFrame::organizePcd(std::vector<Eigen::Vector3d>& point_array, const int filter_size)
-{
-    // Convert point array to OpenCV format
-    std::vector<cv::Point3f> point_array_cv;
-    for (const auto& point : point_array)
+    else
     {
-        cv::Point3f point_cv = {static_cast<float>(point[0]), static_cast<float>(point[1]), static_cast<float>(point[2])};
-        point_array_cv.push_back(point_cv);
+        scan_lidar_interface.conditionPoints(points);
     }
 
-    // Convert intrinsic matrix to OpenCV format
-    Eigen::Matrix3f& intrinsic = *(m_camParamsPtr->m_intrinsicPtr);
-    cv::Mat intrinsic_cv(3, 3, CV_32F);
-    for (int i = 0; i < 3; ++i)
+    // Fill or filter projected depth before deprojecting it, or keep the nearest raw points if neither is requested.
+    // A configured hole filler always runs, whether or not processing enables the floor median filter it replaces
+    const int filter_size = scan_lidar_interface.getFilterSize();
+    const std::shared_ptr<const DepthHoleFiller> p_hole_filler = scan_lidar_interface.getHoleFiller();
+    std::function<void(cv::Mat&)> depth_filter = nullptr;
+    if (p_hole_filler != nullptr)
     {
-        for (int j = 0; j < 3; ++j)
+        depth_filter = [&](cv::Mat& depth_image)
         {
-            intrinsic_cv.at<float>(i, j) = intrinsic(i, j);
-        }
+            p_hole_filler->fill(depth_image);
+        };
     }
-
-    // Transform vector of points to image frame and get array of corresponding pixel coordinates
-    std::vector<cv::Point2f> pixel_array;
-    cv::projectPoints(point_array_cv, std::vector(3, 0.0f), std::vector(3, 0.0f), intrinsic_cv, std::vector(5, 0.0f), pixel_array);
-
-    // Pick out pixels and points that lie within the image bounds
-    initializeTensor(static_cast<int>(intrinsic(1, 2) * 2), static_cast<int>(intrinsic(0, 2) * 2), 3);
-    std::vector<cv::Point2f> valid_pixels;
-    std::vector<Eigen::Vector3d> valid_points;
-    for (int i = 0; i < pixel_array.size(); ++i)
+    else if (filter_size > 0)
     {
-        if (pixel_array[i].x >= 0 && pixel_array[i].x < m_cols && pixel_array[i].y >= 0 && pixel_array[i].y < m_rows)
+        depth_filter = [&](cv::Mat& depth_image)
         {
-            valid_pixels.push_back(pixel_array[i]);
-            valid_points.push_back(point_array[i]);
-        }
+            DepthMedianFilter(filter_size).filter(depth_image, depth_image);
+        };
     }
 
-    if (filter_size > 0)
+    GridProjector projector(intrinsic, m_rows, m_cols);
+    if (p_lut != nullptr)
     {
-        // Populate depth frame with point cloud depth based on valid projected pixel coordinates
-        cv::Mat depth_image_cv = cv::Mat::zeros(m_rows, m_cols, CV_32F);
-        for (int i = 0; i < valid_pixels.size(); ++i)
-        {
-            depth_image_cv.at<float>(valid_pixels[i].y, valid_pixels[i].x) = valid_points[i](2);
-        }
-
-        cv::Mat filtered_depth_image_cv = *applyCustomFilter(depth_image_cv, filter_size);
-
-        open3d::geometry::Image depth_image_o3d;
-        depth_image_o3d.Prepare(m_cols, m_rows, 1, sizeof(float));
-        memcpy(depth_image_o3d.data_.data(), filtered_depth_image_cv.data, m_rows * m_cols * sizeof(float));
-
-        // Transform back to camera frame
-        open3d::camera::PinholeCameraIntrinsic intrinsic_o3d(m_cols, m_rows, intrinsic.cast<double>());
-        std::shared_ptr<open3d::geometry::PointCloud> pcd = open3d::geometry::PointCloud::CreateFromDepthImage(depth_image_o3d, intrinsic_o3d, Eigen::Matrix4d::Identity(), 1.0);
-        
-        // Populate grid frame with point cloud data
-        int m = 0;
-        for (int i = 0; i < m_rows; ++i)
-        {
-            for (int j = 0; j < m_cols; ++j)
-            {
-                if (filtered_depth_image_cv.at<float>(i, j) > 0.0f)
-                {
-                    for (int k = 0; k < 3; ++k)
-                    {
-                        getElement(i, j, k) = pcd->points_[m](k);
-                    }
-                    ++m;
-                }
-            }
-        }
+        projector.project(points.data(), kept_beam_ids.data(), kept_beam_ids.size(), *p_lut, getData(), depth_filter);
     }
     else
     {
-        // Populate grid frame with point cloud points at valid indices
-        for (int i = 0; i < valid_pixels.size(); ++i)
-        {
-            for (int k = 0; k < 3; ++k)
-            {
-                getElement(valid_pixels[i].y, valid_pixels[i].x, k) = valid_points[i](k);
-            }
-        }
+        projector.project(points.data(), points.size() / 3, getData(), depth_filter);
     }
 }
 
@@ -189,25 +115,14 @@ void GridFrame::fromCvMat(const cv::Mat& mat)
     }
 }
 
-void GridFrame::save(const std::string& file_path)
+void GridFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
 {
-    std::vector<float> grid_vec;
-    for (int i = 0; i < m_rows; ++i)
+    if (encoding_params.m_gridEncoding == GridEncoding::GRID_CODEC)
     {
-        for (int j = 0; j < m_cols; ++j)
-        {
-            for (int k = 0; k < m_channels; ++k)
-            {
-                grid_vec.push_back(getElement(i, j, k));
-            }
-        }
+        grid_codec::save(file_path + grid_codec::fileExtension, getData(), encoding_params.m_gridQuantization);
+        return;
     }
-
-    npy::npy_data_ptr<float> data;
-    data.data_ptr = grid_vec.data();
-    data.shape = { static_cast<unsigned long>(m_rows), static_cast<unsigned long>(m_cols), static_cast<unsigned long>(m_channels) };
-    data.fortran_order = false;
-    npy::write_npy(file_path + ".npy", data);
+    NpyWriter::save(file_path + ".npy", getData(), encoding_params.m_npyWriterPtr);
 }
 
 void GridFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
@@ -215,38 +130,52 @@ void GridFrame::load(const std::string& file_path, const SensorInterface& sensor
     std::filesystem::path extension = std::filesystem::path(file_path).extension();
     if (extension == ".npy")
     {
-        npy::npy_data data = npy::read_npy<float>(file_path);
-        std::vector<float> data_vec = data.data;
-        std::vector<unsigned long> shape = data.shape;
-
-        initializeTensor(shape[0], shape[1], shape[2]);
-        int counter = 0;
-        for (int i = 0; i < m_rows; ++i)
+        const NpyReader npy_reader(file_path);
+        const std::vector<size_t>& shape = npy_reader.getShape();
+        auto p_tensor = std::make_shared<Eigen::Tensor<float, 3>>(static_cast<Eigen::Index>(shape[0]), static_cast<Eigen::Index>(shape[1]), static_cast<Eigen::Index>(shape[2]));
+        npy_reader.readTensor(*p_tensor);
+        setTensor(p_tensor);
+    }
+    else if (extension == grid_codec::fileExtension)
+    {
+        setTensor(grid_codec::load(file_path));
+    }
+    else if (extension == ".ply")
+    {
+        // Binary files are converted straight from the mapped file, other files are parsed by Open3D
+        std::vector<float> points;
+        std::vector<uint32_t> beam_ids;
+        const auto* p_scan_lidar_interface = dynamic_cast<const ScanningLidarInterface*>(&sensor_interface);
+        const PlyReader ply_reader(file_path);
+        if (ply_reader.isBinary())
         {
-            for (int j = 0; j < m_cols; ++j)
+            points.resize(3 * ply_reader.getVertexCount());
+            ply_reader.readPoints(points.data());
+
+            // Beam IDs are only read when the projection lookup table is enabled and the driver recorded them
+            if (p_scan_lidar_interface != nullptr && p_scan_lidar_interface->getUseProjectionLut() && ply_reader.hasProperty(p_scan_lidar_interface->getBeamIDProperty()))
             {
-                for (int k = 0; k < m_channels; ++k)
-                {
-                    getElement(i, j, k) = data_vec[counter++];
-                }
+                std::vector<double> beam_values(ply_reader.getVertexCount());
+                ply_reader.readProperty(p_scan_lidar_interface->getBeamIDProperty(), beam_values.data());
+                beam_ids.assign(beam_values.begin(), beam_values.end());
             }
         }
-    }
-    else if (extension == ".ply")
-    {
-        open3d::geometry::PointCloud pcd;
-        open3d::io::ReadPointCloudOption option;
-        open3d::io::ReadPointCloudFromPLY(file_path, pcd, option);
-        try
+        else
         {
-            const auto& scan_lidar_interface = dynamic_cast<const ScanningLidarInterface&>(sensor_interface);
-            scan_lidar_interface.pcdConditioner(pcd);
-            organizePcd(pcd.points_, scan_lidar_interface.getFilterSize());
+            open3d::geometry::PointCloud pcd;
+            open3d::io::ReadPointCloudOption option;
+            open3d::io::ReadPointCloudFromPLY(file_path, pcd, option);
+            points.reserve(3 * pcd.points_.size());
+            for (const auto& point : pcd.points_)
+            {
+                points.insert(points.end(), {static_cast<float>(point[0]), static_cast<float>(point[1]), static_cast<float>(point[2])});
+            }
         }
-        catch (const std::bad_cast& e)
+        if (p_scan_lidar_interface == nullptr)
         {
             throw std::runtime_error("File format requires a 'ScanningLidarInterface' object.");
         }
+        organizePcd(points, beam_ids, *p_scan_lidar_interface);
     }
     else if (extension == ".npz")
     {
@@ -257,4 +186,9 @@ void GridFrame::load(const std::string& file_path, const SensorInterface& sensor
     {
         throw std::runtime_error("Invalid file format loading point cloud data.");
     }
+}
+
+std::shared_ptr<GenericDataFrame> GridFrame::clone() const
+{
+    return cloneAs<GridFrame>();
 }
\ No newline at end of file
@@ -9,6 +9,8 @@ class SensorInterface;
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/ImageCodec.h"
+
 MaskFrame::MaskFrame(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface)
     : DataFrame(p_cam_params, p_extrinsic)
 {
@@ -39,15 +41,19 @@ void MaskFrame::fromCvMat(const cv::Mat& mat)
     }
 }
 
-void MaskFrame::save(const std::string& file_path)
+void MaskFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
 {
-    const std::shared_ptr<cv::Mat> p_mat = asCvMat();
-    cv::imwrite(file_path + ".png", *p_mat);
+    // Masks are stored as 0 or 1 bytes, saved as 0 or 255 in viewable formats
+    image_codec::save(file_path, reinterpret_cast<const unsigned char*>(getData().data()), m_rows, m_cols, m_channels, encoding_params, true);
 }
 
 void MaskFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
 {
-    const cv::Mat mat = cv::imread(file_path, cv::IMREAD_GRAYSCALE);
-    initializeTensor(mat.rows, mat.cols, mat.channels());
-    fromCvMat(mat);
+    const std::shared_ptr<Eigen::Tensor<unsigned char, 3>> p_image = image_codec::load(file_path, 1);
+    setTensor(std::make_shared<Eigen::Tensor<bool, 3>>(p_image->cast<bool>()));
+}
+
+std::shared_ptr<GenericDataFrame> MaskFrame::clone() const
+{
+    return cloneAs<MaskFrame>();
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "listener_frames/NormalFrame.h"
+
+class SensorInterface;
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <opencv2/core.hpp>
+
+#include "listener_utils/NpyReader.h"
+#include "listener_utils/NpyWriter.h"
+
+NormalFrame::NormalFrame(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface)
+    : DataFrame(p_cam_params, p_extrinsic)
+{
+    load(file_path, sensor_interface);
+}
+
+std::shared_ptr<cv::Mat> NormalFrame::asCvMat() const
+{
+    auto p_mat = std::make_shared<cv::Mat>(m_rows, m_cols, CV_32FC3);
+    for (int i = 0; i < m_rows; ++i)
+    {
+        for (int j = 0; j < m_cols; ++j)
+        {
+            for (int k = 0; k < m_channels; ++k)
+            {
+                p_mat->at<cv::Vec3f>(i, j)[k] = getElement(i, j, k);
+            }
+        }
+    }
+    return p_mat;
+}
+
+void NormalFrame::fromCvMat(const cv::Mat& mat)
+{
+    for (int i = 0; i < m_rows; ++i)
+    {
+        for (int j = 0; j < m_cols; ++j)
+        {
+            for (int k = 0; k < m_channels; ++k)
+            {
+                getElement(i, j, k) = mat.at<cv::Vec3f>(i, j)[k];
+            }
+        }
+    }
+}
+
+void NormalFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
+{
+    NpyWriter::save(file_path + ".npy", getData(), encoding_params.m_npyWriterPtr);
+}
+
+void NormalFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
+{
+    const NpyReader npy_reader(file_path);
+    const std::vector<size_t>& shape = npy_reader.getShape();
+    if (shape[2] != 3)
+    {
+        throw std::runtime_error("Normal data must have three channels.");
+    }
+    auto p_tensor = std::make_shared<Eigen::Tensor<float, 3>>(static_cast<Eigen::Index>(shape[0]), static_cast<Eigen::Index>(shape[1]), static_cast<Eigen::Index>(shape[2]));
+    npy_reader.readTensor(*p_tensor);
+    setTensor(p_tensor);
+}
+
+std::shared_ptr<GenericDataFrame> NormalFrame::clone() const
+{
+    return cloneAs<NormalFrame>();
+}
@@ -9,6 +9,8 @@ class SensorInterface;
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/ImageCodec.h"
+
 RGBFrame::RGBFrame(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface)
     : DataFrame(p_cam_params, p_extrinsic)
 {
@@ -45,17 +47,17 @@ void RGBFrame::fromCvMat(const cv::Mat& mat)
     }
 }
 
-void RGBFrame::save(const std::string& file_path)
+void RGBFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
 {
-    const std::shared_ptr<cv::Mat> p_mat = asCvMat();
-    cv::cvtColor(*p_mat, *p_mat, cv::COLOR_RGB2BGR);
-    cv::imwrite(file_path + ".png", *p_mat);
+    image_codec::save(file_path, getData().data(), m_rows, m_cols, m_channels, encoding_params);
 }
 
 void RGBFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
 {
-    cv::Mat mat = cv::imread(file_path, cv::IMREAD_COLOR);
-    cv::cvtColor(mat, mat, cv::COLOR_BGR2RGB);
-    initializeTensor(mat.rows, mat.cols, mat.channels());
-    fromCvMat(mat);
+    setTensor(image_codec::load(file_path, 3));
+}
+
+std::shared_ptr<GenericDataFrame> RGBFrame::clone() const
+{
+    return cloneAs<RGBFrame>();
 }
\ No newline at end of file
@@ -5,12 +5,17 @@ class SensorInterface;
 #include <string>
 #include <vector>
 #include <memory>
+#include <stdexcept>
+#include <filesystem>
 
-#include <npy.hpp>
 #include <Eigen/Dense>
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <opencv2/core.hpp>
 
+#include "listener_utils/NpyReader.h"
+#include "listener_utils/NpyWriter.h"
+#include "listener_utils/GridCodec.h"
+
 TempFrame::TempFrame(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const SensorInterface& sensor_interface)
     : DataFrame(p_cam_params, p_extrinsic)
 {
@@ -41,37 +46,38 @@ void TempFrame::fromCvMat(const cv::Mat& mat)
     }
 }
 
-void TempFrame::save(const std::string& file_path)
+void TempFrame::save(const std::string& file_path, const EncodingParameters& encoding_params)
 {
-    std::vector<float> grid_vec;
-    for (int i = 0; i < m_rows; ++i)
+    if (encoding_params.m_gridEncoding == GridEncoding::GRID_CODEC)
     {
-        for (int j = 0; j < m_cols; ++j)
-        {
-            grid_vec.push_back(getElement(i, j, 0));
-        }
+        grid_codec::save(file_path + grid_codec::fileExtension, getData(), encoding_params.m_gridQuantization);
+        return;
     }
-
-    npy::npy_data_ptr<float> data;
-    data.data_ptr = grid_vec.data();
-    data.shape = { static_cast<unsigned long>(m_rows), static_cast<unsigned long>(m_cols), static_cast<unsigned long>(m_channels) };
-    data.fortran_order = false;
-    npy::write_npy(file_path + ".npy", data);
+    NpyWriter::save(file_path + ".npy", getData(), encoding_params.m_npyWriterPtr);
 }
 
 void TempFrame::load(const std::string& file_path, const SensorInterface& sensor_interface)
 {
-    const npy::npy_data data = npy::read_npy<float>(file_path);
-    const std::vector<float> data_vec = data.data;
-    const std::vector<unsigned long> shape = data.shape;
-
-    initializeTensor(shape[0], shape[1], 1);
-    int counter = 0;
-    for (int i = 0; i < m_rows; ++i)
+    std::shared_ptr<Eigen::Tensor<float, 3>> p_tensor;
+    if (std::filesystem::path(file_path).extension() == grid_codec::fileExtension)
     {
-        for (int j = 0; j < m_cols; ++j)
-        {
-            getElement(i, j, 0) = data_vec[counter++];
-        }
+        p_tensor = grid_codec::load(file_path);
     }
+    else
+    {
+        const NpyReader npy_reader(file_path);
+        const std::vector<size_t>& shape = npy_reader.getShape();
+        p_tensor = std::make_shared<Eigen::Tensor<float, 3>>(static_cast<Eigen::Index>(shape[0]), static_cast<Eigen::Index>(shape[1]), static_cast<Eigen::Index>(shape[2]));
+        npy_reader.readTensor(*p_tensor);
+    }
+    if (p_tensor->dimension(2) != 1)
+    {
+        throw std::runtime_error("Temperature data must have a single channel.");
+    }
+    setTensor(p_tensor);
+}
+
+std::shared_ptr<GenericDataFrame> TempFrame::clone() const
+{
+    return cloneAs<TempFrame>();
 }
\ No newline at end of file
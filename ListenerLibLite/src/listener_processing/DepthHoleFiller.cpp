@@ -0,0 +1,380 @@
+#include "listener_processing/DepthHoleFiller.h"
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <opencv2/core.hpp>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/GrayFrame.h"
+#include "listener_frames/CompositeFrame.h"
+
+namespace
+{
+    constexpr float noDepth = std::numeric_limits<float>::infinity();
+    constexpr int rowChunk = 8;
+
+    /*!
+     * @brief Returns the largest depth a neighbour may have to be used for a hole whose nearest foreground depth is given.
+     */
+    inline float foregroundLimit(const float min_depth, const float max_depth_jump_factor)
+    {
+        return max_depth_jump_factor > 0.0f ? min_depth * (1.0f + max_depth_jump_factor) : noDepth;
+    }
+}
+
+void DepthHoleFiller::fillJointBilateral(const float* p_src, float* p_dst, const unsigned char* p_guide, const int rows, const int cols) const
+{
+    const int radius = std::max(1, m_params.m_radius);
+    const int window = 2 * radius + 1;
+    const int min_neighbours = std::max(1, m_params.m_minValidNeighbours);
+
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            const int top = std::max(0, i - radius);
+            const int btm = std::min(rows - 1, i + radius);
+            for (int j = 0; j < cols; ++j)
+            {
+                const size_t pixel = static_cast<size_t>(i) * cols + j;
+                if (p_src[pixel] > 0.0f)
+                {
+                    continue;
+                }
+                const int lft = std::max(0, j - radius);
+                const int rgt = std::min(cols - 1, j + radius);
+
+                // Nearest foreground depth in the window sets the discontinuity guard
+                float min_depth = noDepth;
+                for (int n = top; n <= btm; ++n)
+                {
+                    const float* p_row = p_src + static_cast<size_t>(n) * cols;
+                    for (int m = lft; m <= rgt; ++m)
+                    {
+                        min_depth = std::min(min_depth, p_row[m] > 0.0f ? p_row[m] : noDepth);
+                    }
+                }
+                if (min_depth == noDepth)
+                {
+                    continue;
+                }
+                const float limit = foregroundLimit(min_depth, m_params.m_maxDepthJumpFactor);
+
+                const int guide_centre = p_guide != nullptr ? p_guide[pixel] : 0;
+                float weighted_sum = 0.0f;
+                float weight_sum = 0.0f;
+                int count = 0;
+                for (int n = top; n <= btm; ++n)
+                {
+                    const float* p_row = p_src + static_cast<size_t>(n) * cols;
+                    const float* p_spatial = m_spatialWeights.data() + (n - i + radius) * window + radius;
+                    for (int m = lft; m <= rgt; ++m)
+                    {
+                        const float depth = p_row[m];
+                        const bool valid = depth > 0.0f && depth <= limit;
+                        const float guide_weight = p_guide != nullptr ? m_guideWeights[std::abs(p_guide[static_cast<size_t>(n) * cols + m] - guide_centre)] : 1.0f;
+                        const float weight = valid ? p_spatial[m - j] * guide_weight : 0.0f;
+                        weighted_sum += weight * depth;
+                        weight_sum += weight;
+                        count += valid;
+                    }
+                }
+                if (count >= min_neighbours && weight_sum > 0.0f)
+                {
+                    p_dst[pixel] = weighted_sum / weight_sum;
+                }
+            }
+        }
+    }, m_params.m_numThreads, rowChunk);
+}
+
+void DepthHoleFiller::fillNearestValid(const float* p_src, float* p_dst, const int rows, const int cols) const
+{
+    const int radius = std::max(1, m_params.m_radius);
+    const int window = 2 * radius + 1;
+
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            const int top = std::max(0, i - radius);
+            const int btm = std::min(rows - 1, i + radius);
+            for (int j = 0; j < cols; ++j)
+            {
+                const size_t pixel = static_cast<size_t>(i) * cols + j;
+                if (p_src[pixel] > 0.0f)
+                {
+                    continue;
+                }
+                const int lft = std::max(0, j - radius);
+                const int rgt = std::min(cols - 1, j + radius);
+
+                // Closest ring of valid neighbours, and the nearest foreground depth on it
+                int best_ring = window;
+                float min_depth = noDepth;
+                for (int n = top; n <= btm; ++n)
+                {
+                    const float* p_row = p_src + static_cast<size_t>(n) * cols;
+                    const int* p_rings = m_ringDistances.data() + (n - i + radius) * window + radius;
+                    for (int m = lft; m <= rgt; ++m)
+                    {
+                        const int ring = p_row[m] > 0.0f ? p_rings[m - j] : window;
+                        const float depth = p_row[m] > 0.0f ? p_row[m] : noDepth;
+                        min_depth = ring < best_ring ? depth : (ring == best_ring ? std::min(min_depth, depth) : min_depth);
+                        best_ring = std::min(best_ring, ring);
+                    }
+                }
+                if (best_ring == window)
+                {
+                    continue;
+                }
+                const float limit = foregroundLimit(min_depth, m_params.m_maxDepthJumpFactor);
+
+                float sum = 0.0f;
+                int count = 0;
+                for (int n = top; n <= btm; ++n)
+                {
+                    const float* p_row = p_src + static_cast<size_t>(n) * cols;
+                    const int* p_rings = m_ringDistances.data() + (n - i + radius) * window + radius;
+                    for (int m = lft; m <= rgt; ++m)
+                    {
+                        const bool used = p_rings[m - j] == best_ring && p_row[m] > 0.0f && p_row[m] <= limit;
+                        sum += used ? p_row[m] : 0.0f;
+                        count += used;
+                    }
+                }
+                p_dst[pixel] = sum / static_cast<float>(count);
+            }
+        }
+    }, m_params.m_numThreads, rowChunk);
+}
+
+void DepthHoleFiller::fillPushPull(float* p_depth, const int rows, const int cols) const
+{
+    // Coarsest cells span about twice the window radius
+    const int radius = std::max(1, m_params.m_radius);
+    const int num_levels = std::max(1, static_cast<int>(std::floor(std::log2(2.0 * radius))));
+    std::vector<std::vector<float>> pyramid(num_levels);
+    std::vector<int> level_rows(num_levels + 1, rows);
+    std::vector<int> level_cols(num_levels + 1, cols);
+    std::vector<float*> levels(num_levels + 1, p_depth);
+
+    // Push valid depths down the pyramid, averaging only the foreground children of each cell
+    for (int l = 1; l <= num_levels; ++l)
+    {
+        const int fine_rows = level_rows[l - 1];
+        const int fine_cols = level_cols[l - 1];
+        level_rows[l] = (fine_rows + 1) / 2;
+        level_cols[l] = (fine_cols + 1) / 2;
+        pyramid[l - 1].assign(static_cast<size_t>(level_rows[l]) * level_cols[l], 0.0f);
+        levels[l] = pyramid[l - 1].data();
+        const float* p_fine = levels[l - 1];
+        float* p_coarse = levels[l];
+        const int coarse_cols = level_cols[l];
+
+        listener_utils::parallelFor(0, level_rows[l], [&](const int row_begin, const int row_end)
+        {
+            for (int i = row_begin; i < row_end; ++i)
+            {
+                const float* p_row0 = p_fine + static_cast<size_t>(2 * i) * fine_cols;
+                const float* p_row1 = p_fine + static_cast<size_t>(std::min(2 * i + 1, fine_rows - 1)) * fine_cols;
+                for (int j = 0; j < coarse_cols; ++j)
+                {
+                    const int j1 = std::min(2 * j + 1, fine_cols - 1);
+                    const float children[4] = {p_row0[2 * j], p_row0[j1], p_row1[2 * j], p_row1[j1]};
+                    float min_depth = noDepth;
+                    for (const float child : children)
+                    {
+                        min_depth = std::min(min_depth, child > 0.0f ? child : noDepth);
+                    }
+                    const float limit = foregroundLimit(min_depth, m_params.m_maxDepthJumpFactor);
+                    float sum = 0.0f;
+                    int count = 0;
+                    for (const float child : children)
+                    {
+                        const bool used = child > 0.0f && child <= limit;
+                        sum += used ? child : 0.0f;
+                        count += used;
+                    }
+                    p_coarse[static_cast<size_t>(i) * coarse_cols + j] = count > 0 ? sum / static_cast<float>(count) : 0.0f;
+                }
+            }
+        }, m_params.m_numThreads, rowChunk);
+    }
+
+    // Pull coarse depths back up into the holes of each finer level
+    for (int l = num_levels - 1; l >= 0; --l)
+    {
+        float* p_fine = levels[l];
+        const float* p_coarse = levels[l + 1];
+        const int fine_cols = level_cols[l];
+        const int coarse_cols = level_cols[l + 1];
+
+        listener_utils::parallelFor(0, level_rows[l], [&](const int row_begin, const int row_end)
+        {
+            for (int i = row_begin; i < row_end; ++i)
+            {
+                float* p_row = p_fine + static_cast<size_t>(i) * fine_cols;
+                const float* p_parent_row = p_coarse + static_cast<size_t>(i / 2) * coarse_cols;
+                for (int j = 0; j < fine_cols; ++j)
+                {
+                    p_row[j] = p_row[j] > 0.0f ? p_row[j] : p_parent_row[j / 2];
+                }
+            }
+        }, m_params.m_numThreads, rowChunk);
+    }
+}
+
+DepthHoleFiller::DepthHoleFiller(const HoleFillParameters& params)
+    : m_params(params)
+{
+    // Window tables are indexed by (row offset + radius) * window + (column offset + radius)
+    const int radius = std::max(1, m_params.m_radius);
+    const int window = 2 * radius + 1;
+    m_spatialWeights.resize(window * window);
+    m_ringDistances.resize(window * window);
+    for (int di = -radius; di <= radius; ++di)
+    {
+        for (int dj = -radius; dj <= radius; ++dj)
+        {
+            const int index = (di + radius) * window + (dj + radius);
+            const float distance_sq = static_cast<float>(di * di + dj * dj);
+            m_spatialWeights[index] = m_params.m_spatialSigma > 0.0f ? std::exp(-distance_sq / (2.0f * m_params.m_spatialSigma * m_params.m_spatialSigma)) : 1.0f;
+            m_ringDistances[index] = std::max(std::abs(di), std::abs(dj));
+        }
+    }
+    m_guideWeights.resize(256);
+    for (int delta = 0; delta < 256; ++delta)
+    {
+        const auto delta_sq = static_cast<float>(delta * delta);
+        m_guideWeights[delta] = m_params.m_guideSigma > 0.0f ? std::exp(-delta_sq / (2.0f * m_params.m_guideSigma * m_params.m_guideSigma)) : 1.0f;
+    }
+}
+
+const HoleFillParameters& DepthHoleFiller::getParams() const
+{
+    return m_params;
+}
+
+void DepthHoleFiller::fill(cv::Mat& depth_image, const cv::Mat& guide_image) const
+{
+    if (depth_image.type() != CV_32FC1 || !depth_image.isContinuous())
+    {
+        throw std::runtime_error("Hole filling requires a continuous single channel float depth image.");
+    }
+    const int rows = depth_image.rows;
+    const int cols = depth_image.cols;
+    const unsigned char* p_guide = nullptr;
+    if (!guide_image.empty())
+    {
+        if (guide_image.type() != CV_8UC1 || !guide_image.isContinuous() || guide_image.rows != rows || guide_image.cols != cols)
+        {
+            throw std::runtime_error("Hole filling guide image must be a continuous single channel 8-bit image matching the depth resolution.");
+        }
+        p_guide = guide_image.ptr<unsigned char>(0);
+    }
+
+    float* p_depth = depth_image.ptr<float>(0);
+    switch (m_params.m_mode)
+    {
+    case HoleFillMode::JOINT_BILATERAL:
+    {
+        const std::vector<float> src(p_depth, p_depth + static_cast<size_t>(rows) * cols);
+        fillJointBilateral(src.data(), p_depth, p_guide, rows, cols);
+        break;
+    }
+    case HoleFillMode::NEAREST_VALID:
+    {
+        const std::vector<float> src(p_depth, p_depth + static_cast<size_t>(rows) * cols);
+        fillNearestValid(src.data(), p_depth, rows, cols);
+        break;
+    }
+    case HoleFillMode::PUSH_PULL:
+        fillPushPull(p_depth, rows, cols);
+        break;
+    }
+}
+
+void DepthHoleFiller::process(CompositeFrame& composite_frame)
+{
+    if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+    {
+        return;
+    }
+    const auto p_grid_frame = std::static_pointer_cast<GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+    const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+    const std::shared_ptr<CamParameters> p_cam_params = p_grid_frame->getCamParams();
+    if (p_cam_params == nullptr || p_cam_params->m_intrinsicPtr == nullptr)
+    {
+        throw std::runtime_error("Hole filling a point cloud grid requires camera intrinsics.");
+    }
+    const int rows = p_grid_frame->getRows();
+    const int cols = p_grid_frame->getCols();
+
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    float* p_grid = p_grid_frame->getData().data();
+    bool* p_mask = p_mask_frame->getData().data();
+    cv::Mat depth_image(rows, cols, CV_32FC1);
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            auto* p_row = depth_image.ptr<float>(i);
+            for (int j = 0; j < cols; ++j)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                p_row[j] = p_mask[pixel] ? p_grid[pixel + 2 * plane] : 0.0f;
+            }
+        }
+    }, m_params.m_numThreads, rowChunk);
+
+    cv::Mat guide_image;
+    if (composite_frame.has(FrameID::GRAYSCALE_IMAGE))
+    {
+        const auto p_gray_frame = std::static_pointer_cast<const GrayFrame>(composite_frame.getFrame(FrameID::GRAYSCALE_IMAGE));
+        if (p_gray_frame->getRows() == rows && p_gray_frame->getCols() == cols)
+        {
+            guide_image = *p_gray_frame->asCvMat();
+        }
+    }
+    fill(depth_image, guide_image);
+
+    // Deproject filled pixels along their pinhole rays
+    const Eigen::Matrix3f& intrinsic = *p_cam_params->m_intrinsicPtr;
+    const float inv_fx = 1.0f / intrinsic(0, 0);
+    const float inv_fy = 1.0f / intrinsic(1, 1);
+    const float cx = intrinsic(0, 2);
+    const float cy = intrinsic(1, 2);
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            const auto* p_row = depth_image.ptr<float>(i);
+            for (int j = 0; j < cols; ++j)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                if (p_mask[pixel] || p_row[j] <= 0.0f)
+                {
+                    continue;
+                }
+                p_grid[pixel] = (static_cast<float>(j) - cx) * p_row[j] * inv_fx;
+                p_grid[pixel + plane] = (static_cast<float>(i) - cy) * p_row[j] * inv_fy;
+                p_grid[pixel + 2 * plane] = p_row[j];
+                p_mask[pixel] = true;
+            }
+        }
+    }, m_params.m_numThreads, rowChunk);
+}
@@ -0,0 +1,155 @@
+#include "listener_processing/DepthMedianFilter.h"
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <opencv2/core.hpp>
+
+#include "listener_utils/parallel_utils.hpp"
+
+namespace
+{
+    constexpr int laneCount = 8;
+    constexpr int rowChunk = 4;
+
+    using Lanes = Eigen::Array<float, laneCount, 1>;
+    using LaneVector = std::vector<Lanes, Eigen::aligned_allocator<Lanes>>;
+
+    /*!
+     * @brief Generates the comparators of a Batcher odd-even merge sorting network for a power of two number of elements.
+     */
+    std::vector<std::pair<int, int>> oddEvenMergeNetwork(const int size)
+    {
+        std::vector<std::pair<int, int>> network;
+        for (int p = 1; p < size; p *= 2)
+        {
+            for (int k = p; k >= 1; k /= 2)
+            {
+                for (int j = k % p; j <= size - 1 - k; j += 2 * k)
+                {
+                    for (int i = 0; i <= std::min(k - 1, size - j - k - 1); ++i)
+                    {
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                        {
+                            network.emplace_back(i + j, i + j + k);
+                        }
+                    }
+                }
+            }
+        }
+        return network;
+    }
+}
+
+DepthMedianFilter::DepthMedianFilter(const int kernel_size, const unsigned int num_threads)
+    : m_kernelSize(kernel_size), m_halfWindow((std::max(1, kernel_size) + 1) / 2), m_numThreads(num_threads)
+{
+    // One network per power of two up to the full window size
+    const int window_size = 4 * m_halfWindow * m_halfWindow;
+    for (int size = 1; ; size *= 2)
+    {
+        m_networks.push_back(oddEvenMergeNetwork(size));
+        if (size >= window_size)
+        {
+            break;
+        }
+    }
+}
+
+int DepthMedianFilter::getKernelSize() const
+{
+    return m_kernelSize;
+}
+
+void DepthMedianFilter::filter(const cv::Mat& depth_image, cv::Mat& filtered_image) const
+{
+    if (depth_image.type() != CV_32FC1)
+    {
+        throw std::runtime_error("Median filter requires a single channel float depth image.");
+    }
+    const int rows = depth_image.rows;
+    const int cols = depth_image.cols;
+    const cv::Mat src = depth_image.data == filtered_image.data ? depth_image.clone() : depth_image;
+    if (filtered_image.rows != rows || filtered_image.cols != cols || filtered_image.type() != CV_32FC1)
+    {
+        filtered_image = cv::Mat(rows, cols, CV_32FC1);
+    }
+
+    const int half_window = m_halfWindow;
+    const int max_network_size = 1 << (static_cast<int>(m_networks.size()) - 1);
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        // Lane l of element e holds the e-th gathered depth of the l-th pixel in the batch
+        LaneVector elements(max_network_size);
+        int counts[laneCount];
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            const int window_top = std::max(0, i - half_window);
+            const int window_btm = std::min(rows, i + half_window);
+            auto* p_out = filtered_image.ptr<float>(i);
+            for (int j0 = 0; j0 < cols; j0 += laneCount)
+            {
+                int max_count = 0;
+                for (int l = 0; l < laneCount; ++l)
+                {
+                    const int j = j0 + l;
+                    int count = 0;
+                    if (j < cols)
+                    {
+                        const int window_lft = std::max(0, j - half_window);
+                        const int window_rgt = std::min(cols, j + half_window);
+                        for (int n = window_top; n < window_btm; ++n)
+                        {
+                            const auto* p_row = src.ptr<float>(n);
+                            for (int m = window_lft; m < window_rgt; ++m)
+                            {
+                                // Branchless compaction, the slot is overwritten unless the depth is valid
+                                elements[count][l] = p_row[m];
+                                count += p_row[m] > 0.0f;
+                            }
+                        }
+                    }
+                    counts[l] = count;
+                    max_count = std::max(max_count, count);
+                }
+                if (max_count == 0)
+                {
+                    std::fill(p_out + j0, p_out + std::min(cols, j0 + laneCount), 0.0f);
+                    continue;
+                }
+
+                // Pad every lane to the network size so that missing depths sort last
+                int level = 0;
+                while ((1 << level) < max_count)
+                {
+                    ++level;
+                }
+                const int network_size = 1 << level;
+                for (int l = 0; l < laneCount; ++l)
+                {
+                    for (int e = counts[l]; e < network_size; ++e)
+                    {
+                        elements[e][l] = std::numeric_limits<float>::max();
+                    }
+                }
+                for (const auto& comparator : m_networks[level])
+                {
+                    Lanes& lower = elements[comparator.first];
+                    Lanes& upper = elements[comparator.second];
+                    const Lanes minimum = lower.min(upper);
+                    upper = lower.max(upper);
+                    lower = minimum;
+                }
+
+                for (int l = 0; l < laneCount && j0 + l < cols; ++l)
+                {
+                    p_out[j0 + l] = counts[l] > 0 ? elements[(counts[l] - 1) / 2][l] : 0.0f;
+                }
+            }
+        }
+    }, m_numThreads, rowChunk);
+}
@@ -0,0 +1,335 @@
+#include "listener_processing/GridDownsampler.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/PointCloudBuffer.h"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/CompositeFrame.h"
+
+namespace
+{
+    struct VoxelAccumulator
+    {
+        float m_sum[3] = {0.0f, 0.0f, 0.0f};
+        uint32_t m_count = 0;
+        uint32_t m_firstPixel = 0;
+    };
+
+    uint64_t voxelKey(const float x, const float y, const float z, const float inv_voxel_size)
+    {
+        // Pack the three signed voxel coordinates into 21 bits each
+        constexpr int64_t offset = int64_t{1} << 20;
+        constexpr uint64_t bits = (uint64_t{1} << 21) - 1;
+        const auto kx = static_cast<uint64_t>(static_cast<int64_t>(std::floor(x * inv_voxel_size)) + offset) & bits;
+        const auto ky = static_cast<uint64_t>(static_cast<int64_t>(std::floor(y * inv_voxel_size)) + offset) & bits;
+        const auto kz = static_cast<uint64_t>(static_cast<int64_t>(std::floor(z * inv_voxel_size)) + offset) & bits;
+        return kx | (ky << 21) | (kz << 42);
+    }
+
+    /*!
+     * @brief Helper function to scale camera parameters to the resolution of BLOCK mode output.
+     *
+     * Points map to pixel floor(u), so pixel edges rather than centres sit at integer coordinates and the principal point
+     * scales like the focal lengths, keeping rows = 2 * cy and cols = 2 * cx.
+     */
+    std::shared_ptr<CamParameters> scaleToBlocks(const std::shared_ptr<CamParameters>& p_cam_params, const int block_size)
+    {
+        if (p_cam_params == nullptr || block_size <= 1)
+        {
+            return p_cam_params;
+        }
+        auto p_intrinsic = std::make_shared<Eigen::Matrix3f>(*p_cam_params->m_intrinsicPtr);
+        p_intrinsic->block<2, 3>(0, 0) /= static_cast<float>(block_size);
+        return std::make_shared<CamParameters>(p_intrinsic, p_cam_params->m_distortionPtr);
+    }
+
+    uint64_t mixKey(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return key;
+    }
+}
+
+int GridDownsampler::getEffectiveBlockSize(const int rows, const int cols) const
+{
+    int block_size = std::max(1, m_params.m_blockSize);
+    if (m_params.m_pointBudget > 0)
+    {
+        const auto num_pixels = static_cast<double>(rows) * cols;
+        block_size = std::max(block_size, static_cast<int>(std::floor(std::sqrt(num_pixels / m_params.m_pointBudget))));
+        while (static_cast<size_t>((rows + block_size - 1) / block_size) * ((cols + block_size - 1) / block_size) > m_params.m_pointBudget
+               && block_size < std::max(rows, cols))
+        {
+            ++block_size;
+        }
+    }
+    return block_size;
+}
+
+std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> GridDownsampler::downsampleBlock(const GridFrame& grid_frame, const MaskFrame& mask_frame) const
+{
+    const int rows = grid_frame.getRows();
+    const int cols = grid_frame.getCols();
+    const int block_size = getEffectiveBlockSize(rows, cols);
+    const int out_rows = (rows + block_size - 1) / block_size;
+    const int out_cols = (cols + block_size - 1) / block_size;
+
+    auto p_out_grid = std::make_shared<Eigen::Tensor<float, 3>>(out_rows, out_cols, 3);
+    auto p_out_mask = std::make_shared<Eigen::Tensor<bool, 3>>(out_rows, out_cols, 1);
+    p_out_grid->setZero();
+    p_out_mask->setConstant(false);
+
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    const size_t out_plane = static_cast<size_t>(out_rows) * out_cols;
+    const float* p_grid = grid_frame.getData().data();
+    const bool* p_mask = mask_frame.getData().data();
+    float* p_out = p_out_grid->data();
+    bool* p_out_valid = p_out_mask->data();
+
+    listener_utils::parallelFor(0, out_rows, [&](const int row_begin, const int row_end)
+    {
+        std::vector<float> sums(3 * out_cols);
+        std::vector<uint32_t> counts(out_cols);
+        for (int oi = row_begin; oi < row_end; ++oi)
+        {
+            std::fill(sums.begin(), sums.end(), 0.0f);
+            std::fill(counts.begin(), counts.end(), 0u);
+            const int i_end = std::min(rows, (oi + 1) * block_size);
+            for (int j = 0; j < cols; ++j)
+            {
+                const int oj = j / block_size;
+                for (int i = oi * block_size; i < i_end; ++i)
+                {
+                    const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                    if (p_mask[pixel])
+                    {
+                        sums[3 * oj] += p_grid[pixel];
+                        sums[3 * oj + 1] += p_grid[pixel + plane];
+                        sums[3 * oj + 2] += p_grid[pixel + 2 * plane];
+                        ++counts[oj];
+                    }
+                }
+            }
+            for (int oj = 0; oj < out_cols; ++oj)
+            {
+                if (counts[oj] == 0)
+                {
+                    continue;
+                }
+                const size_t out_pixel = listener_utils::planeIndex(oi, oj, out_rows);
+                const float inv_count = 1.0f / static_cast<float>(counts[oj]);
+                for (int k = 0; k < 3; ++k)
+                {
+                    p_out[out_pixel + k * out_plane] = sums[3 * oj + k] * inv_count;
+                }
+                p_out_valid[out_pixel] = true;
+            }
+        }
+    }, m_params.m_numThreads);
+
+    const std::shared_ptr<CamParameters> p_cam_params = scaleToBlocks(grid_frame.getCamParams(), block_size);
+    return {std::make_shared<GridFrame>(p_out_grid, p_cam_params, grid_frame.getExtrinsic()),
+            std::make_shared<MaskFrame>(p_out_mask, p_cam_params, mask_frame.getExtrinsic())};
+}
+
+std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> GridDownsampler::downsampleVoxel(const GridFrame& grid_frame, const MaskFrame& mask_frame) const
+{
+    if (m_params.m_voxelSize <= 0.0f)
+    {
+        throw std::runtime_error("Voxel size must be positive.");
+    }
+    const int rows = grid_frame.getRows();
+    const int cols = grid_frame.getCols();
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    const float* p_grid = grid_frame.getData().data();
+    const bool* p_mask = mask_frame.getData().data();
+    const float inv_voxel_size = 1.0f / m_params.m_voxelSize;
+
+    // Gather voxel keys of masked points in row-major pixel order, rows in parallel
+    std::vector<size_t> row_offsets(rows + 1, 0);
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            size_t count = 0;
+            for (int j = 0; j < cols; ++j)
+            {
+                count += p_mask[listener_utils::planeIndex(i, j, rows)];
+            }
+            row_offsets[i + 1] = count;
+        }
+    }, m_params.m_numThreads);
+    for (int i = 0; i < rows; ++i)
+    {
+        row_offsets[i + 1] += row_offsets[i];
+    }
+    const size_t num_points = row_offsets[rows];
+    const int num_partitions = static_cast<int>(listener_utils::getNumThreads(m_params.m_numThreads));
+    std::vector<uint64_t> keys(num_points);
+    std::vector<uint32_t> pixels(num_points);
+    std::vector<uint32_t> partitions(num_points);
+    listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            size_t m = row_offsets[i];
+            for (int j = 0; j < cols; ++j)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                if (p_mask[pixel])
+                {
+                    keys[m] = voxelKey(p_grid[pixel], p_grid[pixel + plane], p_grid[pixel + 2 * plane], inv_voxel_size);
+                    pixels[m] = static_cast<uint32_t>(pixel);
+                    partitions[m] = static_cast<uint32_t>(mixKey(keys[m]) % num_partitions);
+                    ++m;
+                }
+            }
+        }
+    }, m_params.m_numThreads);
+
+    // Each partition owns the voxels whose mixed key maps to it. Points are bucketed by partition with a stable counting
+    // sort, so each partition walks only its own points in row-major order and accumulates without locking.
+    std::vector<size_t> offsets(num_partitions + 1, 0);
+    for (size_t m = 0; m < num_points; ++m)
+    {
+        ++offsets[partitions[m] + 1];
+    }
+    for (int part = 0; part < num_partitions; ++part)
+    {
+        offsets[part + 1] += offsets[part];
+    }
+    std::vector<uint32_t> buckets(num_points);
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t m = 0; m < num_points; ++m)
+    {
+        buckets[fill[partitions[m]]++] = static_cast<uint32_t>(m);
+    }
+
+    std::vector<std::vector<VoxelAccumulator>> partition_voxels(num_partitions);
+    listener_utils::parallelFor(0, num_partitions, [&](const int part_begin, const int part_end)
+    {
+        for (int part = part_begin; part < part_end; ++part)
+        {
+            std::unordered_map<uint64_t, uint32_t> slot_map;
+            std::vector<VoxelAccumulator>& voxels = partition_voxels[part];
+            for (size_t b = offsets[part]; b < offsets[part + 1]; ++b)
+            {
+                const uint32_t m = buckets[b];
+                const auto result = slot_map.try_emplace(keys[m], static_cast<uint32_t>(voxels.size()));
+                if (result.second)
+                {
+                    voxels.emplace_back();
+                    voxels.back().m_firstPixel = pixels[m];
+                }
+                VoxelAccumulator& voxel = voxels[result.first->second];
+                for (int k = 0; k < 3; ++k)
+                {
+                    voxel.m_sum[k] += p_grid[pixels[m] + k * plane];
+                }
+                ++voxel.m_count;
+            }
+        }
+    }, m_params.m_numThreads, 1);
+
+    // Write each voxel mean to its first pixel and mask out all other pixels
+    auto p_out_grid = std::make_shared<Eigen::Tensor<float, 3>>(rows, cols, 3);
+    auto p_out_mask = std::make_shared<Eigen::Tensor<bool, 3>>(rows, cols, 1);
+    p_out_grid->setZero();
+    p_out_mask->setConstant(false);
+    float* p_out = p_out_grid->data();
+    bool* p_out_valid = p_out_mask->data();
+    for (const auto& voxels : partition_voxels)
+    {
+        for (const auto& voxel : voxels)
+        {
+            const float inv_count = 1.0f / static_cast<float>(voxel.m_count);
+            for (int k = 0; k < 3; ++k)
+            {
+                p_out[voxel.m_firstPixel + k * plane] = voxel.m_sum[k] * inv_count;
+            }
+            p_out_valid[voxel.m_firstPixel] = true;
+        }
+    }
+    return {std::make_shared<GridFrame>(p_out_grid, grid_frame.getCamParams(), grid_frame.getExtrinsic()),
+            std::make_shared<MaskFrame>(p_out_mask, mask_frame.getCamParams(), mask_frame.getExtrinsic())};
+}
+
+GridDownsampler::GridDownsampler(const DownsampleParameters& params)
+    : m_params(params)
+{
+}
+
+const DownsampleParameters& GridDownsampler::getParams() const
+{
+    return m_params;
+}
+
+std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> GridDownsampler::downsample(const GridFrame& grid_frame, const MaskFrame& mask_frame) const
+{
+    if (mask_frame.getRows() != grid_frame.getRows() || mask_frame.getCols() != grid_frame.getCols())
+    {
+        throw std::runtime_error("Point cloud mask resolution does not match point cloud grid resolution.");
+    }
+    if (m_params.m_mode == DownsampleMode::VOXEL)
+    {
+        return downsampleVoxel(grid_frame, mask_frame);
+    }
+    return downsampleBlock(grid_frame, mask_frame);
+}
+
+void GridDownsampler::downsample(const GridFrame& grid_frame, const MaskFrame& mask_frame, PointCloudBuffer& buffer) const
+{
+    const auto result = downsample(grid_frame, mask_frame);
+    buffer.fromGridFrame(*result.first, *result.second);
+}
+
+void GridDownsampler::process(CompositeFrame& composite_frame)
+{
+    if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+    {
+        return;
+    }
+    const auto p_grid_frame = std::static_pointer_cast<GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+    const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+    const int rows = p_grid_frame->getRows();
+    const int cols = p_grid_frame->getCols();
+    const auto result = downsample(*p_grid_frame, *p_mask_frame);
+
+    if (m_params.m_mode == DownsampleMode::BLOCK)
+    {
+        const int block_size = getEffectiveBlockSize(rows, cols);
+        for (const FrameID frame_id : composite_frame.getFrameIDs())
+        {
+            if (frame_id == FrameID::POINTCLOUD_GRID || frame_id == FrameID::POINTCLOUD_MASK)
+            {
+                continue;
+            }
+            const std::shared_ptr<GenericDataFrame> p_data_frame = composite_frame.getFrame(frame_id);
+            if (p_data_frame->getRows() == rows && p_data_frame->getCols() == cols)
+            {
+                p_data_frame->resize(result.first->getRows(), result.first->getCols());
+                const std::shared_ptr<CamParameters> p_cam_params = p_data_frame->getCamParams();
+                p_data_frame->setCamParams(p_cam_params == p_grid_frame->getCamParams() ? result.first->getCamParams() : scaleToBlocks(p_cam_params, block_size));
+            }
+        }
+    }
+    composite_frame.addFrame(FrameID::POINTCLOUD_MASK, result.second);
+    composite_frame.addFrame(FrameID::POINTCLOUD_GRID, result.first);
+}
@@ -0,0 +1,306 @@
+#include "listener_processing/GridProjector.h"
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <opencv2/core.hpp>
+
+#include "listener_processing/ProjectionLut.h"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/tensor_utils.hpp"
+
+namespace
+{
+    constexpr uint64_t emptyKey = std::numeric_limits<uint64_t>::max();
+    constexpr int pointChunk = 4096;
+    constexpr int lookupBlock = 1024;
+    constexpr int rowChunk = 8;
+
+    /*!
+     * @brief Packs a positive depth and a point index into a key whose integer order follows the depth.
+     */
+    inline uint64_t packKey(const float depth, const uint32_t index)
+    {
+        uint32_t depth_bits;
+        std::memcpy(&depth_bits, &depth, sizeof(float));
+        return (static_cast<uint64_t>(depth_bits) << 32) | index;
+    }
+
+    /*!
+     * @brief Checks that a grid has the projection resolution and that every point can be indexed by a packed key.
+     */
+    void checkInput(const Eigen::Tensor<float, 3>& grid, const size_t num_points, const int rows, const int cols)
+    {
+        if (grid.dimension(0) != rows || grid.dimension(1) != cols || grid.dimension(2) != 3)
+        {
+            throw std::runtime_error("Organized point cloud tensor does not match projection grid resolution.");
+        }
+        if (num_points > std::numeric_limits<uint32_t>::max() || num_points > static_cast<size_t>(std::numeric_limits<int>::max()))
+        {
+            throw std::runtime_error("Too many points to organize into a grid.");
+        }
+    }
+
+    /*!
+     * @brief Pinhole model of the grid, copied into locals so that per-point projection does not reload the intrinsic matrix.
+     */
+    struct Pinhole
+    {
+        float m_fx;
+        float m_fy;
+        float m_cx;
+        float m_cy;
+        float m_rows;
+        float m_cols;
+
+        Pinhole(const Eigen::Matrix3f& intrinsic, const int rows, const int cols)
+            : m_fx(intrinsic(0, 0)), m_fy(intrinsic(1, 1)), m_cx(intrinsic(0, 2)), m_cy(intrinsic(1, 2)), m_rows(static_cast<float>(rows)), m_cols(static_cast<float>(cols))
+        {
+        }
+
+        /*!
+         * @brief Projects a point to its grid pixel, failing for non-positive depth or pixels outside the grid.
+         */
+        bool toPixel(const float x, const float y, const float z, size_t& row, size_t& col) const
+        {
+            if (!(z > 0.0f))
+            {
+                return false;
+            }
+            const float inv_z = 1.0f / z;
+            const float u = m_fx * x * inv_z + m_cx;
+            const float v = m_fy * y * inv_z + m_cy;
+            if (!(u >= 0.0f && u < m_cols && v >= 0.0f && v < m_rows))
+            {
+                return false;
+            }
+            row = static_cast<size_t>(v);
+            col = static_cast<size_t>(u);
+            return true;
+        }
+    };
+}
+
+template <typename T>
+void GridProjector::selectNearest(const T* p_points, const size_t num_points, const std::function<void(int, int, int32_t*)>& pixel_lookup)
+{
+    const size_t num_pixels = static_cast<size_t>(m_rows) * m_cols;
+    listener_utils::parallelFor(0, m_rows, [&](const int row_begin, const int row_end)
+    {
+        for (size_t pixel = static_cast<size_t>(row_begin) * m_cols; pixel < static_cast<size_t>(row_end) * m_cols; ++pixel)
+        {
+            m_nearestKeys[pixel].store(emptyKey, std::memory_order_relaxed);
+        }
+    }, m_numThreads, rowChunk);
+    if (num_pixels == 0)
+    {
+        return;
+    }
+
+    const Pinhole pinhole(m_intrinsic, m_rows, m_cols);
+    listener_utils::parallelFor(0, static_cast<int>(num_points), [&](const int point_begin, const int point_end)
+    {
+        // Looked up pixels are fetched a block at a time into a buffer on the stack of the thread that uses them
+        int32_t pixels[lookupBlock];
+        for (int block_begin = point_begin; block_begin < point_end; block_begin += lookupBlock)
+        {
+            const int block_end = std::min(point_end, block_begin + lookupBlock);
+            if (pixel_lookup)
+            {
+                pixel_lookup(block_begin, block_end, pixels);
+            }
+            for (int n = block_begin; n < block_end; ++n)
+            {
+                const auto z = static_cast<float>(p_points[3 * static_cast<size_t>(n) + 2]);
+                if (!(z > 0.0f))
+                {
+                    continue;
+                }
+                size_t pixel;
+                if (pixel_lookup)
+                {
+                    if (pixels[n - block_begin] < 0)
+                    {
+                        continue;
+                    }
+                    pixel = static_cast<size_t>(pixels[n - block_begin]);
+                }
+                else
+                {
+                    size_t row;
+                    size_t col;
+                    if (!pinhole.toPixel(static_cast<float>(p_points[3 * static_cast<size_t>(n)]), static_cast<float>(p_points[3 * static_cast<size_t>(n) + 1]), z, row, col))
+                    {
+                        continue;
+                    }
+                    pixel = row * m_cols + col;
+                }
+
+                // Atomic minimum so that the nearest point wins regardless of thread interleaving
+                const uint64_t key = packKey(z, static_cast<uint32_t>(n));
+                uint64_t current = m_nearestKeys[pixel].load(std::memory_order_relaxed);
+                while (key < current && !m_nearestKeys[pixel].compare_exchange_weak(current, key, std::memory_order_relaxed))
+                {
+                }
+            }
+        }
+    }, m_numThreads, pointChunk);
+}
+
+template <typename T>
+void GridProjector::writeNearest(const T* p_points, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter)
+{
+    const size_t plane = static_cast<size_t>(m_rows) * m_cols;
+    float* p_grid = grid.data();
+    if (!depth_filter)
+    {
+        listener_utils::parallelFor(0, m_rows, [&](const int row_begin, const int row_end)
+        {
+            for (int i = row_begin; i < row_end; ++i)
+            {
+                for (int j = 0; j < m_cols; ++j)
+                {
+                    const uint64_t key = m_nearestKeys[static_cast<size_t>(i) * m_cols + j].load(std::memory_order_relaxed);
+                    if (key == emptyKey)
+                    {
+                        continue;
+                    }
+                    const size_t n = key & 0xffffffffULL;
+                    const size_t pixel = listener_utils::planeIndex(i, j, m_rows);
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        p_grid[pixel + k * plane] = static_cast<float>(p_points[3 * n + k]);
+                    }
+                }
+            }
+        }, m_numThreads, rowChunk);
+        return;
+    }
+
+    cv::Mat depth_image(m_rows, m_cols, CV_32FC1);
+    listener_utils::parallelFor(0, m_rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            auto* p_row = depth_image.ptr<float>(i);
+            for (int j = 0; j < m_cols; ++j)
+            {
+                const uint64_t key = m_nearestKeys[static_cast<size_t>(i) * m_cols + j].load(std::memory_order_relaxed);
+                p_row[j] = key == emptyKey ? 0.0f : static_cast<float>(p_points[3 * (key & 0xffffffffULL) + 2]);
+            }
+        }
+    }, m_numThreads, rowChunk);
+
+    depth_filter(depth_image);
+    deproject(depth_image, grid);
+}
+
+GridProjector::GridProjector(const Eigen::Matrix3f& intrinsic, const int rows, const int cols, const unsigned int num_threads)
+    : m_intrinsic(intrinsic), m_rows(rows), m_cols(cols), m_numThreads(num_threads),
+      m_nearestKeys(std::make_unique<std::atomic<uint64_t>[]>(static_cast<size_t>(rows) * cols))
+{
+}
+
+void GridProjector::deproject(const cv::Mat& depth_image, Eigen::Tensor<float, 3>& grid) const
+{
+    if (depth_image.rows != m_rows || depth_image.cols != m_cols || depth_image.type() != CV_32FC1 || grid.dimension(0) != m_rows || grid.dimension(1) != m_cols || grid.dimension(2) != 3)
+    {
+        throw std::runtime_error("Depth image or organized point cloud tensor does not match projection grid resolution.");
+    }
+
+    const size_t plane = static_cast<size_t>(m_rows) * m_cols;
+    float* p_grid = grid.data();
+    const float inv_fx = 1.0f / m_intrinsic(0, 0);
+    const float inv_fy = 1.0f / m_intrinsic(1, 1);
+    const float cx = m_intrinsic(0, 2);
+    const float cy = m_intrinsic(1, 2);
+    listener_utils::parallelFor(0, m_rows, [&](const int row_begin, const int row_end)
+    {
+        for (int i = row_begin; i < row_end; ++i)
+        {
+            const auto* p_row = depth_image.ptr<float>(i);
+            const float ray_y = (static_cast<float>(i) - cy) * inv_fy;
+            for (int j = 0; j < m_cols; ++j)
+            {
+                const float depth = p_row[j] > 0.0f ? p_row[j] : 0.0f;
+                const size_t pixel = listener_utils::planeIndex(i, j, m_rows);
+                p_grid[pixel] = (static_cast<float>(j) - cx) * inv_fx * depth;
+                p_grid[pixel + plane] = ray_y * depth;
+                p_grid[pixel + 2 * plane] = depth;
+            }
+        }
+    }, m_numThreads, rowChunk);
+}
+
+template <typename T>
+void GridProjector::project(const T* p_points, const size_t num_points, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter)
+{
+    checkInput(grid, num_points, m_rows, m_cols);
+    selectNearest(p_points, num_points, nullptr);
+    writeNearest(p_points, grid, depth_filter);
+}
+
+void GridProjector::project(const float* p_points, const uint32_t* p_beam_ids, const size_t num_points, ProjectionLut& lut, Eigen::Tensor<float, 3>& grid, const std::function<void(cv::Mat&)>& depth_filter)
+{
+    checkInput(grid, num_points, m_rows, m_cols);
+    if (!lut.matches(m_intrinsic, m_rows, m_cols, lut.getNumBeams()))
+    {
+        throw std::runtime_error("Projection lookup table does not match projection model and grid resolution.");
+    }
+
+    // Beams are verified before any point is looked up, then each thread looks up the pixels of its own points
+    lut.verify(p_points, p_beam_ids, num_points, m_numThreads);
+    selectNearest(p_points, num_points, [&](const int block_begin, const int block_end, int32_t* p_pixels)
+    {
+        lut.lookup(p_points + 3 * static_cast<size_t>(block_begin), p_beam_ids + block_begin, static_cast<size_t>(block_end - block_begin), p_pixels);
+    });
+    writeNearest(p_points, grid, depth_filter);
+}
+
+template <typename T>
+void GridProjector::accumulate(const T* p_points, const size_t num_points, Eigen::Tensor<float, 3>& grid) const
+{
+    if (grid.dimension(0) != m_rows || grid.dimension(1) != m_cols || grid.dimension(2) != 3)
+    {
+        throw std::runtime_error("Organized point cloud tensor does not match projection grid resolution.");
+    }
+
+    // The grid's own depth plane is the depth buffer, so only the batch's points are visited
+    const Pinhole pinhole(m_intrinsic, m_rows, m_cols);
+    const size_t plane = static_cast<size_t>(m_rows) * m_cols;
+    float* p_grid = grid.data();
+    for (size_t n = 0; n < num_points; ++n)
+    {
+        const auto x = static_cast<float>(p_points[3 * n]);
+        const auto y = static_cast<float>(p_points[3 * n + 1]);
+        const auto z = static_cast<float>(p_points[3 * n + 2]);
+        size_t row;
+        size_t col;
+        if (!pinhole.toPixel(x, y, z, row, col))
+        {
+            continue;
+        }
+        const size_t pixel = listener_utils::planeIndex(row, col, m_rows);
+        const float current = p_grid[pixel + 2 * plane];
+        if (current > 0.0f && current <= z)
+        {
+            continue;
+        }
+        p_grid[pixel] = x;
+        p_grid[pixel + plane] = y;
+        p_grid[pixel + 2 * plane] = z;
+    }
+}
+
+template void GridProjector::project<float>(const float*, size_t, Eigen::Tensor<float, 3>&, const std::function<void(cv::Mat&)>&);
+template void GridProjector::project<double>(const double*, size_t, Eigen::Tensor<float, 3>&, const std::function<void(cv::Mat&)>&);
+template void GridProjector::accumulate<float>(const float*, size_t, Eigen::Tensor<float, 3>&) const;
+template void GridProjector::accumulate<double>(const double*, size_t, Eigen::Tensor<float, 3>&) const;
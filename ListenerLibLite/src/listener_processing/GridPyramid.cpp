@@ -0,0 +1,177 @@
+#include "listener_processing/GridPyramid.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/CompositeFrame.h"
+
+namespace
+{
+    constexpr int pixelChunk = 4096;
+}
+
+GridPyramid::GridPyramid(const PyramidParameters& params)
+    : m_params(params)
+{
+    for (const float scale : m_params.m_scales)
+    {
+        if (!(scale > 0.0f && scale <= 1.0f))
+        {
+            throw std::runtime_error("Pyramid level scales must be in (0, 1].");
+        }
+    }
+}
+
+const PyramidParameters& GridPyramid::getParams() const
+{
+    return m_params;
+}
+
+std::vector<std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>>> GridPyramid::build(const GridFrame& grid_frame, const MaskFrame& mask_frame) const
+{
+    if (mask_frame.getRows() != grid_frame.getRows() || mask_frame.getCols() != grid_frame.getCols())
+    {
+        throw std::runtime_error("Point cloud mask resolution does not match point cloud grid resolution.");
+    }
+    const std::shared_ptr<CamParameters> p_cam_params = grid_frame.getCamParams();
+    if (p_cam_params == nullptr)
+    {
+        throw std::runtime_error("Building a grid pyramid requires the point cloud's camera parameters.");
+    }
+    const Eigen::Matrix3f& intrinsic = *p_cam_params->m_intrinsicPtr;
+    const int rows = grid_frame.getRows();
+    const int cols = grid_frame.getCols();
+
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    const float* p_grid = grid_frame.getData().data();
+    const bool* p_mask = mask_frame.getData().data();
+
+    std::vector<std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>>> levels;
+    levels.reserve(m_params.m_scales.size());
+    for (const float scale : m_params.m_scales)
+    {
+        const int out_rows = std::max(1, static_cast<int>(static_cast<float>(rows) * scale));
+        const int out_cols = std::max(1, static_cast<int>(static_cast<float>(cols) * scale));
+        auto p_intrinsic = std::make_shared<Eigen::Matrix3f>(intrinsic);
+        p_intrinsic->block<2, 2>(0, 0) *= scale;
+        (*p_intrinsic)(0, 2) = static_cast<float>(out_cols) / 2.0f;
+        (*p_intrinsic)(1, 2) = static_cast<float>(out_rows) / 2.0f;
+        const auto p_level_params = std::make_shared<CamParameters>(p_intrinsic, p_cam_params->m_distortionPtr);
+
+        // Reproject every valid point into the level, which is exact for any scale, then bucket points by coarse pixel
+        const float fx = (*p_intrinsic)(0, 0);
+        const float fy = (*p_intrinsic)(1, 1);
+        const float cx = (*p_intrinsic)(0, 2);
+        const float cy = (*p_intrinsic)(1, 2);
+        const size_t out_plane = static_cast<size_t>(out_rows) * out_cols;
+        std::vector<int32_t> targets(plane);
+        listener_utils::parallelFor(0, static_cast<int>(plane), [&](const int pixel_begin, const int pixel_end)
+        {
+            for (int pixel = pixel_begin; pixel < pixel_end; ++pixel)
+            {
+                targets[pixel] = -1;
+                const float z = p_grid[pixel + 2 * plane];
+                if (!p_mask[pixel] || !(z > 0.0f))
+                {
+                    continue;
+                }
+                const float inv_z = 1.0f / z;
+                const float u = fx * p_grid[pixel] * inv_z + cx;
+                const float v = fy * p_grid[pixel + plane] * inv_z + cy;
+                if (u >= 0.0f && u < static_cast<float>(out_cols) && v >= 0.0f && v < static_cast<float>(out_rows))
+                {
+                    targets[pixel] = static_cast<int32_t>(listener_utils::planeIndex(static_cast<size_t>(v), static_cast<size_t>(u), out_rows));
+                }
+            }
+        }, m_params.m_numThreads, pixelChunk);
+
+        std::vector<uint32_t> offsets(out_plane + 1, 0);
+        for (size_t pixel = 0; pixel < plane; ++pixel)
+        {
+            if (targets[pixel] >= 0)
+            {
+                ++offsets[targets[pixel] + 1];
+            }
+        }
+        for (size_t out_pixel = 0; out_pixel < out_plane; ++out_pixel)
+        {
+            offsets[out_pixel + 1] += offsets[out_pixel];
+        }
+        std::vector<std::pair<float, uint32_t>> buckets(offsets[out_plane]);
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t pixel = 0; pixel < plane; ++pixel)
+        {
+            if (targets[pixel] >= 0)
+            {
+                buckets[fill[targets[pixel]]++] = {p_grid[pixel + 2 * plane], static_cast<uint32_t>(pixel)};
+            }
+        }
+
+        auto p_out_grid = std::make_shared<Eigen::Tensor<float, 3>>(out_rows, out_cols, 3);
+        auto p_out_mask = std::make_shared<Eigen::Tensor<bool, 3>>(out_rows, out_cols, 1);
+        p_out_grid->setZero();
+        p_out_mask->setConstant(false);
+        float* p_out = p_out_grid->data();
+        bool* p_out_valid = p_out_mask->data();
+        listener_utils::parallelFor(0, static_cast<int>(out_plane), [&](const int out_begin, const int out_end)
+        {
+            for (int out_pixel = out_begin; out_pixel < out_end; ++out_pixel)
+            {
+                const auto first = buckets.begin() + offsets[out_pixel];
+                const auto last = buckets.begin() + offsets[out_pixel + 1];
+                if (first == last)
+                {
+                    continue;
+                }
+                auto selected = first;
+                if (m_params.m_reduction == PyramidReduction::MEDIAN)
+                {
+                    selected = first + (last - first - 1) / 2;
+                    std::nth_element(first, selected, last);
+                }
+                else
+                {
+                    selected = std::min_element(first, last);
+                }
+                const size_t pixel = selected->second;
+                for (int k = 0; k < 3; ++k)
+                {
+                    p_out[out_pixel + k * out_plane] = p_grid[pixel + k * plane];
+                }
+                p_out_valid[out_pixel] = true;
+            }
+        }, m_params.m_numThreads, pixelChunk);
+
+        levels.emplace_back(std::make_shared<GridFrame>(p_out_grid, p_level_params, grid_frame.getExtrinsic()),
+                            std::make_shared<MaskFrame>(p_out_mask, p_level_params, mask_frame.getExtrinsic()));
+    }
+    return levels;
+}
+
+void GridPyramid::process(CompositeFrame& composite_frame)
+{
+    if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+    {
+        return;
+    }
+    const auto p_grid_frame = std::static_pointer_cast<GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+    const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+    composite_frame.clearPyramid();
+    for (const auto& level : build(*p_grid_frame, *p_mask_frame))
+    {
+        composite_frame.addPyramidLevel(level.first, level.second);
+    }
+}
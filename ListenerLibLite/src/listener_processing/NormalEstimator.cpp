@@ -0,0 +1,256 @@
+#include "listener_processing/NormalEstimator.h"
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/NormalFrame.h"
+#include "listener_frames/CompositeFrame.h"
+
+namespace
+{
+    /*!
+     * @brief Combines forward and backward tangent candidates, preferring the central difference when both are valid.
+     */
+    inline void combineTangent(const float* fwd, const float* bwd, const float* centre, const bool fwd_valid, const bool bwd_valid, float* tangent, bool& valid)
+    {
+        const float fwd_weight = fwd_valid ? 1.0f : 0.0f;
+        const float bwd_weight = bwd_valid ? 1.0f : 0.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            // Central difference if both valid, one-sided difference otherwise
+            const float front = fwd_weight * fwd[k] + (1.0f - fwd_weight) * centre[k];
+            const float back = bwd_weight * bwd[k] + (1.0f - bwd_weight) * centre[k];
+            tangent[k] = front - back;
+        }
+        valid = fwd_valid || bwd_valid;
+    }
+
+    /*!
+     * @brief Writes the normalized cross product of two tangents, oriented towards the sensor origin, or zero if invalid.
+     */
+    inline void writeNormal(const float* t_col, const float* t_row, const float* centre, const bool valid, float* p_normals, const size_t pixel, const size_t plane)
+    {
+        float n[3] = {
+            t_col[1] * t_row[2] - t_col[2] * t_row[1],
+            t_col[2] * t_row[0] - t_col[0] * t_row[2],
+            t_col[0] * t_row[1] - t_col[1] * t_row[0]
+        };
+        const float norm_sq = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+        const float facing = n[0] * centre[0] + n[1] * centre[1] + n[2] * centre[2];
+        const float scale = (valid && norm_sq > 0.0f) ? (facing > 0.0f ? -1.0f : 1.0f) / std::sqrt(norm_sq) : 0.0f;
+        for (int k = 0; k < 3; ++k)
+        {
+            p_normals[pixel + k * plane] = n[k] * scale;
+        }
+    }
+}
+
+void NormalEstimator::estimateCentralDifference(const float* p_grid, const bool* p_mask, float* p_normals, const int rows, const int cols) const
+{
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    const int radius = std::max(1, m_params.m_radius);
+    const float depth_factor = m_params.m_maxDepthChangeFactor * radius;
+
+    listener_utils::parallelFor(0, cols, [&](const int col_begin, const int col_end)
+    {
+        for (int j = col_begin; j < col_end; ++j)
+        {
+            const int j_fwd = std::min(cols - 1, j + radius);
+            const int j_bwd = std::max(0, j - radius);
+            for (int i = 0; i < rows; ++i)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                const float centre[3] = {p_grid[pixel], p_grid[pixel + plane], p_grid[pixel + 2 * plane]};
+                const float threshold = depth_factor * std::abs(centre[2]);
+
+                const int i_fwd = std::min(rows - 1, i + radius);
+                const int i_bwd = std::max(0, i - radius);
+                const size_t neighbours[4] = {
+                    listener_utils::planeIndex(i, j_fwd, rows),
+                    listener_utils::planeIndex(i, j_bwd, rows),
+                    listener_utils::planeIndex(i_fwd, j, rows),
+                    listener_utils::planeIndex(i_bwd, j, rows)
+                };
+                float points[4][3];
+                bool valid[4];
+                for (int n = 0; n < 4; ++n)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        points[n][k] = p_grid[neighbours[n] + k * plane];
+                    }
+                    valid[n] = neighbours[n] != pixel && p_mask[neighbours[n]] && std::abs(points[n][2] - centre[2]) <= threshold;
+                }
+
+                float t_col[3];
+                float t_row[3];
+                bool col_valid;
+                bool row_valid;
+                combineTangent(points[0], points[1], centre, valid[0], valid[1], t_col, col_valid);
+                combineTangent(points[2], points[3], centre, valid[2], valid[3], t_row, row_valid);
+                writeNormal(t_col, t_row, centre, p_mask[pixel] && col_valid && row_valid, p_normals, pixel, plane);
+            }
+        }
+    }, m_params.m_numThreads);
+}
+
+void NormalEstimator::estimateAverageGradient(const float* p_grid, const bool* p_mask, float* p_normals, const int rows, const int cols) const
+{
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    const int radius = std::max(1, m_params.m_radius);
+    const float depth_factor = m_params.m_maxDepthChangeFactor * (radius + 1);
+
+    // Integral images of masked x, y, z, and valid count, column-major with a leading row and column of zeros
+    const int int_rows = rows + 1;
+    const size_t int_plane = static_cast<size_t>(int_rows) * (cols + 1);
+    std::vector<double> integral(4 * int_plane, 0.0);
+    listener_utils::parallelFor(0, cols, [&](const int col_begin, const int col_end)
+    {
+        for (int j = col_begin; j < col_end; ++j)
+        {
+            double sums[4] = {0.0, 0.0, 0.0, 0.0};
+            for (int i = 0; i < rows; ++i)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                const double weight = p_mask[pixel] ? 1.0 : 0.0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    sums[k] += weight * p_grid[pixel + k * plane];
+                }
+                sums[3] += weight;
+                for (int c = 0; c < 4; ++c)
+                {
+                    integral[c * int_plane + listener_utils::planeIndex(i + 1, j + 1, int_rows)] = sums[c];
+                }
+            }
+        }
+    }, m_params.m_numThreads);
+    listener_utils::parallelFor(1, int_rows, [&](const int row_begin, const int row_end)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            double* p_integral = integral.data() + c * int_plane;
+            for (int j = 1; j <= cols; ++j)
+            {
+                for (int i = row_begin; i < row_end; ++i)
+                {
+                    p_integral[listener_utils::planeIndex(i, j, int_rows)] += p_integral[listener_utils::planeIndex(i, j - 1, int_rows)];
+                }
+            }
+        }
+    }, m_params.m_numThreads);
+
+    // Sums over the inclusive pixel rectangle [top, btm] x [lft, rgt], clamped to the grid
+    const auto box_sum = [&](int top, int btm, int lft, int rgt, double* sums)
+    {
+        top = std::max(0, top);
+        lft = std::max(0, lft);
+        btm = std::min(rows - 1, btm);
+        rgt = std::min(cols - 1, rgt);
+        if (top > btm || lft > rgt)
+        {
+            std::fill(sums, sums + 4, 0.0);
+            return;
+        }
+        const size_t a = listener_utils::planeIndex(top, lft, int_rows);
+        const size_t b = listener_utils::planeIndex(top, rgt + 1, int_rows);
+        const size_t c = listener_utils::planeIndex(btm + 1, lft, int_rows);
+        const size_t d = listener_utils::planeIndex(btm + 1, rgt + 1, int_rows);
+        for (int n = 0; n < 4; ++n)
+        {
+            const double* p_integral = integral.data() + n * int_plane;
+            sums[n] = p_integral[d] - p_integral[b] - p_integral[c] + p_integral[a];
+        }
+    };
+
+    listener_utils::parallelFor(0, cols, [&](const int col_begin, const int col_end)
+    {
+        double sums[4][4];
+        float means[4][3];
+        bool valid[4];
+        for (int j = col_begin; j < col_end; ++j)
+        {
+            for (int i = 0; i < rows; ++i)
+            {
+                const size_t pixel = listener_utils::planeIndex(i, j, rows);
+                const float centre[3] = {p_grid[pixel], p_grid[pixel + plane], p_grid[pixel + 2 * plane]};
+                const float threshold = depth_factor * std::abs(centre[2]);
+
+                box_sum(i - radius, i + radius, j + 1, j + radius, sums[0]);
+                box_sum(i - radius, i + radius, j - radius, j - 1, sums[1]);
+                box_sum(i + 1, i + radius, j - radius, j + radius, sums[2]);
+                box_sum(i - radius, i - 1, j - radius, j + radius, sums[3]);
+                for (int n = 0; n < 4; ++n)
+                {
+                    const double inv_count = sums[n][3] > 0.0 ? 1.0 / sums[n][3] : 0.0;
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        means[n][k] = static_cast<float>(sums[n][k] * inv_count);
+                    }
+                    valid[n] = sums[n][3] > 0.0 && std::abs(means[n][2] - centre[2]) <= threshold;
+                }
+
+                float t_col[3];
+                float t_row[3];
+                bool col_valid;
+                bool row_valid;
+                combineTangent(means[0], means[1], centre, valid[0], valid[1], t_col, col_valid);
+                combineTangent(means[2], means[3], centre, valid[2], valid[3], t_row, row_valid);
+                writeNormal(t_col, t_row, centre, p_mask[pixel] && col_valid && row_valid, p_normals, pixel, plane);
+            }
+        }
+    }, m_params.m_numThreads);
+}
+
+NormalEstimator::NormalEstimator(const NormalEstimationParameters& params)
+    : m_params(params)
+{
+}
+
+const NormalEstimationParameters& NormalEstimator::getParams() const
+{
+    return m_params;
+}
+
+std::shared_ptr<NormalFrame> NormalEstimator::estimate(const GridFrame& grid_frame, const MaskFrame& mask_frame) const
+{
+    const int rows = grid_frame.getRows();
+    const int cols = grid_frame.getCols();
+    if (mask_frame.getRows() != rows || mask_frame.getCols() != cols)
+    {
+        throw std::runtime_error("Point cloud mask resolution does not match point cloud grid resolution.");
+    }
+
+    auto p_normals = std::make_shared<Eigen::Tensor<float, 3>>(rows, cols, 3);
+    if (m_params.m_method == NormalMethod::CENTRAL_DIFFERENCE)
+    {
+        estimateCentralDifference(grid_frame.getData().data(), mask_frame.getData().data(), p_normals->data(), rows, cols);
+    }
+    else
+    {
+        estimateAverageGradient(grid_frame.getData().data(), mask_frame.getData().data(), p_normals->data(), rows, cols);
+    }
+    return std::make_shared<NormalFrame>(p_normals, grid_frame.getCamParams(), grid_frame.getExtrinsic());
+}
+
+void NormalEstimator::process(CompositeFrame& composite_frame)
+{
+    if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+    {
+        return;
+    }
+    const auto p_grid_frame = std::static_pointer_cast<GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+    const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+    composite_frame.addFrame(FrameID::NORMAL_GRID, estimate(*p_grid_frame, *p_mask_frame));
+}
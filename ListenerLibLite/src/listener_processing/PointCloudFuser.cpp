@@ -0,0 +1,113 @@
+#include "listener_processing/PointCloudFuser.h"
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/PointCloudBuffer.h"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/RGBFrame.h"
+#include "listener_frames/CompositeFrame.h"
+#include "abstract_listeners/GenericListener.h"
+
+PointCloudFuser::PointCloudFuser(const PointLayout layout, const bool has_color, const size_t capacity, const std::chrono::microseconds& max_time_skew, const unsigned int num_threads)
+	: m_numThreads(num_threads), m_maxTimeSkew(max_time_skew), m_buffer(layout, has_color, false, false, true)
+{
+	m_buffer.reserve(capacity);
+}
+
+const PointCloudBuffer& PointCloudFuser::fuse(const std::vector<std::shared_ptr<CompositeFrame>>& composite_frames)
+{
+	const int num_sources = static_cast<int>(composite_frames.size());
+	if (m_maxTimeSkew > std::chrono::microseconds::zero() && num_sources > 1)
+	{
+		const auto minmax = std::minmax_element(composite_frames.begin(), composite_frames.end(),
+			[](const auto& a, const auto& b) { return a->getTimestamp() < b->getTimestamp(); });
+		if ((*minmax.second)->getTimestamp() - (*minmax.first)->getTimestamp() > m_maxTimeSkew)
+		{
+			throw std::runtime_error("CompositeFrames to fuse are not synchronized.");
+		}
+	}
+
+	// Size the shared buffer from the mask counts of all sources
+	m_sourceOffsets.assign(num_sources + 1, 0);
+	listener_utils::parallelFor(0, num_sources, [&](const int source_begin, const int source_end)
+	{
+		for (int s = source_begin; s < source_end; ++s)
+		{
+			const CompositeFrame& composite_frame = *composite_frames[s];
+			if (composite_frame.has(FrameID::POINTCLOUD_GRID))
+			{
+				const auto p_mask_frame = std::static_pointer_cast<const MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+				m_sourceOffsets[s + 1] = PointCloudBuffer::countMasked(*p_mask_frame);
+			}
+		}
+	}, m_numThreads, 1);
+	for (int s = 0; s < num_sources; ++s)
+	{
+		m_sourceOffsets[s + 1] += m_sourceOffsets[s];
+	}
+	m_buffer.resize(m_sourceOffsets[num_sources]);
+
+	// Each source writes, transforms, and tags its own disjoint range of the buffer
+	const unsigned int threads_per_source = std::max(1u, listener_utils::getNumThreads(m_numThreads) / std::max(1, num_sources));
+	listener_utils::parallelFor(0, num_sources, [&](const int source_begin, const int source_end)
+	{
+		for (int s = source_begin; s < source_end; ++s)
+		{
+			const CompositeFrame& composite_frame = *composite_frames[s];
+			if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+			{
+				continue;
+			}
+			const auto p_grid_frame = std::static_pointer_cast<const GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+			const auto p_mask_frame = std::static_pointer_cast<const MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+			std::shared_ptr<const RGBFrame> p_rgb_frame = nullptr;
+			if (m_buffer.hasColor() && composite_frame.has(FrameID::RGB_IMAGE))
+			{
+				const auto p_candidate = std::static_pointer_cast<const RGBFrame>(composite_frame.getFrame(FrameID::RGB_IMAGE));
+				if (p_candidate->getRows() == p_grid_frame->getRows() && p_candidate->getCols() == p_grid_frame->getCols())
+				{
+					p_rgb_frame = p_candidate;
+				}
+			}
+
+			m_buffer.writeGridFrame(m_sourceOffsets[s], *p_grid_frame, *p_mask_frame, p_rgb_frame, nullptr, threads_per_source);
+			const std::shared_ptr<Eigen::Matrix4f> p_extrinsic = p_grid_frame->getExtrinsic();
+			if (p_extrinsic != nullptr && !p_extrinsic->isIdentity())
+			{
+				m_buffer.transform(*p_extrinsic, m_sourceOffsets[s], m_sourceOffsets[s + 1]);
+			}
+			m_buffer.setSourceTag(static_cast<uint16_t>(s), m_sourceOffsets[s], m_sourceOffsets[s + 1]);
+		}
+	}, m_numThreads, 1);
+	return m_buffer;
+}
+
+const PointCloudBuffer& PointCloudFuser::fuse(const std::vector<std::shared_ptr<GenericListener>>& listeners)
+{
+	std::vector<std::shared_ptr<CompositeFrame>> composite_frames;
+	composite_frames.reserve(listeners.size());
+	for (const auto& p_listener : listeners)
+	{
+		composite_frames.push_back(p_listener->getLatestFrame());
+	}
+	return fuse(composite_frames);
+}
+
+const PointCloudBuffer& PointCloudFuser::getBuffer() const
+{
+	return m_buffer;
+}
+
+const std::vector<size_t>& PointCloudFuser::getSourceOffsets() const
+{
+	return m_sourceOffsets;
+}
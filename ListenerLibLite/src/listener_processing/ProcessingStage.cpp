@@ -0,0 +1,5 @@
+#include "listener_processing/ProcessingStage.h"
+
+ProcessingStage::~ProcessingStage()
+{
+}
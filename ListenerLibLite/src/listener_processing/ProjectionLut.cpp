@@ -0,0 +1,151 @@
+#include "listener_processing/ProjectionLut.h"
+
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+
+#include "listener_utils/parallel_utils.hpp"
+
+namespace
+{
+    constexpr int32_t unknownPixel = std::numeric_limits<int32_t>::min();
+    constexpr int32_t outsidePixel = -1;
+    constexpr int verifyChunk = 4096;
+}
+
+int32_t ProjectionLut::projectPixel(const float x, const float y, const float z) const
+{
+    const float inv_z = 1.0f / z;
+    const float u = m_intrinsic(0, 0) * x * inv_z + m_intrinsic(0, 2);
+    const float v = m_intrinsic(1, 1) * y * inv_z + m_intrinsic(1, 2);
+    if (!(u >= 0.0f && u < static_cast<float>(m_cols) && v >= 0.0f && v < static_cast<float>(m_rows)))
+    {
+        return outsidePixel;
+    }
+    return static_cast<int32_t>(v) * m_cols + static_cast<int32_t>(u);
+}
+
+void ProjectionLut::clear()
+{
+    for (size_t b = 0; b < m_numBeams; ++b)
+    {
+        m_pixels[b].store(unknownPixel, std::memory_order_relaxed);
+    }
+}
+
+ProjectionLut::ProjectionLut(const Eigen::Matrix3f& intrinsic, const int rows, const int cols, const size_t num_beams)
+    : m_intrinsic(intrinsic), m_rows(rows), m_cols(cols), m_numBeams(num_beams),
+      m_pixels(std::make_unique<std::atomic<int32_t>[]>(num_beams))
+{
+    if (static_cast<size_t>(rows) * cols > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+        throw std::runtime_error("Grid is too large for a projection lookup table.");
+    }
+    clear();
+}
+
+size_t ProjectionLut::getNumBeams() const
+{
+    return m_numBeams;
+}
+
+bool ProjectionLut::matches(const Eigen::Matrix3f& intrinsic, const int rows, const int cols, const size_t num_beams) const
+{
+    return m_rows == rows && m_cols == cols && m_numBeams == num_beams && m_intrinsic == intrinsic;
+}
+
+void ProjectionLut::verify(const float* p_points, const uint32_t* p_beam_ids, const size_t num_points, const unsigned int num_threads)
+{
+    if (num_points > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::runtime_error("Too many points to verify against a projection lookup table.");
+    }
+
+    // Rotate the checked beams, so that a beam stored from one odd return is corrected within verifyStride frames
+    const size_t phase = m_verifyPhase.fetch_add(1, std::memory_order_relaxed) % verifyStride;
+    std::atomic<size_t> num_checked = 0;
+    std::atomic<size_t> num_changed = 0;
+    listener_utils::parallelFor(0, static_cast<int>(num_points), [&](const int point_begin, const int point_end)
+    {
+        size_t chunk_checked = 0;
+        size_t chunk_changed = 0;
+        for (int n = point_begin; n < point_end; ++n)
+        {
+            const uint32_t beam = p_beam_ids[n];
+            const float* p_point = p_points + 3 * static_cast<size_t>(n);
+            if (beam % verifyStride != phase || beam >= m_numBeams || !(p_point[2] > 0.0f))
+            {
+                continue;
+            }
+            std::atomic<int32_t>& entry = m_pixels[beam];
+            const int32_t cached = entry.load(std::memory_order_relaxed);
+            if (cached == unknownPixel)
+            {
+                continue;
+            }
+            ++chunk_checked;
+            const int32_t projected = projectPixel(p_point[0], p_point[1], p_point[2]);
+            if (projected != cached)
+            {
+                entry.store(projected, std::memory_order_relaxed);
+                ++chunk_changed;
+            }
+        }
+        num_checked.fetch_add(chunk_checked, std::memory_order_relaxed);
+        num_changed.fetch_add(chunk_changed, std::memory_order_relaxed);
+    }, num_threads, verifyChunk);
+
+    m_numRestores.fetch_add(num_changed.load(), std::memory_order_relaxed);
+    if (2 * num_changed.load() > num_checked.load())
+    {
+        // Only the first and every reportStride-th reset are reported so that a misconfigured stream does not flood the log
+        const size_t num_resets = m_numResets.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (num_resets % reportStride == 1)
+        {
+            std::cerr << "Projection lookup table disagrees with beam IDs, cleared table " << num_resets << " times." << std::endl;
+        }
+        clear();
+    }
+}
+
+void ProjectionLut::lookup(const float* p_points, const uint32_t* p_beam_ids, const size_t num_points, int32_t* p_pixels)
+{
+    for (size_t n = 0; n < num_points; ++n)
+    {
+        const float* p_point = p_points + 3 * n;
+        if (!(p_point[2] > 0.0f))
+        {
+            p_pixels[n] = outsidePixel;
+            continue;
+        }
+        const uint32_t beam = p_beam_ids[n];
+        if (beam >= m_numBeams)
+        {
+            p_pixels[n] = projectPixel(p_point[0], p_point[1], p_point[2]);
+            continue;
+        }
+        std::atomic<int32_t>& entry = m_pixels[beam];
+        int32_t pixel = entry.load(std::memory_order_relaxed);
+        if (pixel == unknownPixel)
+        {
+            pixel = projectPixel(p_point[0], p_point[1], p_point[2]);
+            entry.store(pixel, std::memory_order_relaxed);
+        }
+        p_pixels[n] = pixel;
+    }
+}
+
+size_t ProjectionLut::getNumRestores() const
+{
+    return m_numRestores.load(std::memory_order_relaxed);
+}
+
+size_t ProjectionLut::getNumResets() const
+{
+    return m_numResets.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,170 @@
+#include "listener_processing/ScanAccumulator.h"
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+#include <opencv2/core.hpp>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/TensorPool.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/GrayFrame.h"
+#include "listener_frames/RGBFrame.h"
+#include "listener_frames/CompositeFrame.h"
+#include "listener_processing/DepthHoleFiller.h"
+#include "listener_processing/DepthMedianFilter.h"
+#include "sensor_interfaces/ScanningLidarInterface.h"
+
+namespace
+{
+    int gridRows(const CamParameters& cam_params)
+    {
+        return static_cast<int>((*cam_params.m_intrinsicPtr)(1, 2) * 2);
+    }
+
+    int gridCols(const CamParameters& cam_params)
+    {
+        return static_cast<int>((*cam_params.m_intrinsicPtr)(0, 2) * 2);
+    }
+}
+
+void ScanAccumulator::insertBatch()
+{
+    const size_t num_points = m_batch.size() / 3;
+    m_projector.accumulate(m_batch.data(), num_points, *m_gridPtr);
+    m_framePoints += num_points;
+}
+
+void ScanAccumulator::emitFrame()
+{
+    const std::shared_ptr<Eigen::Tensor<float, 3>> p_grid = m_gridPtr;
+    const size_t plane = static_cast<size_t>(m_rows) * m_cols;
+
+    // Filter the completed depth like a frame loaded from file before handing the grid off
+    const int filter_size = m_sensorInterfacePtr->getFilterSize();
+    const std::shared_ptr<const DepthHoleFiller> p_hole_filler = m_sensorInterfacePtr->getHoleFiller();
+    if (p_hole_filler != nullptr || filter_size > 0)
+    {
+        cv::Mat depth_image(m_rows, m_cols, CV_32FC1);
+        const float* p_depth = p_grid->data() + 2 * plane;
+        for (int i = 0; i < m_rows; ++i)
+        {
+            auto* p_row = depth_image.ptr<float>(i);
+            for (int j = 0; j < m_cols; ++j)
+            {
+                p_row[j] = p_depth[listener_utils::planeIndex(i, j, m_rows)];
+            }
+        }
+        if (p_hole_filler != nullptr)
+        {
+            p_hole_filler->fill(depth_image);
+        }
+        else
+        {
+            DepthMedianFilter(filter_size).filter(depth_image, depth_image);
+        }
+        m_projector.deproject(depth_image, *p_grid);
+    }
+
+    // Grayscale and RGB images are the depth normalized to its maximum, as for buffered frames
+    auto p_gray = std::make_shared<Eigen::Tensor<unsigned char, 3>>(m_rows, m_cols, 1);
+    auto p_rgb = std::make_shared<Eigen::Tensor<unsigned char, 3>>(m_rows, m_cols, 3);
+    const float* p_depth = p_grid->data() + 2 * plane;
+    const float depth_max = std::max(*std::max_element(p_depth, p_depth + plane), 0.0f);
+    const float scale = depth_max > 0.0f ? 255.0f / depth_max : 0.0f;
+    unsigned char* p_gray_data = p_gray->data();
+    unsigned char* p_rgb_data = p_rgb->data();
+    for (size_t pixel = 0; pixel < plane; ++pixel)
+    {
+        const auto value = static_cast<unsigned char>(std::max(p_depth[pixel], 0.0f) * scale);
+        p_gray_data[pixel] = value;
+        p_rgb_data[pixel] = value;
+        p_rgb_data[pixel + plane] = value;
+        p_rgb_data[pixel + 2 * plane] = value;
+    }
+
+    const auto p_composite_frame = std::make_shared<CompositeFrame>(m_frameStart, m_sensorInterfacePtr->getRGBMappable());
+    p_composite_frame->addFrame(FrameID::GRAYSCALE_IMAGE, std::make_shared<GrayFrame>(p_gray, m_camParamsPtr, m_extrinsicPtr));
+    p_composite_frame->addFrame(FrameID::RGB_IMAGE, std::make_shared<RGBFrame>(p_rgb, m_camParamsPtr, m_extrinsicPtr));
+    p_composite_frame->addFrame(FrameID::POINTCLOUD_GRID, std::make_shared<GridFrame>(p_grid, m_camParamsPtr, m_extrinsicPtr));
+
+    // Continue in a grid released by an earlier frame, or a new one if every earlier frame is still held
+    m_gridPtr = m_gridPool.acquire(m_rows, m_cols, 3);
+    m_gridPtr->setZero();
+    m_framePoints = 0;
+
+    m_emit(p_composite_frame);
+}
+
+ScanAccumulator::ScanAccumulator(const std::shared_ptr<const ScanningLidarInterface> p_sensor_interface, const std::shared_ptr<CamParameters> p_cam_params,
+    const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, std::function<void(std::shared_ptr<CompositeFrame>)> emit, const AccumulatorParameters& params)
+    : m_sensorInterfacePtr(p_sensor_interface), m_camParamsPtr(p_cam_params), m_extrinsicPtr(p_extrinsic), m_params(params), m_emit(std::move(emit)),
+      m_rows(gridRows(*p_cam_params)), m_cols(gridCols(*p_cam_params)), m_projector(*p_cam_params->m_intrinsicPtr, m_rows, m_cols),
+      m_gridPool(poolSize)
+{
+    if (!m_emit)
+    {
+        throw std::runtime_error("ScanAccumulator requires a frame emit function.");
+    }
+    m_gridPtr = m_gridPool.acquire(m_rows, m_cols, 3);
+    m_gridPtr->setZero();
+}
+
+const AccumulatorParameters& ScanAccumulator::getParams() const
+{
+    return m_params;
+}
+
+size_t ScanAccumulator::getPendingPoints() const
+{
+    return m_framePoints;
+}
+
+template <typename T>
+void ScanAccumulator::addPoints(const T* p_points, const size_t num_points, const std::chrono::microseconds& timestamp, const bool frame_end)
+{
+    if (m_framePoints > 0 && m_params.m_frameDuration.count() > 0 && timestamp - m_frameStart >= m_params.m_frameDuration)
+    {
+        emitFrame();
+    }
+    if (m_framePoints == 0)
+    {
+        m_frameStart = timestamp;
+    }
+
+    // Condition a copy of the batch, whose buffer keeps its capacity between batches
+    m_batch.resize(3 * num_points);
+    std::transform(p_points, p_points + 3 * num_points, m_batch.begin(), [](const T value) { return static_cast<float>(value); });
+    m_sensorInterfacePtr->conditionPoints(m_batch);
+    insertBatch();
+
+    if (frame_end || (m_params.m_maxFramePoints > 0 && m_framePoints >= m_params.m_maxFramePoints))
+    {
+        endFrame();
+    }
+}
+
+void ScanAccumulator::endFrame()
+{
+    if (m_framePoints > 0)
+    {
+        emitFrame();
+    }
+}
+
+void ScanAccumulator::reset()
+{
+    m_gridPtr->setZero();
+    m_framePoints = 0;
+}
+
+template void ScanAccumulator::addPoints<float>(const float*, size_t, const std::chrono::microseconds&, bool);
+template void ScanAccumulator::addPoints<double>(const double*, size_t, const std::chrono::microseconds&, bool);
@@ -0,0 +1,222 @@
+#include "listener_processing/TemporalFilter.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/TensorPool.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/CompositeFrame.h"
+
+namespace
+{
+    constexpr int pixelChunk = 4096;
+}
+
+void TemporalFilter::initializeHistory(const int rows, const int cols)
+{
+    m_rows = rows;
+    m_cols = cols;
+    m_head = 0;
+
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    switch (m_params.m_mode)
+    {
+    case TemporalFilterMode::EXPONENTIAL:
+        m_state.assign(3 * plane, 0.0f);
+        m_stateMask.assign(plane, 0);
+        break;
+    case TemporalFilterMode::MEDIAN:
+        m_history.assign(m_historySize * plane, 0.0f);
+        m_historyMask.assign(m_historySize * plane, 0);
+        break;
+    case TemporalFilterMode::MASKED_MEAN:
+        m_history.assign(m_historySize * 3 * plane, 0.0f);
+        m_historyMask.assign(m_historySize * plane, 0);
+        m_sums.assign(3 * plane, 0.0);
+        m_counts.assign(plane, 0);
+        break;
+    }
+}
+
+void TemporalFilter::filterExponential(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask)
+{
+    const int plane = m_rows * m_cols;
+    const float alpha = m_params.m_alpha;
+    const float depth_factor = m_params.m_maxDepthChangeFactor;
+    float* p_state = m_state.data();
+    unsigned char* p_state_mask = m_stateMask.data();
+
+    listener_utils::parallelFor(0, plane, [&](const int pixel_begin, const int pixel_end)
+    {
+        for (int p = pixel_begin; p < pixel_end; ++p)
+        {
+            const float depth = p_grid[p + 2 * plane];
+            const bool depth_kept = depth_factor <= 0.0f || std::abs(depth - p_state[p + 2 * plane]) <= depth_factor * std::abs(depth);
+            const float weight = (p_state_mask[p] && p_mask[p] && depth_kept) ? alpha : 1.0f;
+            for (int k = 0; k < 3; ++k)
+            {
+                const int index = p + k * plane;
+                p_state[index] += weight * (p_grid[index] - p_state[index]);
+                p_out[index] = p_state[index];
+            }
+            p_state_mask[p] = p_mask[p];
+            p_out_mask[p] = p_mask[p];
+        }
+    }, m_params.m_numThreads, pixelChunk);
+}
+
+void TemporalFilter::filterMedian(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask)
+{
+    const int plane = m_rows * m_cols;
+    const int history_size = m_historySize;
+    const int min_samples = std::max(1, m_params.m_minValidSamples);
+    float* p_history = m_history.data();
+    unsigned char* p_history_mask = m_historyMask.data();
+    const size_t slot = static_cast<size_t>(m_head) * plane;
+
+    listener_utils::parallelFor(0, plane, [&](const int pixel_begin, const int pixel_end)
+    {
+        // Only depths are kept in the ring, overwriting the oldest slot
+        for (int p = pixel_begin; p < pixel_end; ++p)
+        {
+            p_history[slot + p] = p_grid[p + 2 * plane];
+            p_history_mask[slot + p] = p_mask[p];
+        }
+
+        float window[maxHistorySize];
+        for (int p = pixel_begin; p < pixel_end; ++p)
+        {
+            // Insertion sort of the few valid samples of this pixel
+            int count = 0;
+            for (int n = 0; n < history_size; ++n)
+            {
+                const size_t index = n * static_cast<size_t>(plane) + p;
+                if (!p_history_mask[index])
+                {
+                    continue;
+                }
+                const float value = p_history[index];
+                int m = count++;
+                for (; m > 0 && window[m - 1] > value; --m)
+                {
+                    window[m] = window[m - 1];
+                }
+                window[m] = value;
+            }
+
+            const float depth = p_grid[p + 2 * plane];
+            const bool valid = p_mask[p] && count >= min_samples && depth != 0.0f;
+            const float scale = valid ? window[(count - 1) / 2] / depth : 0.0f;
+            for (int k = 0; k < 3; ++k)
+            {
+                p_out[p + k * plane] = p_grid[p + k * plane] * scale;
+            }
+            p_out_mask[p] = valid;
+        }
+    }, m_params.m_numThreads, pixelChunk);
+}
+
+void TemporalFilter::filterMaskedMean(const float* p_grid, const bool* p_mask, float* p_out, bool* p_out_mask)
+{
+    const int plane = m_rows * m_cols;
+    const int min_samples = std::max(1, m_params.m_minValidSamples);
+    float* p_slot = m_history.data() + static_cast<size_t>(m_head) * 3 * plane;
+    unsigned char* p_slot_mask = m_historyMask.data() + static_cast<size_t>(m_head) * plane;
+    double* p_sums = m_sums.data();
+    unsigned short* p_counts = m_counts.data();
+
+    listener_utils::parallelFor(0, plane, [&](const int pixel_begin, const int pixel_end)
+    {
+        // Swap the oldest slot out of the running sums and the newest frame in, storing invalid points as zeros
+        for (int p = pixel_begin; p < pixel_end; ++p)
+        {
+            const float weight = p_mask[p] ? 1.0f : 0.0f;
+            p_counts[p] = static_cast<unsigned short>(p_counts[p] + p_mask[p] - p_slot_mask[p]);
+            p_slot_mask[p] = p_mask[p];
+
+            const bool valid = p_counts[p] >= min_samples;
+            const double inv_count = valid ? 1.0 / p_counts[p] : 0.0;
+            for (int k = 0; k < 3; ++k)
+            {
+                const int index = p + k * plane;
+                const float value = weight * p_grid[index];
+                p_sums[index] += static_cast<double>(value) - p_slot[index];
+                p_slot[index] = value;
+                p_out[index] = static_cast<float>(p_sums[index] * inv_count);
+            }
+            p_out_mask[p] = valid;
+        }
+    }, m_params.m_numThreads, pixelChunk);
+}
+
+TemporalFilter::TemporalFilter(const TemporalFilterParameters& params)
+    : m_params(params), m_historySize(std::clamp(params.m_historySize, 1, maxHistorySize)), m_gridPool(poolSize), m_maskPool(poolSize)
+{
+}
+
+const TemporalFilterParameters& TemporalFilter::getParams() const
+{
+    return m_params;
+}
+
+void TemporalFilter::reset()
+{
+    initializeHistory(m_rows, m_cols);
+}
+
+std::pair<std::shared_ptr<GridFrame>, std::shared_ptr<MaskFrame>> TemporalFilter::filter(const GridFrame& grid_frame, const MaskFrame& mask_frame)
+{
+    const int rows = grid_frame.getRows();
+    const int cols = grid_frame.getCols();
+    if (mask_frame.getRows() != rows || mask_frame.getCols() != cols)
+    {
+        throw std::runtime_error("Point cloud mask resolution does not match point cloud grid resolution.");
+    }
+    if (rows != m_rows || cols != m_cols)
+    {
+        initializeHistory(rows, cols);
+    }
+
+    auto p_out_grid = m_gridPool.acquire(rows, cols, 3);
+    auto p_out_mask = m_maskPool.acquire(rows, cols, 1);
+    const float* p_grid = grid_frame.getData().data();
+    const bool* p_mask = mask_frame.getData().data();
+    switch (m_params.m_mode)
+    {
+    case TemporalFilterMode::EXPONENTIAL:
+        filterExponential(p_grid, p_mask, p_out_grid->data(), p_out_mask->data());
+        break;
+    case TemporalFilterMode::MEDIAN:
+        filterMedian(p_grid, p_mask, p_out_grid->data(), p_out_mask->data());
+        break;
+    case TemporalFilterMode::MASKED_MEAN:
+        filterMaskedMean(p_grid, p_mask, p_out_grid->data(), p_out_mask->data());
+        break;
+    }
+    m_head = (m_head + 1) % m_historySize;
+
+    return {std::make_shared<GridFrame>(p_out_grid, grid_frame.getCamParams(), grid_frame.getExtrinsic()),
+            std::make_shared<MaskFrame>(p_out_mask, mask_frame.getCamParams(), mask_frame.getExtrinsic())};
+}
+
+void TemporalFilter::process(CompositeFrame& composite_frame)
+{
+    if (!composite_frame.has(FrameID::POINTCLOUD_GRID))
+    {
+        return;
+    }
+    const auto p_grid_frame = std::static_pointer_cast<GridFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_GRID));
+    const auto p_mask_frame = std::static_pointer_cast<MaskFrame>(composite_frame.getFrame(FrameID::POINTCLOUD_MASK));
+    const auto result = filter(*p_grid_frame, *p_mask_frame);
+    composite_frame.addFrame(FrameID::POINTCLOUD_MASK, result.second);
+    composite_frame.addFrame(FrameID::POINTCLOUD_GRID, result.first);
+}
@@ -0,0 +1,219 @@
+#include "listener_utils/AsyncFrameWriter.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <iostream>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <filesystem>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/RecordingWriter.h"
+#include "listener_utils/DatasetIndex.h"
+#include "listener_frames/CompositeFrame.h"
+#include "listener_frames/GenericDataFrame.h"
+
+void AsyncFrameWriter::workerLoop()
+{
+    while (true)
+    {
+        WriteJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobEvent.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        try
+        {
+            if (m_recordingPtr)
+            {
+                m_recordingPtr->append(job.m_frameNumber, job.m_timestamp, job.m_frameID, *job.m_dataFramePtr);
+            }
+            else if (job.m_npyWriterPtr)
+            {
+                EncodingParameters encoding_params = m_params.m_encodingParams;
+                encoding_params.m_npyWriterPtr = job.m_npyWriterPtr;
+                job.m_dataFramePtr->save(job.m_filePath, encoding_params);
+            }
+            else
+            {
+                job.m_dataFramePtr->save(job.m_filePath, m_params.m_encodingParams);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to write " << FrameIDUtils::toString(job.m_frameID) << " of frame " << job.m_frameNumber << ": " << e.what() << std::endl;
+            job.m_progressPtr->m_failed.store(true);
+            std::lock_guard lock(m_mutex);
+            ++m_stats.m_writeErrors;
+        }
+
+        // The last job of a frame syncs the frame's NPY files and releases its slot in the queue
+        if (job.m_progressPtr->m_remainingJobs.fetch_sub(1) != 1)
+        {
+            continue;
+        }
+        bool sync_failed = false;
+        if (job.m_npyWriterPtr)
+        {
+            try
+            {
+                job.m_npyWriterPtr->finish();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Failed to sync frame " << job.m_frameNumber << ": " << e.what() << std::endl;
+                sync_failed = true;
+            }
+        }
+        std::lock_guard lock(m_mutex);
+        m_stats.m_writeErrors += sync_failed;
+        if (sync_failed || job.m_progressPtr->m_failed.load())
+        {
+            ++m_stats.m_framesFailed;
+            m_failedFrames.insert(job.m_frameNumber);
+        }
+        else
+        {
+            ++m_stats.m_framesWritten;
+        }
+        --m_queuedFrames;
+        m_doneEvent.notify_all();
+    }
+}
+
+AsyncFrameWriter::AsyncFrameWriter(const std::string& save_dir, const WriterParameters& params)
+    : m_saveDir(save_dir), m_params(params)
+{
+    if (m_params.m_maxQueuedFrames == 0)
+    {
+        throw std::runtime_error("Frame writer queue must hold at least one frame.");
+    }
+    const unsigned int num_threads = listener_utils::getNumThreads(m_params.m_numThreads);
+    m_workers.reserve(num_threads);
+    for (unsigned int t = 0; t < num_threads; ++t)
+    {
+        m_workers.emplace_back(&AsyncFrameWriter::workerLoop, this);
+    }
+}
+
+AsyncFrameWriter::~AsyncFrameWriter()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_jobEvent.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_recordingPtr.reset();
+
+    // Index the recorded directories once all files are written
+    if (!m_createdDirs.empty())
+    {
+        try
+        {
+            DatasetIndex index = DatasetIndex::scan(m_saveDir, std::vector<FrameID>(m_createdDirs.begin(), m_createdDirs.end()));
+            index.removeFrames(m_failedFrames);
+            index.setTimestamps(m_timestamps);
+            index.save();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to index recording in " << m_saveDir << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+bool AsyncFrameWriter::submit(const std::shared_ptr<CompositeFrame> p_composite_frame, const unsigned int frame_number)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ++m_stats.m_framesSubmitted;
+    if (m_queuedFrames >= m_params.m_maxQueuedFrames)
+    {
+        if (m_params.m_overflow == WriterOverflow::DROP)
+        {
+            ++m_stats.m_framesDropped;
+            return false;
+        }
+        const auto wait_start = std::chrono::steady_clock::now();
+        m_doneEvent.wait(lock, [this] { return m_queuedFrames < m_params.m_maxQueuedFrames; });
+        m_stats.m_blockedTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - wait_start);
+    }
+
+    const std::vector<FrameID> frame_ids = p_composite_frame->getFrameIDs();
+    if (frame_ids.empty())
+    {
+        ++m_stats.m_framesEmpty;
+        return true;
+    }
+    const auto p_progress = std::make_shared<FrameProgress>(static_cast<int>(frame_ids.size()));
+    const std::chrono::microseconds& timestamp = p_composite_frame->getTimestamp();
+    if (m_params.m_layout == WriterLayout::CONTAINER)
+    {
+        // Stream parameters are stored once, from the first frame of the recording
+        if (!m_recordingPtr)
+        {
+            const auto p_first_frame = p_composite_frame->getFrame(frame_ids.front());
+            std::filesystem::create_directories(m_saveDir);
+            m_recordingPtr = std::make_unique<RecordingWriter>(m_saveDir + "/" + recordingName, p_first_frame->getCamParams(), p_first_frame->getExtrinsic());
+        }
+        for (const FrameID frame_id : frame_ids)
+        {
+            m_jobs.push_back({p_composite_frame->getFrame(frame_id), std::string(), p_progress, nullptr, frame_id, frame_number, timestamp});
+        }
+    }
+    else
+    {
+        m_timestamps[frame_number] = timestamp;
+        const auto p_npy_writer = m_params.m_npySync == NpySync::NONE ? nullptr : std::make_shared<NpyWriter>(m_params.m_npySync);
+        for (const FrameID frame_id : frame_ids)
+        {
+            const std::string& id_string = FrameIDUtils::toString(frame_id);
+            const std::string frame_dir = m_saveDir + "/" + id_string;
+            if (m_createdDirs.insert(frame_id).second)
+            {
+                std::filesystem::create_directories(frame_dir);
+            }
+            m_jobs.push_back({p_composite_frame->getFrame(frame_id), frame_dir + "/" + id_string + std::to_string(frame_number), p_progress, p_npy_writer, frame_id, frame_number, timestamp});
+        }
+    }
+    ++m_queuedFrames;
+    m_stats.m_peakQueuedFrames = std::max(m_stats.m_peakQueuedFrames, m_queuedFrames);
+    lock.unlock();
+    m_jobEvent.notify_all();
+    return true;
+}
+
+void AsyncFrameWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneEvent.wait(lock, [this] { return m_queuedFrames == 0; });
+}
+
+size_t AsyncFrameWriter::getQueuedFrames() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_queuedFrames;
+}
+
+WriterStatistics AsyncFrameWriter::getStatistics() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,412 @@
+#include "listener_utils/DatasetIndex.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <natural_sort.hpp>
+
+#include "listener_utils/general_utils.hpp"
+
+namespace
+{
+    constexpr char indexMagic[8] = {'L', 'L', 'D', 'S', 'I', 'N', 'D', 'X'};
+    constexpr uint32_t indexVersion = 2;
+    constexpr uint32_t flagTimestamps = 1;
+
+    struct IndexFile
+    {
+        std::string m_name;
+        long long m_frameNumber;
+    };
+
+    /*!
+     * @brief Helper function to get the frame number at the end of a file name, before its extension.
+     *
+     * @return Frame number, or -1 if the name does not end in digits
+     */
+    long long parseFrameNumber(const std::string& file_name)
+    {
+        const std::string stem = std::filesystem::path(file_name).stem().string();
+        size_t first_digit = stem.size();
+        while (first_digit > 0 && std::isdigit(static_cast<unsigned char>(stem[first_digit - 1])))
+        {
+            --first_digit;
+        }
+        if (first_digit == stem.size() || stem.size() - first_digit > 18)
+        {
+            return -1;
+        }
+        return std::stoll(stem.substr(first_digit));
+    }
+
+    int64_t getDirTime(const std::string& dir)
+    {
+        return static_cast<int64_t>(std::filesystem::last_write_time(dir).time_since_epoch().count());
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream& file, const T value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /*!
+     * @brief Helper class to read values from an index file buffer with bounds checking.
+     */
+    class IndexParser
+    {
+        const std::vector<char>& m_buffer;
+        size_t m_offset = 0;
+
+    public:
+
+        explicit IndexParser(const std::vector<char>& buffer)
+            : m_buffer(buffer)
+        {
+        }
+
+        const char* take(const size_t size)
+        {
+            if (size > m_buffer.size() - m_offset)
+            {
+                throw std::runtime_error("Dataset index is truncated.");
+            }
+            const char* p_data = m_buffer.data() + m_offset;
+            m_offset += size;
+            return p_data;
+        }
+
+        template <typename T>
+        T read()
+        {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+    };
+}
+
+std::string DatasetIndex::getFrameDir(const FrameID frame_id) const
+{
+    return m_flat ? m_dataDir : m_dataDir + "/" + FrameIDUtils::toString(frame_id);
+}
+
+size_t DatasetIndex::getColumn(const FrameID frame_id) const
+{
+    const auto it = std::find(m_frameIDs.begin(), m_frameIDs.end(), frame_id);
+    if (it == m_frameIDs.end())
+    {
+        throw std::runtime_error("Dataset index contains no " + FrameIDUtils::toString(frame_id) + " data.");
+    }
+    return static_cast<size_t>(it - m_frameIDs.begin());
+}
+
+std::unique_ptr<DatasetIndex> DatasetIndex::read(const std::string& data_dir)
+{
+    const std::string index_path = data_dir + "/" + fileName;
+    std::ifstream file(index_path, std::ios::binary);
+    if (!file)
+    {
+        return nullptr;
+    }
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    IndexParser parser(buffer);
+    if (std::memcmp(parser.take(sizeof(indexMagic)), indexMagic, sizeof(indexMagic)) != 0 || parser.read<uint32_t>() != indexVersion)
+    {
+        throw std::runtime_error("File " + index_path + " is not a dataset index of a supported version.");
+    }
+
+    std::unique_ptr<DatasetIndex> p_index(new DatasetIndex());
+    p_index->m_dataDir = data_dir;
+    p_index->m_hasTimestamps = (parser.read<uint32_t>() & flagTimestamps) != 0;
+    const auto num_frame_ids = parser.read<uint32_t>();
+    const auto num_frames = parser.read<uint64_t>();
+    for (uint32_t c = 0; c < num_frame_ids; ++c)
+    {
+        p_index->m_frameIDs.push_back(static_cast<FrameID>(parser.read<uint32_t>()));
+        p_index->m_dirTimes.push_back(parser.read<int64_t>());
+    }
+    // Every frame takes at least 12 bytes, which bounds the allocation for corrupt counts
+    p_index->m_frames.reserve(std::min<uint64_t>(num_frames, buffer.size() / 12));
+    for (uint64_t i = 0; i < num_frames; ++i)
+    {
+        FrameRecord record;
+        record.m_frameNumber = parser.read<uint32_t>();
+        record.m_timestamp = std::chrono::microseconds(parser.read<int64_t>());
+        for (uint32_t c = 0; c < num_frame_ids; ++c)
+        {
+            const auto name_size = parser.read<uint32_t>();
+            record.m_fileNames.emplace_back(parser.take(name_size), name_size);
+        }
+        p_index->m_frames.push_back(std::move(record));
+    }
+    return p_index;
+}
+
+DatasetIndex DatasetIndex::scan(const std::string& data_dir, const std::vector<FrameID>& frame_ids, const bool flat)
+{
+    if (frame_ids.empty() || (flat && frame_ids.size() != 1))
+    {
+        throw std::runtime_error("Dataset index needs one FrameID for flat data, or at least one otherwise.");
+    }
+    DatasetIndex index;
+    index.m_dataDir = data_dir;
+    index.m_flat = flat;
+    index.m_frameIDs = frame_ids;
+
+    // List and naturally sort the files of every FrameID
+    std::vector<std::vector<IndexFile>> columns;
+    bool numbered = true;
+    for (const auto& frame_id : frame_ids)
+    {
+        const std::string frame_dir = index.getFrameDir(frame_id);
+        index.m_dirTimes.push_back(getDirTime(frame_dir));
+        std::vector<IndexFile> files;
+        for (const auto& entry : std::filesystem::directory_iterator(frame_dir))
+        {
+            const std::string name = entry.path().filename().string();
+            if (!entry.is_regular_file() || name == fileName)
+            {
+                continue;
+            }
+            files.push_back({name, parseFrameNumber(name)});
+            numbered &= files.back().m_frameNumber >= 0;
+        }
+        std::sort(files.begin(), files.end(), [](const IndexFile& first, const IndexFile& second) { return SI::natural::compare(first.m_name, second.m_name); });
+        columns.push_back(std::move(files));
+    }
+
+    const auto add_frame = [&index](const unsigned int frame_number, const std::vector<const IndexFile*>& files)
+    {
+        FrameRecord record{frame_number, std::chrono::microseconds(0), {}};
+        for (const IndexFile* p_file : files)
+        {
+            record.m_fileNames.push_back(p_file->m_name);
+        }
+        index.m_frames.push_back(std::move(record));
+    };
+    if (numbered && columns.size() > 1)
+    {
+        // Align by frame number, keeping only frames present for every FrameID
+        std::vector<std::unordered_map<long long, const IndexFile*>> lookups(columns.size());
+        for (size_t c = 1; c < columns.size(); ++c)
+        {
+            for (const auto& file : columns[c])
+            {
+                lookups[c].emplace(file.m_frameNumber, &file);
+            }
+        }
+        for (const auto& file : columns[0])
+        {
+            std::vector<const IndexFile*> files = {&file};
+            for (size_t c = 1; c < columns.size(); ++c)
+            {
+                const auto it = lookups[c].find(file.m_frameNumber);
+                if (it == lookups[c].end())
+                {
+                    break;
+                }
+                files.push_back(it->second);
+            }
+            if (files.size() == columns.size())
+            {
+                add_frame(static_cast<unsigned int>(file.m_frameNumber), files);
+            }
+        }
+    }
+    else
+    {
+        // Without frame numbers there is no way to tell which frames are missing, so streams must line up exactly
+        for (size_t c = 1; c < columns.size(); ++c)
+        {
+            if (columns[c].size() != columns[0].size())
+            {
+                throw std::runtime_error("Saved data in " + data_dir + " has " + std::to_string(columns[c].size()) + " " + FrameIDUtils::toString(frame_ids[c]) + " files but " +
+                                         std::to_string(columns[0].size()) + " " + FrameIDUtils::toString(frame_ids[0]) + " files, which cannot be aligned without frame numbers in their names.");
+            }
+        }
+        for (size_t i = 0; i < columns[0].size(); ++i)
+        {
+            std::vector<const IndexFile*> files;
+            for (const auto& column : columns)
+            {
+                files.push_back(&column[i]);
+            }
+            add_frame(numbered ? static_cast<unsigned int>(columns[0][i].m_frameNumber) : static_cast<unsigned int>(i), files);
+        }
+    }
+
+    for (size_t c = 0; c < columns.size(); ++c)
+    {
+        if (columns[c].size() != index.m_frames.size())
+        {
+            std::cerr << "Saved data in " << data_dir << " has " << columns[c].size() << " " << FrameIDUtils::toString(frame_ids[c]) << " files, using the " << index.m_frames.size() << " frames present for every frame type." << std::endl;
+        }
+    }
+    return index;
+}
+
+DatasetIndex DatasetIndex::open(const std::string& data_dir, const std::vector<FrameID>& frame_ids)
+{
+    std::unique_ptr<DatasetIndex> p_cached;
+    try
+    {
+        p_cached = read(data_dir);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Ignoring dataset index: " << e.what() << std::endl;
+    }
+    // Frames are aligned across every indexed FrameID, so only an index of exactly the requested FrameIDs can be reused.
+    // An index of more FrameIDs would drop frames missing only from FrameIDs that were not requested.
+    bool superset = false;
+    if (p_cached && p_cached->isCurrent())
+    {
+        const bool covered = std::all_of(frame_ids.begin(), frame_ids.end(), [&p_cached](const FrameID frame_id)
+        {
+            return std::find(p_cached->m_frameIDs.begin(), p_cached->m_frameIDs.end(), frame_id) != p_cached->m_frameIDs.end();
+        });
+        if (covered && p_cached->m_frameIDs.size() == frame_ids.size())
+        {
+            return std::move(*p_cached);
+        }
+        superset = covered;
+    }
+
+    DatasetIndex index = scan(data_dir, frame_ids);
+    if (p_cached && p_cached->m_hasTimestamps)
+    {
+        std::unordered_map<unsigned int, std::chrono::microseconds> timestamps;
+        for (const auto& record : p_cached->m_frames)
+        {
+            timestamps[record.m_frameNumber] = record.m_timestamp;
+        }
+        index.setTimestamps(timestamps);
+    }
+    // A current index of more FrameIDs is kept in place for the datasets opened with all of them
+    if (superset)
+    {
+        return index;
+    }
+    try
+    {
+        index.save();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to cache dataset index: " << e.what() << std::endl;
+    }
+    return index;
+}
+
+void DatasetIndex::save() const
+{
+    if (m_flat)
+    {
+        throw std::runtime_error("Dataset index of flat data cannot be cached alongside it.");
+    }
+    const std::string index_path = m_dataDir + "/" + fileName;
+    std::ofstream file(index_path, std::ios::binary | std::ios::trunc);
+    file.write(indexMagic, sizeof(indexMagic));
+    writeValue<uint32_t>(file, indexVersion);
+    writeValue<uint32_t>(file, m_hasTimestamps ? flagTimestamps : 0);
+    writeValue<uint32_t>(file, static_cast<uint32_t>(m_frameIDs.size()));
+    writeValue<uint64_t>(file, m_frames.size());
+    for (size_t c = 0; c < m_frameIDs.size(); ++c)
+    {
+        writeValue<uint32_t>(file, static_cast<uint32_t>(m_frameIDs[c]));
+        writeValue<int64_t>(file, m_dirTimes[c]);
+    }
+    for (const auto& record : m_frames)
+    {
+        writeValue<uint32_t>(file, record.m_frameNumber);
+        writeValue<int64_t>(file, record.m_timestamp.count());
+        for (size_t c = 0; c < m_frameIDs.size(); ++c)
+        {
+            writeValue<uint32_t>(file, static_cast<uint32_t>(record.m_fileNames[c].size()));
+            file.write(record.m_fileNames[c].data(), static_cast<std::streamsize>(record.m_fileNames[c].size()));
+        }
+    }
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write dataset index " + index_path + ".");
+    }
+}
+
+bool DatasetIndex::isCurrent() const
+{
+    for (size_t c = 0; c < m_frameIDs.size(); ++c)
+    {
+        const std::string frame_dir = getFrameDir(m_frameIDs[c]);
+        if (!std::filesystem::is_directory(frame_dir) || getDirTime(frame_dir) != m_dirTimes[c])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DatasetIndex::setTimestamps(const std::unordered_map<unsigned int, std::chrono::microseconds>& timestamps)
+{
+    for (auto& record : m_frames)
+    {
+        const auto it = timestamps.find(record.m_frameNumber);
+        if (it != timestamps.end())
+        {
+            record.m_timestamp = it->second;
+            m_hasTimestamps = true;
+        }
+    }
+}
+
+void DatasetIndex::removeFrames(const std::unordered_set<unsigned int>& frame_numbers)
+{
+    m_frames.erase(std::remove_if(m_frames.begin(), m_frames.end(), [&frame_numbers](const FrameRecord& record)
+    {
+        return frame_numbers.count(record.m_frameNumber) != 0;
+    }), m_frames.end());
+}
+
+const std::vector<FrameID>& DatasetIndex::getFrameIDs() const
+{
+    return m_frameIDs;
+}
+
+bool DatasetIndex::hasTimestamps() const
+{
+    return m_hasTimestamps;
+}
+
+size_t DatasetIndex::getNumFrames() const
+{
+    return m_frames.size();
+}
+
+unsigned int DatasetIndex::getFrameNumber(const size_t index) const
+{
+    return m_frames.at(index).m_frameNumber;
+}
+
+std::chrono::microseconds DatasetIndex::getTimestamp(const size_t index) const
+{
+    return m_frames.at(index).m_timestamp;
+}
+
+std::string DatasetIndex::getPath(const size_t index, const FrameID frame_id) const
+{
+    return getFrameDir(frame_id) + "/" + m_frames.at(index).m_fileNames[getColumn(frame_id)];
+}
+
@@ -0,0 +1,380 @@
+#include "listener_utils/GridCodec.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/parallel_utils.hpp"
+
+namespace
+{
+    constexpr char codecMagic[4] = {'L', 'G', 'R', 'C'};
+    constexpr uint16_t codecVersion = 1;
+    constexpr uint16_t quantizedFlag = 1;
+    constexpr size_t blockSize = 32;
+    constexpr size_t segmentSize = 1024 * blockSize;
+    constexpr float maxSteps = 2147483520.0f;
+
+    struct CodecHeader
+    {
+        char m_magic[4];
+        uint16_t m_version;
+        uint16_t m_flags;
+        int32_t m_rows;
+        int32_t m_cols;
+        int32_t m_channels;
+        float m_quantization;
+        uint32_t m_numSegments;
+        uint32_t m_reserved;
+    };
+
+    static_assert(sizeof(CodecHeader) == 32, "Unexpected grid codec header size.");
+
+    using PackFunction = void (*)(const uint32_t*, uint8_t*);
+    using UnpackFunction = void (*)(const uint8_t*, uint32_t*);
+
+    /*!
+     * @brief Packs a block of values into width bits each, using exactly 4 * width bytes.
+     *
+     * @tparam Width Number of bits kept from each value
+     */
+    template <int Width>
+    void packBlock(const uint32_t* p_values, uint8_t* p_out)
+    {
+        uint64_t buffer = 0;
+        int buffered_bits = 0;
+        for (size_t j = 0; j < blockSize; ++j)
+        {
+            buffer |= static_cast<uint64_t>(p_values[j]) << buffered_bits;
+            buffered_bits += Width;
+            if (buffered_bits >= 32)
+            {
+                const auto word = static_cast<uint32_t>(buffer);
+                std::memcpy(p_out, &word, sizeof(word));
+                p_out += sizeof(word);
+                buffer >>= 32;
+                buffered_bits -= 32;
+            }
+        }
+    }
+
+    /*!
+     * @brief Unpacks a block of values packed by packBlock, reading exactly 4 * width bytes.
+     *
+     * @tparam Width Number of bits stored for each value
+     */
+    template <int Width>
+    void unpackBlock(const uint8_t* p_in, uint32_t* p_values)
+    {
+        constexpr uint64_t mask = (uint64_t(1) << Width) - 1;
+        uint64_t buffer = 0;
+        int buffered_bits = 0;
+        for (size_t j = 0; j < blockSize; ++j)
+        {
+            if (buffered_bits < Width)
+            {
+                uint32_t word;
+                std::memcpy(&word, p_in, sizeof(word));
+                p_in += sizeof(word);
+                buffer |= static_cast<uint64_t>(word) << buffered_bits;
+                buffered_bits += 32;
+            }
+            p_values[j] = static_cast<uint32_t>(buffer & mask);
+            buffer >>= Width;
+            buffered_bits -= Width;
+        }
+    }
+
+    template <size_t... Widths>
+    constexpr std::array<PackFunction, sizeof...(Widths)> makePackTable(std::index_sequence<Widths...>)
+    {
+        return {&packBlock<static_cast<int>(Widths)>...};
+    }
+
+    template <size_t... Widths>
+    constexpr std::array<UnpackFunction, sizeof...(Widths)> makeUnpackTable(std::index_sequence<Widths...>)
+    {
+        return {&unpackBlock<static_cast<int>(Widths)>...};
+    }
+
+    constexpr auto packTable = makePackTable(std::make_index_sequence<33>());
+    constexpr auto unpackTable = makeUnpackTable(std::make_index_sequence<33>());
+
+    /*!
+     * @brief Helper function to map float bits to an integer with the same ordering, so that close values have close codes.
+     *
+     * The mapping is its own inverse.
+     */
+    inline uint32_t orderBits(const uint32_t bits)
+    {
+        return bits ^ (static_cast<uint32_t>(static_cast<int32_t>(bits) >> 31) >> 1);
+    }
+
+    /*!
+     * @brief Helper function to convert a grid value to its integer code.
+     *
+     * @tparam Quantized Whether values are coded as multiples of the quantization step rather than by their float bits
+     */
+    template <bool Quantized>
+    inline uint32_t toCode(const float value, const float inv_quantization)
+    {
+        if constexpr (Quantized)
+        {
+            // Non-finite values mark invalid points and are coded as 0, steps beyond the 32-bit range saturate
+            if (!std::isfinite(value))
+            {
+                return 0;
+            }
+            const float steps = std::clamp(value * inv_quantization, -maxSteps, maxSteps);
+            return static_cast<uint32_t>(static_cast<int32_t>(std::lrint(steps)));
+        }
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return orderBits(bits);
+    }
+
+    /*!
+     * @brief Helper function to convert an integer code back to its grid value.
+     *
+     * @tparam Quantized Whether values are coded as multiples of the quantization step rather than by their float bits
+     */
+    template <bool Quantized>
+    inline float fromCode(const uint32_t code, const float quantization)
+    {
+        if constexpr (Quantized)
+        {
+            return static_cast<float>(static_cast<int32_t>(code)) * quantization;
+        }
+        const uint32_t bits = orderBits(code);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /*!
+     * @brief Helper function to encode one segment of values, each block as a width byte followed by its packed residuals.
+     */
+    template <bool Quantized>
+    void encodeSegment(const float* p_values, const size_t count, const float inv_quantization, std::vector<uint8_t>& out)
+    {
+        out.resize((count + blockSize - 1) / blockSize * (1 + 4 * blockSize));
+        uint8_t* p_out = out.data();
+        uint32_t previous = 0;
+        std::array<uint32_t, blockSize> residuals;
+        for (size_t block_begin = 0; block_begin < count; block_begin += blockSize)
+        {
+            const size_t block_count = std::min(blockSize, count - block_begin);
+            uint32_t combined = 0;
+            for (size_t j = 0; j < block_count; ++j)
+            {
+                const uint32_t code = toCode<Quantized>(p_values[block_begin + j], inv_quantization);
+                const auto delta = static_cast<int32_t>(code - previous);
+                residuals[j] = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+                combined |= residuals[j];
+                previous = code;
+            }
+            std::fill(residuals.begin() + block_count, residuals.end(), 0u);
+
+            int width = 0;
+            while (width < 32 && (combined >> width) != 0)
+            {
+                ++width;
+            }
+            *p_out++ = static_cast<uint8_t>(width);
+            packTable[width](residuals.data(), p_out);
+            p_out += 4 * width;
+        }
+        out.resize(p_out - out.data());
+    }
+
+    /*!
+     * @brief Helper function to decode one segment of values.
+     *
+     * @return true if the segment was well formed, false if it ran past its bytes or held an invalid width
+     */
+    template <bool Quantized>
+    bool decodeSegment(const uint8_t* p_in, const size_t in_size, const float quantization, float* p_values, const size_t count)
+    {
+        const uint8_t* const p_end = p_in + in_size;
+        uint32_t previous = 0;
+        std::array<uint32_t, blockSize> residuals;
+        for (size_t block_begin = 0; block_begin < count; block_begin += blockSize)
+        {
+            if (p_in >= p_end)
+            {
+                return false;
+            }
+            const int width = *p_in++;
+            if (width > 32 || p_end - p_in < 4 * width)
+            {
+                return false;
+            }
+            unpackTable[width](p_in, residuals.data());
+            p_in += 4 * width;
+
+            const size_t block_count = std::min(blockSize, count - block_begin);
+            for (size_t j = 0; j < block_count; ++j)
+            {
+                const uint32_t residual = residuals[j];
+                previous += (residual >> 1) ^ (0u - (residual & 1u));
+                p_values[block_begin + j] = fromCode<Quantized>(previous, quantization);
+            }
+        }
+        return p_in == p_end;
+    }
+}
+
+namespace grid_codec
+{
+    std::vector<uint8_t> encode(const Eigen::Tensor<float, 3>& tensor, const float quantization, const unsigned int num_threads)
+    {
+        if (quantization < 0.0f)
+        {
+            throw std::runtime_error("Grid quantization step must not be negative.");
+        }
+        const auto num_values = static_cast<size_t>(tensor.size());
+        const size_t num_segments = (num_values + segmentSize - 1) / segmentSize;
+        const float inv_quantization = quantization > 0.0f ? 1.0f / quantization : 0.0f;
+
+        std::vector<std::vector<uint8_t>> segments(num_segments);
+        listener_utils::parallelFor(0, static_cast<int>(num_segments), [&](const int begin, const int end)
+        {
+            for (int s = begin; s < end; ++s)
+            {
+                const size_t offset = s * segmentSize;
+                const size_t count = std::min(segmentSize, num_values - offset);
+                if (quantization > 0.0f)
+                {
+                    encodeSegment<true>(tensor.data() + offset, count, inv_quantization, segments[s]);
+                }
+                else
+                {
+                    encodeSegment<false>(tensor.data() + offset, count, inv_quantization, segments[s]);
+                }
+            }
+        }, num_threads, 1);
+
+        CodecHeader header{};
+        std::memcpy(header.m_magic, codecMagic, sizeof(codecMagic));
+        header.m_version = codecVersion;
+        header.m_flags = quantization > 0.0f ? quantizedFlag : 0;
+        header.m_rows = static_cast<int32_t>(tensor.dimension(0));
+        header.m_cols = static_cast<int32_t>(tensor.dimension(1));
+        header.m_channels = static_cast<int32_t>(tensor.dimension(2));
+        header.m_quantization = quantization;
+        header.m_numSegments = static_cast<uint32_t>(num_segments);
+
+        // Segment end offsets let every segment be located without decoding the ones before it
+        std::vector<uint64_t> segment_ends(num_segments);
+        uint64_t payload_size = 0;
+        for (size_t s = 0; s < num_segments; ++s)
+        {
+            payload_size += segments[s].size();
+            segment_ends[s] = payload_size;
+        }
+
+        std::vector<uint8_t> out(sizeof(CodecHeader) + num_segments * sizeof(uint64_t) + payload_size);
+        std::memcpy(out.data(), &header, sizeof(CodecHeader));
+        if (num_segments > 0)
+        {
+            std::memcpy(out.data() + sizeof(CodecHeader), segment_ends.data(), num_segments * sizeof(uint64_t));
+        }
+        uint8_t* p_payload = out.data() + sizeof(CodecHeader) + num_segments * sizeof(uint64_t);
+        for (const auto& segment : segments)
+        {
+            std::memcpy(p_payload, segment.data(), segment.size());
+            p_payload += segment.size();
+        }
+        return out;
+    }
+
+    std::shared_ptr<Eigen::Tensor<float, 3>> decode(const uint8_t* p_data, const size_t size, const unsigned int num_threads)
+    {
+        CodecHeader header;
+        if (size < sizeof(CodecHeader))
+        {
+            throw std::runtime_error("Compressed grid is truncated.");
+        }
+        std::memcpy(&header, p_data, sizeof(CodecHeader));
+        if (std::memcmp(header.m_magic, codecMagic, sizeof(codecMagic)) != 0 || header.m_version != codecVersion)
+        {
+            throw std::runtime_error("Data is not a compressed grid of a supported version.");
+        }
+        if (header.m_rows < 0 || header.m_cols < 0 || header.m_channels < 0)
+        {
+            throw std::runtime_error("Compressed grid has invalid dimensions.");
+        }
+        const size_t num_values = static_cast<size_t>(header.m_rows) * header.m_cols * header.m_channels;
+        const size_t num_segments = (num_values + segmentSize - 1) / segmentSize;
+        const size_t payload_offset = sizeof(CodecHeader) + num_segments * sizeof(uint64_t);
+        if (header.m_numSegments != num_segments || size < payload_offset)
+        {
+            throw std::runtime_error("Compressed grid is truncated.");
+        }
+        std::vector<uint64_t> segment_ends(num_segments);
+        if (num_segments > 0)
+        {
+            std::memcpy(segment_ends.data(), p_data + sizeof(CodecHeader), num_segments * sizeof(uint64_t));
+        }
+        for (size_t s = 0; s < num_segments; ++s)
+        {
+            if (segment_ends[s] > size - payload_offset || (s > 0 && segment_ends[s] < segment_ends[s - 1]))
+            {
+                throw std::runtime_error("Compressed grid is truncated.");
+            }
+        }
+
+        const float quantization = (header.m_flags & quantizedFlag) != 0 ? header.m_quantization : 0.0f;
+        auto p_tensor = std::make_shared<Eigen::Tensor<float, 3>>(header.m_rows, header.m_cols, header.m_channels);
+        std::atomic<bool> corrupt = false;
+        listener_utils::parallelFor(0, static_cast<int>(num_segments), [&](const int begin, const int end)
+        {
+            for (int s = begin; s < end; ++s)
+            {
+                const uint64_t segment_begin = s == 0 ? 0 : segment_ends[s - 1];
+                const size_t offset = s * segmentSize;
+                const uint8_t* p_segment = p_data + payload_offset + segment_begin;
+                const size_t segment_bytes = segment_ends[s] - segment_begin;
+                const size_t count = std::min(segmentSize, num_values - offset);
+                const bool valid = quantization > 0.0f ? decodeSegment<true>(p_segment, segment_bytes, quantization, p_tensor->data() + offset, count)
+                                                       : decodeSegment<false>(p_segment, segment_bytes, quantization, p_tensor->data() + offset, count);
+                if (!valid)
+                {
+                    corrupt = true;
+                }
+            }
+        }, num_threads, 1);
+        if (corrupt)
+        {
+            throw std::runtime_error("Compressed grid is corrupt.");
+        }
+        return p_tensor;
+    }
+
+    void save(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor, const float quantization)
+    {
+        const std::vector<uint8_t> data = encode(tensor, quantization);
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write compressed grid " + file_path + ".");
+        }
+    }
+
+    std::shared_ptr<Eigen::Tensor<float, 3>> load(const std::string& file_path)
+    {
+        const MappedFile file(file_path);
+        return decode(file.getData(), file.getSize());
+    }
+}
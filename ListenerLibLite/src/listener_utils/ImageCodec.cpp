@@ -0,0 +1,402 @@
+#include "listener_utils/ImageCodec.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <array>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/tensor_utils.hpp"
+
+namespace
+{
+    constexpr char rawMagic[4] = {'L', 'R', 'A', 'W'};
+    constexpr uint8_t rawVersion = 1;
+    constexpr char qoiMagic[4] = {'q', 'o', 'i', 'f'};
+    constexpr size_t qoiHeaderSize = 14;
+    constexpr uint8_t qoiEndMarker[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    constexpr uint8_t qoiOpIndex = 0x00;
+    constexpr uint8_t qoiOpDiff = 0x40;
+    constexpr uint8_t qoiOpLuma = 0x80;
+    constexpr uint8_t qoiOpRun = 0xc0;
+    constexpr uint8_t qoiOpRgb = 0xfe;
+    constexpr uint8_t qoiOpRgba = 0xff;
+    constexpr uint8_t qoiMask = 0xc0;
+    constexpr int qoiMaxRun = 62;
+
+    struct RawHeader
+    {
+        char m_magic[4];
+        uint8_t m_version;
+        uint8_t m_channels;
+        uint16_t m_reserved;
+        uint32_t m_rows;
+        uint32_t m_cols;
+    };
+
+    static_assert(sizeof(RawHeader) == 16, "Unexpected raw image header size.");
+
+    struct QoiPixel
+    {
+        uint8_t m_r;
+        uint8_t m_g;
+        uint8_t m_b;
+        uint8_t m_a;
+
+        bool operator==(const QoiPixel& other) const
+        {
+            return m_r == other.m_r && m_g == other.m_g && m_b == other.m_b && m_a == other.m_a;
+        }
+    };
+
+    inline int qoiHash(const QoiPixel& px)
+    {
+        return (px.m_r * 3 + px.m_g * 5 + px.m_b * 7 + px.m_a * 11) % 64;
+    }
+
+    inline void writeBigEndian(uint8_t* p_out, const uint32_t value)
+    {
+        p_out[0] = static_cast<uint8_t>(value >> 24);
+        p_out[1] = static_cast<uint8_t>(value >> 16);
+        p_out[2] = static_cast<uint8_t>(value >> 8);
+        p_out[3] = static_cast<uint8_t>(value);
+    }
+
+    inline uint32_t readBigEndian(const uint8_t* p_in)
+    {
+        return static_cast<uint32_t>(p_in[0]) << 24 | static_cast<uint32_t>(p_in[1]) << 16 | static_cast<uint32_t>(p_in[2]) << 8 | p_in[3];
+    }
+
+    /*!
+     * @brief Helper function to write a whole buffer to a new file.
+     */
+    void writeFile(const std::string& file_path, const void* p_header, const size_t header_size, const void* p_data, const size_t data_size)
+    {
+        std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(p_header), static_cast<std::streamsize>(header_size));
+        file.write(static_cast<const char*>(p_data), static_cast<std::streamsize>(data_size));
+        if (!file)
+        {
+            throw std::runtime_error("Failed to write image " + file_path + ".");
+        }
+    }
+
+    /*!
+     * @brief Helper function to save an image as PNG through OpenCV, converting to interleaved BGR in one pass.
+     */
+    void savePng(const std::string& file_path, const unsigned char* p_planar, const int rows, const int cols, const int channels, const EncodingParameters& encoding_params, const unsigned char scale)
+    {
+        cv::Mat mat(rows, cols, channels == 1 ? CV_8UC1 : CV_8UC3);
+        const size_t plane = static_cast<size_t>(rows) * cols;
+        listener_utils::parallelFor(0, rows, [&](const int begin, const int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                unsigned char* p_row = mat.ptr<unsigned char>(i);
+                for (int j = 0; j < cols; ++j)
+                {
+                    const unsigned char* p_pixel = p_planar + listener_utils::planeIndex(i, j, rows);
+                    for (int k = 0; k < channels; ++k)
+                    {
+                        // OpenCV expects color channels in BGR order
+                        p_row[j * channels + k] = static_cast<unsigned char>(p_pixel[(channels - 1 - k) * plane] * scale);
+                    }
+                }
+            }
+        });
+
+        std::vector<int> params;
+        if (encoding_params.m_pngCompression >= 0)
+        {
+            params.insert(params.end(), {cv::IMWRITE_PNG_COMPRESSION, encoding_params.m_pngCompression});
+        }
+        params.insert(params.end(), {cv::IMWRITE_PNG_STRATEGY, static_cast<int>(encoding_params.m_pngStrategy)});
+        if (!cv::imwrite(file_path, mat, params))
+        {
+            throw std::runtime_error("Failed to write image " + file_path + ".");
+        }
+    }
+
+    /*!
+     * @brief Helper function to load an image through OpenCV, converting from interleaved BGR in one pass.
+     */
+    std::shared_ptr<Eigen::Tensor<unsigned char, 3>> loadOpenCv(const std::string& file_path, const int channels)
+    {
+        const cv::Mat mat = cv::imread(file_path, channels == 1 ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR);
+        if (mat.empty())
+        {
+            throw std::runtime_error("Failed to read image " + file_path + ".");
+        }
+        const int rows = mat.rows;
+        const int cols = mat.cols;
+        auto p_tensor = std::make_shared<Eigen::Tensor<unsigned char, 3>>(rows, cols, channels);
+        unsigned char* p_planar = p_tensor->data();
+        const size_t plane = static_cast<size_t>(rows) * cols;
+        listener_utils::parallelFor(0, rows, [&](const int begin, const int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                const unsigned char* p_row = mat.ptr<unsigned char>(i);
+                for (int j = 0; j < cols; ++j)
+                {
+                    unsigned char* p_pixel = p_planar + listener_utils::planeIndex(i, j, rows);
+                    for (int k = 0; k < channels; ++k)
+                    {
+                        p_pixel[(channels - 1 - k) * plane] = p_row[j * channels + k];
+                    }
+                }
+            }
+        });
+        return p_tensor;
+    }
+
+    /*!
+     * @brief Helper function to load an image saved with the RAW encoding.
+     */
+    std::shared_ptr<Eigen::Tensor<unsigned char, 3>> loadRaw(const std::string& file_path, const int channels)
+    {
+        const MappedFile file(file_path);
+        RawHeader header;
+        if (file.getSize() < sizeof(RawHeader))
+        {
+            throw std::runtime_error("Raw image " + file_path + " is truncated.");
+        }
+        std::memcpy(&header, file.getData(), sizeof(RawHeader));
+        if (std::memcmp(header.m_magic, rawMagic, sizeof(rawMagic)) != 0 || header.m_version != rawVersion)
+        {
+            throw std::runtime_error("File " + file_path + " is not a raw image of a supported version.");
+        }
+        const size_t plane = static_cast<size_t>(header.m_rows) * header.m_cols;
+        if (file.getSize() < sizeof(RawHeader) + plane * header.m_channels)
+        {
+            throw std::runtime_error("Raw image " + file_path + " is truncated.");
+        }
+        if (header.m_channels < channels)
+        {
+            throw std::runtime_error("Raw image " + file_path + " has fewer channels than requested.");
+        }
+
+        // Planes are stored in frame order, so the requested leading channels are a single contiguous copy
+        auto p_tensor = std::make_shared<Eigen::Tensor<unsigned char, 3>>(header.m_rows, header.m_cols, channels);
+        std::memcpy(p_tensor->data(), file.getData() + sizeof(RawHeader), plane * channels);
+        return p_tensor;
+    }
+}
+
+namespace image_codec
+{
+    std::vector<uint8_t> encodeQoi(const unsigned char* p_planar, const int rows, const int cols, const int channels, const unsigned char scale)
+    {
+        const size_t plane = static_cast<size_t>(rows) * cols;
+        std::vector<uint8_t> out(qoiHeaderSize + plane * 4 + sizeof(qoiEndMarker));
+        uint8_t* p_out = out.data();
+        std::memcpy(p_out, qoiMagic, sizeof(qoiMagic));
+        writeBigEndian(p_out + 4, static_cast<uint32_t>(cols));
+        writeBigEndian(p_out + 8, static_cast<uint32_t>(rows));
+        p_out[12] = 3;
+        p_out[13] = 0;
+        p_out += qoiHeaderSize;
+
+        std::array<QoiPixel, 64> index{};
+        QoiPixel previous{0, 0, 0, 255};
+        int run = 0;
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                const unsigned char* p_pixel = p_planar + listener_utils::planeIndex(i, j, rows);
+                QoiPixel px;
+                px.m_r = static_cast<uint8_t>(p_pixel[0] * scale);
+                px.m_g = channels == 1 ? px.m_r : static_cast<uint8_t>(p_pixel[plane] * scale);
+                px.m_b = channels == 1 ? px.m_r : static_cast<uint8_t>(p_pixel[2 * plane] * scale);
+                px.m_a = 255;
+
+                if (px == previous)
+                {
+                    if (++run == qoiMaxRun)
+                    {
+                        *p_out++ = qoiOpRun | (run - 1);
+                        run = 0;
+                    }
+                    continue;
+                }
+                if (run > 0)
+                {
+                    *p_out++ = qoiOpRun | (run - 1);
+                    run = 0;
+                }
+
+                const int hash = qoiHash(px);
+                if (index[hash] == px)
+                {
+                    *p_out++ = qoiOpIndex | hash;
+                }
+                else
+                {
+                    index[hash] = px;
+                    const auto vr = static_cast<int8_t>(px.m_r - previous.m_r);
+                    const auto vg = static_cast<int8_t>(px.m_g - previous.m_g);
+                    const auto vb = static_cast<int8_t>(px.m_b - previous.m_b);
+                    const int vg_r = vr - vg;
+                    const int vg_b = vb - vg;
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+                    {
+                        *p_out++ = qoiOpDiff | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2);
+                    }
+                    else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8)
+                    {
+                        *p_out++ = qoiOpLuma | (vg + 32);
+                        *p_out++ = static_cast<uint8_t>((vg_r + 8) << 4 | (vg_b + 8));
+                    }
+                    else
+                    {
+                        *p_out++ = qoiOpRgb;
+                        *p_out++ = px.m_r;
+                        *p_out++ = px.m_g;
+                        *p_out++ = px.m_b;
+                    }
+                }
+                previous = px;
+            }
+        }
+        if (run > 0)
+        {
+            *p_out++ = qoiOpRun | (run - 1);
+        }
+        std::memcpy(p_out, qoiEndMarker, sizeof(qoiEndMarker));
+        p_out += sizeof(qoiEndMarker);
+        out.resize(p_out - out.data());
+        return out;
+    }
+
+    std::shared_ptr<Eigen::Tensor<unsigned char, 3>> decodeQoi(const uint8_t* p_data, const size_t size, const int channels)
+    {
+        if (size < qoiHeaderSize + sizeof(qoiEndMarker) || std::memcmp(p_data, qoiMagic, sizeof(qoiMagic)) != 0)
+        {
+            throw std::runtime_error("Data is not a QOI image.");
+        }
+        const uint32_t cols = readBigEndian(p_data + 4);
+        const uint32_t rows = readBigEndian(p_data + 8);
+        const size_t plane = static_cast<size_t>(rows) * cols;
+        // Every pixel takes at least one byte unless it is part of a run
+        if (plane > (size - qoiHeaderSize) * qoiMaxRun)
+        {
+            throw std::runtime_error("QOI image is truncated.");
+        }
+
+        auto p_tensor = std::make_shared<Eigen::Tensor<unsigned char, 3>>(rows, cols, channels);
+        unsigned char* p_planar = p_tensor->data();
+        std::array<QoiPixel, 64> index{};
+        QoiPixel px{0, 0, 0, 255};
+        int run = 0;
+        const uint8_t* p_in = p_data + qoiHeaderSize;
+        const uint8_t* const p_chunks_end = p_data + size - sizeof(qoiEndMarker);
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            for (uint32_t j = 0; j < cols; ++j)
+            {
+                if (run > 0)
+                {
+                    --run;
+                }
+                else if (p_in < p_chunks_end)
+                {
+                    const uint8_t b1 = *p_in++;
+                    if (b1 == qoiOpRgb)
+                    {
+                        px.m_r = p_in[0];
+                        px.m_g = p_in[1];
+                        px.m_b = p_in[2];
+                        p_in += 3;
+                    }
+                    else if (b1 == qoiOpRgba)
+                    {
+                        px = {p_in[0], p_in[1], p_in[2], p_in[3]};
+                        p_in += 4;
+                    }
+                    else if ((b1 & qoiMask) == qoiOpIndex)
+                    {
+                        px = index[b1];
+                    }
+                    else if ((b1 & qoiMask) == qoiOpDiff)
+                    {
+                        px.m_r += ((b1 >> 4) & 0x03) - 2;
+                        px.m_g += ((b1 >> 2) & 0x03) - 2;
+                        px.m_b += (b1 & 0x03) - 2;
+                    }
+                    else if ((b1 & qoiMask) == qoiOpLuma)
+                    {
+                        const uint8_t b2 = *p_in++;
+                        const int vg = (b1 & 0x3f) - 32;
+                        px.m_r += vg - 8 + ((b2 >> 4) & 0x0f);
+                        px.m_g += vg;
+                        px.m_b += vg - 8 + (b2 & 0x0f);
+                    }
+                    else
+                    {
+                        run = b1 & 0x3f;
+                    }
+                    index[qoiHash(px)] = px;
+                }
+
+                unsigned char* p_pixel = p_planar + listener_utils::planeIndex(i, j, rows);
+                p_pixel[0] = px.m_r;
+                if (channels == 3)
+                {
+                    p_pixel[plane] = px.m_g;
+                    p_pixel[2 * plane] = px.m_b;
+                }
+            }
+        }
+        return p_tensor;
+    }
+
+    void save(const std::string& file_path, const unsigned char* p_planar, const int rows, const int cols, const int channels, const EncodingParameters& encoding_params, const bool binary)
+    {
+        const unsigned char scale = binary ? 255 : 1;
+        if (encoding_params.m_imageEncoding == ImageEncoding::RAW)
+        {
+            RawHeader header{};
+            std::memcpy(header.m_magic, rawMagic, sizeof(rawMagic));
+            header.m_version = rawVersion;
+            header.m_channels = static_cast<uint8_t>(channels);
+            header.m_rows = static_cast<uint32_t>(rows);
+            header.m_cols = static_cast<uint32_t>(cols);
+            writeFile(file_path + rawExtension, &header, sizeof(RawHeader), p_planar, static_cast<size_t>(rows) * cols * channels);
+        }
+        else if (encoding_params.m_imageEncoding == ImageEncoding::QOI)
+        {
+            const std::vector<uint8_t> data = encodeQoi(p_planar, rows, cols, channels, scale);
+            writeFile(file_path + qoiExtension, data.data(), data.size(), nullptr, 0);
+        }
+        else
+        {
+            savePng(file_path + ".png", p_planar, rows, cols, channels, encoding_params, scale);
+        }
+    }
+
+    std::shared_ptr<Eigen::Tensor<unsigned char, 3>> load(const std::string& file_path, const int channels)
+    {
+        const std::filesystem::path extension = std::filesystem::path(file_path).extension();
+        if (extension == rawExtension)
+        {
+            return loadRaw(file_path, channels);
+        }
+        if (extension == qoiExtension)
+        {
+            const MappedFile file(file_path);
+            return decodeQoi(file.getData(), file.getSize(), channels);
+        }
+        return loadOpenCv(file_path, channels);
+    }
+}
@@ -0,0 +1,112 @@
+#include "listener_utils/MappedFile.h"
+
+#include <string>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile(const std::string& file_path)
+{
+#ifdef _WIN32
+    m_fileHandle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_fileHandle = nullptr;
+        std::cerr << "Could not open file " << file_path << " for mapping." << std::endl;
+        throw std::runtime_error("Failed to open file for memory mapping.");
+    }
+    LARGE_INTEGER file_size;
+    GetFileSizeEx(m_fileHandle, &file_size);
+    m_size = static_cast<size_t>(file_size.QuadPart);
+    if (m_size == 0)
+    {
+        return;
+    }
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+        CloseHandle(m_fileHandle);
+        throw std::runtime_error("Failed to memory map file.");
+    }
+    m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        CloseHandle(m_mappingHandle);
+        CloseHandle(m_fileHandle);
+        throw std::runtime_error("Failed to memory map file.");
+    }
+#else
+    m_fileDescriptor = open(file_path.c_str(), O_RDONLY);
+    if (m_fileDescriptor < 0)
+    {
+        std::cerr << "Could not open file " << file_path << " for mapping." << std::endl;
+        throw std::runtime_error("Failed to open file for memory mapping.");
+    }
+    struct stat file_stat{};
+    fstat(m_fileDescriptor, &file_stat);
+    m_size = static_cast<size_t>(file_stat.st_size);
+    if (m_size == 0)
+    {
+        return;
+    }
+    void* p_map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (p_map == MAP_FAILED)
+    {
+        close(m_fileDescriptor);
+        throw std::runtime_error("Failed to memory map file.");
+    }
+    madvise(p_map, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const unsigned char*>(p_map);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle != nullptr)
+    {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle != nullptr)
+    {
+        CloseHandle(m_fileHandle);
+    }
+#else
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    if (m_fileDescriptor >= 0)
+    {
+        close(m_fileDescriptor);
+    }
+#endif
+}
+
+const unsigned char* MappedFile::getData() const
+{
+    return m_data;
+}
+
+size_t MappedFile::getSize() const
+{
+    return m_size;
+}
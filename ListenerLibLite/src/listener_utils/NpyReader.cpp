@@ -0,0 +1,177 @@
+#include "listener_utils/NpyReader.h"
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/tensor_utils.hpp"
+
+namespace
+{
+    constexpr int transposeTile = 32;
+
+    /*!
+     * @brief Helper function to find the value of a key in an NPY header dictionary.
+     *
+     * @param header NPY header dictionary text
+     * @param key Name of the key without quotes
+     * @return Text following the key's colon, up to the end of the header
+     */
+    std::string_view findValue(const std::string_view header, const std::string& key)
+    {
+        size_t key_pos = header.find("'" + key + "'");
+        if (key_pos == std::string_view::npos)
+        {
+            key_pos = header.find("\"" + key + "\"");
+        }
+        const size_t colon_pos = key_pos == std::string_view::npos ? key_pos : header.find(':', key_pos);
+        if (colon_pos == std::string_view::npos)
+        {
+            throw std::runtime_error("NPY header is missing '" + key + "'.");
+        }
+        const size_t value_pos = header.find_first_not_of(' ', colon_pos + 1);
+        return value_pos == std::string_view::npos ? std::string_view() : header.substr(value_pos);
+    }
+}
+
+void NpyReader::parseHeader()
+{
+    const auto* p_begin = reinterpret_cast<const char*>(m_file.getData());
+    const size_t file_size = m_file.getSize();
+    if (file_size < 10 || std::memcmp(p_begin, "\x93NUMPY", 6) != 0)
+    {
+        throw std::runtime_error("File is not a valid NPY file.");
+    }
+
+    // Version 1 stores a 2-byte header length, later versions a 4-byte one
+    const auto major_version = static_cast<unsigned char>(p_begin[6]);
+    size_t header_size;
+    size_t header_pos;
+    if (major_version == 1)
+    {
+        header_size = static_cast<unsigned char>(p_begin[8]) | static_cast<unsigned char>(p_begin[9]) << 8;
+        header_pos = 10;
+    }
+    else if (major_version <= 3 && file_size >= 12)
+    {
+        uint32_t length;
+        std::memcpy(&length, p_begin + 8, sizeof(length));
+        header_size = length;
+        header_pos = 12;
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported NPY version " + std::to_string(major_version) + ".");
+    }
+    if (header_pos + header_size > file_size)
+    {
+        throw std::runtime_error("NPY header is truncated.");
+    }
+    const std::string_view header(p_begin + header_pos, header_size);
+    m_dataOffset = header_pos + header_size;
+    if (m_dataOffset % alignof(float) != 0)
+    {
+        throw std::runtime_error("NPY header is not padded to keep the array aligned.");
+    }
+
+    const std::string_view descr = findValue(header, "descr");
+    if (descr.substr(1, 3) != "<f4")
+    {
+        throw std::runtime_error("Only little-endian float32 NPY arrays are supported.");
+    }
+    m_fortranOrder = findValue(header, "fortran_order").substr(0, 4) == "True";
+
+    const std::string_view shape_value = findValue(header, "shape");
+    const size_t shape_end = shape_value.find(')');
+    if (shape_value.empty() || shape_value.front() != '(' || shape_end == std::string_view::npos)
+    {
+        throw std::runtime_error("NPY header has an invalid shape.");
+    }
+    std::string shape_text(shape_value.substr(1, shape_end - 1));
+    std::replace(shape_text.begin(), shape_text.end(), ',', ' ');
+    std::istringstream dims(shape_text);
+    size_t dim;
+    while (dims >> dim)
+    {
+        m_shape.push_back(dim);
+    }
+    if (m_shape.empty() || m_shape.size() > 3)
+    {
+        throw std::runtime_error("Only NPY arrays of one to three dimensions are supported.");
+    }
+    m_shape.resize(3, 1);
+
+    const size_t num_values = m_shape[0] * m_shape[1] * m_shape[2];
+    if (m_dataOffset + num_values * sizeof(float) > file_size)
+    {
+        throw std::runtime_error("NPY file is smaller than its array.");
+    }
+}
+
+NpyReader::NpyReader(const std::string& file_path)
+    : m_file(file_path)
+{
+    parseHeader();
+}
+
+const std::vector<size_t>& NpyReader::getShape() const
+{
+    return m_shape;
+}
+
+bool NpyReader::isFortranOrder() const
+{
+    return m_fortranOrder;
+}
+
+const float* NpyReader::getData() const
+{
+    return reinterpret_cast<const float*>(m_file.getData() + m_dataOffset);
+}
+
+void NpyReader::readTensor(Eigen::Tensor<float, 3>& tensor, const unsigned int num_threads) const
+{
+    const int rows = static_cast<int>(m_shape[0]);
+    const int cols = static_cast<int>(m_shape[1]);
+    const int channels = static_cast<int>(m_shape[2]);
+    if (tensor.dimension(0) != rows || tensor.dimension(1) != cols || tensor.dimension(2) != channels)
+    {
+        throw std::runtime_error("Tensor dimensions do not match NPY array shape.");
+    }
+
+    const float* p_src = getData();
+    float* p_dst = tensor.data();
+    if (m_fortranOrder)
+    {
+        std::memcpy(p_dst, p_src, static_cast<size_t>(rows) * cols * channels * sizeof(float));
+        return;
+    }
+
+    // C order has channels varying fastest; tiles of rows keep both the reads and the channel plane writes cache-friendly
+    const size_t plane = static_cast<size_t>(rows) * cols;
+    listener_utils::parallelFor(0, rows, [&](const int begin, const int end)
+    {
+        for (int tile_begin = begin; tile_begin < end; tile_begin += transposeTile)
+        {
+            const int tile_end = std::min(tile_begin + transposeTile, end);
+            for (int j = 0; j < cols; ++j)
+            {
+                for (int k = 0; k < channels; ++k)
+                {
+                    float* p_out = p_dst + k * plane + listener_utils::planeIndex(0, j, rows);
+                    for (int i = tile_begin; i < tile_end; ++i)
+                    {
+                        p_out[i] = p_src[(static_cast<size_t>(i) * cols + j) * channels + k];
+                    }
+                }
+            }
+        }
+    }, num_threads, transposeTile);
+}
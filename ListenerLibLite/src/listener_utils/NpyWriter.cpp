@@ -0,0 +1,234 @@
+#include "listener_utils/NpyWriter.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+namespace
+{
+    constexpr size_t headerAlignment = 64;
+
+    /*!
+     * @brief Helper function to build a version 1.0 NPY header for a Fortran-ordered float32 tensor.
+     *
+     * @param tensor Tensor whose shape is described
+     * @return Header bytes, padded with spaces so that the array starts on a 64-byte boundary
+     */
+    std::string makeHeader(const Eigen::Tensor<float, 3>& tensor)
+    {
+        std::string dict = "{'descr': '<f4', 'fortran_order': True, 'shape': (" + std::to_string(tensor.dimension(0)) + ", " +
+                           std::to_string(tensor.dimension(1)) + ", " + std::to_string(tensor.dimension(2)) + "), }";
+        const size_t preamble_size = 10;
+        const size_t total_size = (preamble_size + dict.size() + 1 + headerAlignment - 1) / headerAlignment * headerAlignment;
+        dict.append(total_size - preamble_size - dict.size() - 1, ' ');
+        dict.push_back('\n');
+
+        std::string header("\x93NUMPY\x01\x00", 8);
+        header.push_back(static_cast<char>(dict.size() & 0xff));
+        header.push_back(static_cast<char>(dict.size() >> 8));
+        return header + dict;
+    }
+
+    /*!
+     * @brief Helper function to write a header and payload to an open file, retrying partial and interrupted writes.
+     *
+     * @param file_descriptor Descriptor of the file open for writing
+     * @param header Header bytes
+     * @param p_payload Pointer to payload bytes
+     * @param payload_size Number of payload bytes
+     * @return true if everything was written, false on error
+     */
+    bool writeAll(const int file_descriptor, const std::string& header, const char* p_payload, const size_t payload_size)
+    {
+#ifdef _WIN32
+        const char* p_parts[2] = {header.data(), p_payload};
+        size_t sizes[2] = {header.size(), payload_size};
+        for (int part = 0; part < 2; ++part)
+        {
+            while (sizes[part] > 0)
+            {
+                const int written = _write(file_descriptor, p_parts[part], static_cast<unsigned int>(std::min<size_t>(sizes[part], 1u << 30)));
+                if (written <= 0)
+                {
+                    return false;
+                }
+                p_parts[part] += written;
+                sizes[part] -= written;
+            }
+        }
+        return true;
+#else
+        iovec parts[2] = {{const_cast<char*>(header.data()), header.size()}, {const_cast<char*>(p_payload), payload_size}};
+        iovec* p_part = parts;
+        int num_parts = 2;
+        while (num_parts > 0)
+        {
+            const ssize_t written = writev(file_descriptor, p_part, num_parts);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            auto remaining = static_cast<size_t>(written);
+            while (num_parts > 0 && remaining >= p_part->iov_len)
+            {
+                remaining -= p_part->iov_len;
+                ++p_part;
+                --num_parts;
+            }
+            if (num_parts > 0)
+            {
+                p_part->iov_base = static_cast<char*>(p_part->iov_base) + remaining;
+                p_part->iov_len -= remaining;
+            }
+        }
+        return true;
+#endif
+    }
+
+    /*!
+     * @brief Helper function to flush the data of a file to its storage device on any platform, retrying if interrupted.
+     *
+     * @param file_descriptor Descriptor of the file open for writing
+     * @return true if the data was flushed, false on error
+     */
+    bool syncFile(const int file_descriptor)
+    {
+#ifdef _WIN32
+        return _commit(file_descriptor) == 0;
+#else
+        int result;
+        do
+        {
+#ifdef __APPLE__
+            result = fsync(file_descriptor);
+#else
+            result = fdatasync(file_descriptor);
+#endif
+        }
+        while (result != 0 && errno == EINTR);
+        return result == 0;
+#endif
+    }
+
+    /*!
+     * @brief Helper function to close a file descriptor on any platform.
+     *
+     * @param file_descriptor Descriptor to close
+     */
+    void closeFile(const int file_descriptor)
+    {
+#ifdef _WIN32
+        _close(file_descriptor);
+#else
+        close(file_descriptor);
+#endif
+    }
+}
+
+NpyWriter::NpyWriter(const NpySync sync)
+    : m_sync(sync)
+{
+}
+
+NpyWriter::~NpyWriter()
+{
+    try
+    {
+        finish();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void NpyWriter::write(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor)
+{
+#ifdef _WIN32
+    const int file_descriptor = _open(file_path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    const int file_descriptor = open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    if (file_descriptor < 0)
+    {
+        std::cerr << "Could not open file " << file_path << " for writing." << std::endl;
+        throw std::runtime_error("Failed to open NPY file for writing.");
+    }
+
+    const std::string header = makeHeader(tensor);
+    if (!writeAll(file_descriptor, header, reinterpret_cast<const char*>(tensor.data()), tensor.size() * sizeof(float)))
+    {
+        closeFile(file_descriptor);
+        throw std::runtime_error("Failed to write NPY file " + file_path + ".");
+    }
+
+    if (m_sync == NpySync::NONE)
+    {
+        closeFile(file_descriptor);
+        return;
+    }
+#ifdef __linux__
+    // Writeback starts now so that it overlaps with the rest of the batch
+    sync_file_range(file_descriptor, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+    std::lock_guard lock(m_pendingMutex);
+    m_pendingFiles.push_back(file_descriptor);
+}
+
+void NpyWriter::finish()
+{
+    std::vector<int> pending_files;
+    {
+        std::lock_guard lock(m_pendingMutex);
+        pending_files.swap(m_pendingFiles);
+    }
+    bool failed = false;
+    for (const int file_descriptor : pending_files)
+    {
+        failed |= !syncFile(file_descriptor);
+#ifdef __linux__
+        if (m_sync == NpySync::DROP_CACHE)
+        {
+            posix_fadvise(file_descriptor, 0, 0, POSIX_FADV_DONTNEED);
+        }
+#endif
+        closeFile(file_descriptor);
+    }
+    if (failed)
+    {
+        throw std::runtime_error("Failed to sync written NPY files.");
+    }
+}
+
+void NpyWriter::save(const std::string& file_path, const Eigen::Tensor<float, 3>& tensor, const std::shared_ptr<NpyWriter>& p_batch)
+{
+    if (p_batch != nullptr)
+    {
+        p_batch->write(file_path, tensor);
+        return;
+    }
+    NpyWriter writer;
+    writer.write(file_path, tensor);
+}
@@ -0,0 +1,281 @@
+#include "listener_utils/PlyReader.h"
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "listener_utils/MappedFile.h"
+#include "listener_utils/parallel_utils.hpp"
+
+namespace
+{
+    constexpr int vertexChunk = 16384;
+
+    const std::unordered_map<std::string, PlyType> plyTypeMap = {
+        { "char", PlyType::INT8 }, { "int8", PlyType::INT8 },
+        { "uchar", PlyType::UINT8 }, { "uint8", PlyType::UINT8 },
+        { "short", PlyType::INT16 }, { "int16", PlyType::INT16 },
+        { "ushort", PlyType::UINT16 }, { "uint16", PlyType::UINT16 },
+        { "int", PlyType::INT32 }, { "int32", PlyType::INT32 },
+        { "uint", PlyType::UINT32 }, { "uint32", PlyType::UINT32 },
+        { "float", PlyType::FLOAT32 }, { "float32", PlyType::FLOAT32 },
+        { "double", PlyType::FLOAT64 }, { "float64", PlyType::FLOAT64 }
+    };
+
+    size_t plyTypeSize(const PlyType type)
+    {
+        switch (type)
+        {
+        case PlyType::INT8:
+        case PlyType::UINT8:
+            return 1;
+        case PlyType::INT16:
+        case PlyType::UINT16:
+            return 2;
+        case PlyType::INT32:
+        case PlyType::UINT32:
+        case PlyType::FLOAT32:
+            return 4;
+        case PlyType::FLOAT64:
+            return 8;
+        }
+        return 0;
+    }
+
+    bool isHostBigEndian()
+    {
+        const uint16_t probe = 1;
+        unsigned char first_byte;
+        std::memcpy(&first_byte, &probe, 1);
+        return first_byte == 0;
+    }
+
+    /*!
+     * @brief Converts one property of a range of vertex records, reversing byte order if the file and host differ.
+     */
+    template <typename In, typename Out>
+    void convertProperty(const unsigned char* p_records, const size_t record_stride, const size_t begin, const size_t end, const bool swap_bytes, Out* p_out, const size_t out_stride)
+    {
+        unsigned char bytes[sizeof(In)];
+        In value;
+        for (size_t n = begin; n < end; ++n)
+        {
+            const unsigned char* p_value = p_records + n * record_stride;
+            if (swap_bytes)
+            {
+                std::reverse_copy(p_value, p_value + sizeof(In), bytes);
+                std::memcpy(&value, bytes, sizeof(In));
+            }
+            else
+            {
+                std::memcpy(&value, p_value, sizeof(In));
+            }
+            p_out[n * out_stride] = static_cast<Out>(value);
+        }
+    }
+
+    template <typename Out>
+    void convertRange(const PlyType type, const unsigned char* p_records, const size_t record_stride, const size_t begin, const size_t end, const bool swap_bytes, Out* p_out, const size_t out_stride)
+    {
+        switch (type)
+        {
+        case PlyType::INT8:
+            convertProperty<int8_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::UINT8:
+            convertProperty<uint8_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::INT16:
+            convertProperty<int16_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::UINT16:
+            convertProperty<uint16_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::INT32:
+            convertProperty<int32_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::UINT32:
+            convertProperty<uint32_t>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::FLOAT32:
+            convertProperty<float>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        case PlyType::FLOAT64:
+            convertProperty<double>(p_records, record_stride, begin, end, swap_bytes, p_out, out_stride);
+            break;
+        }
+    }
+}
+
+void PlyReader::parseHeader()
+{
+    const auto* p_begin = reinterpret_cast<const char*>(m_file.getData());
+    const std::string_view contents(p_begin, m_file.getSize());
+    const size_t end_pos = contents.find("end_header");
+    if (contents.substr(0, 3) != "ply" || end_pos == std::string_view::npos)
+    {
+        throw std::runtime_error("File is not a valid PLY file.");
+    }
+    const size_t data_pos = contents.find('\n', end_pos);
+    if (data_pos == std::string_view::npos)
+    {
+        throw std::runtime_error("File is not a valid PLY file.");
+    }
+
+    // Elements preceding the vertices are skipped, so they must have fixed-size records
+    std::istringstream header(std::string(contents.substr(0, end_pos)));
+    std::string line;
+    std::string current_element;
+    size_t current_count = 0;
+    size_t current_stride = 0;
+    bool vertex_found = false;
+    size_t skipped_bytes = 0;
+    const auto close_element = [&]()
+    {
+        if (!vertex_found && !current_element.empty() && current_element != "vertex")
+        {
+            skipped_bytes += current_count * current_stride;
+        }
+    };
+    while (std::getline(header, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if (keyword == "format")
+        {
+            std::string format;
+            tokens >> format;
+            m_binary = format != "ascii";
+            m_bigEndian = format == "binary_big_endian";
+        }
+        else if (keyword == "element")
+        {
+            close_element();
+            tokens >> current_element >> current_count;
+            current_stride = 0;
+            if (current_element == "vertex")
+            {
+                vertex_found = true;
+                m_vertexCount = current_count;
+            }
+        }
+        else if (keyword == "property")
+        {
+            std::string type_name;
+            std::string name;
+            tokens >> type_name >> name;
+            if (type_name == "list")
+            {
+                if (m_binary && (current_element == "vertex" || !vertex_found))
+                {
+                    throw std::runtime_error("PLY list properties before or in vertex element are not supported.");
+                }
+                continue;
+            }
+            const auto type_it = plyTypeMap.find(type_name);
+            if (type_it == plyTypeMap.end())
+            {
+                std::cerr << "Unknown PLY property type " << type_name << "." << std::endl;
+                throw std::runtime_error("Invalid PLY header.");
+            }
+            if (current_element == "vertex")
+            {
+                m_properties.push_back({name, type_it->second, current_stride});
+            }
+            current_stride += plyTypeSize(type_it->second);
+            if (current_element == "vertex")
+            {
+                m_vertexStride = current_stride;
+            }
+        }
+    }
+    close_element();
+    if (!vertex_found)
+    {
+        throw std::runtime_error("PLY file has no vertex element.");
+    }
+
+    m_vertexDataOffset = data_pos + 1 + skipped_bytes;
+    if (m_binary && m_vertexDataOffset + m_vertexCount * m_vertexStride > m_file.getSize())
+    {
+        throw std::runtime_error("PLY file is shorter than its header describes.");
+    }
+}
+
+const PlyProperty& PlyReader::findProperty(const std::string& name) const
+{
+    const auto it = std::find_if(m_properties.begin(), m_properties.end(), [&](const PlyProperty& property) { return property.m_name == name; });
+    if (it == m_properties.end())
+    {
+        std::cerr << "PLY vertices have no property " << name << "." << std::endl;
+        throw std::runtime_error("PLY vertex property not found.");
+    }
+    return *it;
+}
+
+PlyReader::PlyReader(const std::string& file_path)
+    : m_file(file_path)
+{
+    parseHeader();
+}
+
+bool PlyReader::isBinary() const
+{
+    return m_binary;
+}
+
+size_t PlyReader::getVertexCount() const
+{
+    return m_vertexCount;
+}
+
+const std::vector<PlyProperty>& PlyReader::getProperties() const
+{
+    return m_properties;
+}
+
+bool PlyReader::hasProperty(const std::string& name) const
+{
+    return std::any_of(m_properties.begin(), m_properties.end(), [&](const PlyProperty& property) { return property.m_name == name; });
+}
+
+template <typename T>
+void PlyReader::readProperty(const std::string& name, T* p_out, const size_t stride, const unsigned int num_threads) const
+{
+    if (!m_binary)
+    {
+        throw std::runtime_error("ASCII PLY files are not supported by the native reader.");
+    }
+    const PlyProperty& property = findProperty(name);
+    const unsigned char* p_records = m_file.getData() + m_vertexDataOffset + property.m_offset;
+    const bool swap_bytes = m_bigEndian != isHostBigEndian() && plyTypeSize(property.m_type) > 1;
+    listener_utils::parallelFor(0, static_cast<int>(m_vertexCount), [&](const int begin, const int end)
+    {
+        convertRange(property.m_type, p_records, m_vertexStride, begin, end, swap_bytes, p_out, stride);
+    }, num_threads, vertexChunk);
+}
+
+template <typename T>
+void PlyReader::readPoints(T* p_xyz, const unsigned int num_threads) const
+{
+    readProperty("x", p_xyz, 3, num_threads);
+    readProperty("y", p_xyz + 1, 3, num_threads);
+    readProperty("z", p_xyz + 2, 3, num_threads);
+}
+
+template void PlyReader::readProperty<float>(const std::string&, float*, size_t, unsigned int) const;
+template void PlyReader::readProperty<double>(const std::string&, double*, size_t, unsigned int) const;
+template void PlyReader::readPoints<float>(float*, unsigned int) const;
+template void PlyReader::readPoints<double>(double*, unsigned int) const;
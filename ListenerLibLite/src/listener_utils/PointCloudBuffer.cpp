@@ -0,0 +1,391 @@
+#include "listener_utils/PointCloudBuffer.h"
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+#include <Eigen/Dense>
+#include <open3d/Open3D.h>
+
+#include "listener_utils/parallel_utils.hpp"
+#include "listener_utils/tensor_utils.hpp"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/RGBFrame.h"
+#include "listener_frames/GrayFrame.h"
+
+PointCloudBuffer::PointCloudBuffer(const PointLayout layout, const bool has_color, const bool has_intensity, const bool has_pixel_index, const bool has_source_tag)
+	: m_layout(layout), m_hasColor(has_color), m_hasIntensity(has_intensity), m_hasPixelIndex(has_pixel_index), m_hasSourceTag(has_source_tag)
+{
+}
+
+const PointLayout& PointCloudBuffer::getLayout() const
+{
+	return m_layout;
+}
+
+size_t PointCloudBuffer::getSize() const
+{
+	return m_size;
+}
+
+bool PointCloudBuffer::hasColor() const
+{
+	return m_hasColor;
+}
+
+bool PointCloudBuffer::hasIntensity() const
+{
+	return m_hasIntensity;
+}
+
+bool PointCloudBuffer::hasPixelIndex() const
+{
+	return m_hasPixelIndex;
+}
+
+bool PointCloudBuffer::hasSourceTag() const
+{
+	return m_hasSourceTag;
+}
+
+void PointCloudBuffer::reserve(const size_t capacity)
+{
+	if (m_layout == PointLayout::SOA)
+	{
+		m_x.reserve(capacity);
+		m_y.reserve(capacity);
+		m_z.reserve(capacity);
+	}
+	else
+	{
+		m_xyzw.reserve(capacity * aosStride);
+	}
+	if (m_hasColor)
+	{
+		m_colors.reserve(capacity * 3);
+	}
+	if (m_hasIntensity)
+	{
+		m_intensities.reserve(capacity);
+	}
+	if (m_hasPixelIndex)
+	{
+		m_pixelIndices.reserve(capacity);
+	}
+	if (m_hasSourceTag)
+	{
+		m_sourceTags.reserve(capacity);
+	}
+}
+
+void PointCloudBuffer::resize(const size_t size)
+{
+	if (m_layout == PointLayout::SOA)
+	{
+		m_x.resize(size);
+		m_y.resize(size);
+		m_z.resize(size);
+	}
+	else
+	{
+		m_xyzw.resize(size * aosStride);
+	}
+	if (m_hasColor)
+	{
+		m_colors.resize(size * 3);
+	}
+	if (m_hasIntensity)
+	{
+		m_intensities.resize(size);
+	}
+	if (m_hasPixelIndex)
+	{
+		m_pixelIndices.resize(size);
+	}
+	if (m_hasSourceTag)
+	{
+		m_sourceTags.resize(size);
+	}
+	m_size = size;
+}
+
+void PointCloudBuffer::clear()
+{
+	resize(0);
+}
+
+void PointCloudBuffer::setPoint(const size_t index, const Eigen::Vector3f& point)
+{
+	if (m_layout == PointLayout::SOA)
+	{
+		m_x[index] = point(0);
+		m_y[index] = point(1);
+		m_z[index] = point(2);
+	}
+	else
+	{
+		float* p_point = m_xyzw.data() + index * aosStride;
+		p_point[0] = point(0);
+		p_point[1] = point(1);
+		p_point[2] = point(2);
+		p_point[3] = 1.0f;
+	}
+}
+
+Eigen::Vector3f PointCloudBuffer::getPoint(const size_t index) const
+{
+	if (m_layout == PointLayout::SOA)
+	{
+		return {m_x[index], m_y[index], m_z[index]};
+	}
+	const float* p_point = m_xyzw.data() + index * aosStride;
+	return {p_point[0], p_point[1], p_point[2]};
+}
+
+float* PointCloudBuffer::getXData()
+{
+	return m_layout == PointLayout::SOA ? m_x.data() : nullptr;
+}
+
+const float* PointCloudBuffer::getXData() const
+{
+	return m_layout == PointLayout::SOA ? m_x.data() : nullptr;
+}
+
+float* PointCloudBuffer::getYData()
+{
+	return m_layout == PointLayout::SOA ? m_y.data() : nullptr;
+}
+
+const float* PointCloudBuffer::getYData() const
+{
+	return m_layout == PointLayout::SOA ? m_y.data() : nullptr;
+}
+
+float* PointCloudBuffer::getZData()
+{
+	return m_layout == PointLayout::SOA ? m_z.data() : nullptr;
+}
+
+const float* PointCloudBuffer::getZData() const
+{
+	return m_layout == PointLayout::SOA ? m_z.data() : nullptr;
+}
+
+float* PointCloudBuffer::getXYZWData()
+{
+	return m_layout == PointLayout::AOS ? m_xyzw.data() : nullptr;
+}
+
+const float* PointCloudBuffer::getXYZWData() const
+{
+	return m_layout == PointLayout::AOS ? m_xyzw.data() : nullptr;
+}
+
+unsigned char* PointCloudBuffer::getColorData()
+{
+	return m_hasColor ? m_colors.data() : nullptr;
+}
+
+const unsigned char* PointCloudBuffer::getColorData() const
+{
+	return m_hasColor ? m_colors.data() : nullptr;
+}
+
+float* PointCloudBuffer::getIntensityData()
+{
+	return m_hasIntensity ? m_intensities.data() : nullptr;
+}
+
+const float* PointCloudBuffer::getIntensityData() const
+{
+	return m_hasIntensity ? m_intensities.data() : nullptr;
+}
+
+uint32_t* PointCloudBuffer::getPixelIndexData()
+{
+	return m_hasPixelIndex ? m_pixelIndices.data() : nullptr;
+}
+
+const uint32_t* PointCloudBuffer::getPixelIndexData() const
+{
+	return m_hasPixelIndex ? m_pixelIndices.data() : nullptr;
+}
+
+uint16_t* PointCloudBuffer::getSourceTagData()
+{
+	return m_hasSourceTag ? m_sourceTags.data() : nullptr;
+}
+
+const uint16_t* PointCloudBuffer::getSourceTagData() const
+{
+	return m_hasSourceTag ? m_sourceTags.data() : nullptr;
+}
+
+size_t PointCloudBuffer::countMasked(const MaskFrame& mask_frame)
+{
+	const bool* p_mask = mask_frame.getData().data();
+	const size_t plane = static_cast<size_t>(mask_frame.getRows()) * mask_frame.getCols();
+	size_t count = 0;
+	for (size_t pixel = 0; pixel < plane; ++pixel)
+	{
+		count += p_mask[pixel];
+	}
+	return count;
+}
+
+void PointCloudBuffer::fromGridFrame(const GridFrame& grid_frame, const MaskFrame& mask_frame, const std::shared_ptr<const RGBFrame> p_rgb_frame, const std::shared_ptr<const GrayFrame> p_gray_frame)
+{
+	resize(countMasked(mask_frame));
+	writeGridFrame(0, grid_frame, mask_frame, p_rgb_frame, p_gray_frame);
+}
+
+size_t PointCloudBuffer::writeGridFrame(const size_t offset, const GridFrame& grid_frame, const MaskFrame& mask_frame, const std::shared_ptr<const RGBFrame> p_rgb_frame, const std::shared_ptr<const GrayFrame> p_gray_frame, const unsigned int num_threads)
+{
+	const int rows = grid_frame.getRows();
+	const int cols = grid_frame.getCols();
+	if (mask_frame.getRows() != rows || mask_frame.getCols() != cols)
+	{
+		throw std::runtime_error("Point cloud mask resolution does not match point cloud grid resolution.");
+	}
+	if ((p_rgb_frame != nullptr && (p_rgb_frame->getRows() != rows || p_rgb_frame->getCols() != cols)) ||
+		(p_gray_frame != nullptr && (p_gray_frame->getRows() != rows || p_gray_frame->getCols() != cols)))
+	{
+		throw std::runtime_error("Point cloud channel frame resolution does not match point cloud grid resolution.");
+	}
+
+	const size_t plane = static_cast<size_t>(rows) * cols;
+	const float* p_grid = grid_frame.getData().data();
+	const bool* p_mask = mask_frame.getData().data();
+	const unsigned char* p_rgb = p_rgb_frame != nullptr ? p_rgb_frame->getData().data() : nullptr;
+	const unsigned char* p_gray = p_gray_frame != nullptr ? p_gray_frame->getData().data() : nullptr;
+
+	// Count masked points per row so that rows can be written independently in parallel
+	std::vector<size_t> row_offsets(rows + 1, 0);
+	row_offsets[0] = offset;
+	listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+	{
+		for (int i = row_begin; i < row_end; ++i)
+		{
+			size_t count = 0;
+			for (int j = 0; j < cols; ++j)
+			{
+				count += p_mask[listener_utils::planeIndex(i, j, rows)];
+			}
+			row_offsets[i + 1] = count;
+		}
+	}, num_threads);
+	for (int i = 0; i < rows; ++i)
+	{
+		row_offsets[i + 1] += row_offsets[i];
+	}
+	if (row_offsets[rows] > m_size)
+	{
+		throw std::runtime_error("Point cloud buffer is too small to write point cloud grid.");
+	}
+
+	listener_utils::parallelFor(0, rows, [&](const int row_begin, const int row_end)
+	{
+		for (int i = row_begin; i < row_end; ++i)
+		{
+			size_t m = row_offsets[i];
+			for (int j = 0; j < cols; ++j)
+			{
+				const size_t pixel = listener_utils::planeIndex(i, j, rows);
+				if (!p_mask[pixel])
+				{
+					continue;
+				}
+				if (m_layout == PointLayout::SOA)
+				{
+					m_x[m] = p_grid[pixel];
+					m_y[m] = p_grid[pixel + plane];
+					m_z[m] = p_grid[pixel + 2 * plane];
+				}
+				else
+				{
+					float* p_point = m_xyzw.data() + m * aosStride;
+					p_point[0] = p_grid[pixel];
+					p_point[1] = p_grid[pixel + plane];
+					p_point[2] = p_grid[pixel + 2 * plane];
+					p_point[3] = 1.0f;
+				}
+				if (m_hasColor)
+				{
+					for (int k = 0; k < 3; ++k)
+					{
+						m_colors[3 * m + k] = p_rgb != nullptr ? p_rgb[pixel + k * plane] : 0;
+					}
+				}
+				if (m_hasIntensity)
+				{
+					m_intensities[m] = p_gray != nullptr ? p_gray[pixel] / 255.0f : 0.0f;
+				}
+				if (m_hasPixelIndex)
+				{
+					m_pixelIndices[m] = static_cast<uint32_t>(i) * cols + j;
+				}
+				++m;
+			}
+		}
+	}, num_threads);
+	return row_offsets[rows] - offset;
+}
+
+void PointCloudBuffer::transform(const Eigen::Matrix4f& transform, const size_t begin, const size_t end)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+	const auto length = static_cast<Eigen::Index>(end - begin);
+	if (m_layout == PointLayout::SOA)
+	{
+		Eigen::Map<Eigen::ArrayXf> x(m_x.data() + begin, length);
+		Eigen::Map<Eigen::ArrayXf> y(m_y.data() + begin, length);
+		Eigen::Map<Eigen::ArrayXf> z(m_z.data() + begin, length);
+		const Eigen::ArrayXf new_x = transform(0, 0) * x + transform(0, 1) * y + transform(0, 2) * z + transform(0, 3);
+		const Eigen::ArrayXf new_y = transform(1, 0) * x + transform(1, 1) * y + transform(1, 2) * z + transform(1, 3);
+		z = transform(2, 0) * x + transform(2, 1) * y + transform(2, 2) * z + transform(2, 3);
+		x = new_x;
+		y = new_y;
+	}
+	else
+	{
+		// Points are padded with w = 1, so the whole range is a single 4xN matrix product
+		Eigen::Map<Eigen::Matrix<float, 4, Eigen::Dynamic>> points(m_xyzw.data() + begin * aosStride, 4, length);
+		points = transform * points;
+	}
+}
+
+void PointCloudBuffer::setSourceTag(const uint16_t tag, const size_t begin, const size_t end)
+{
+	if (m_hasSourceTag && end > begin)
+	{
+		std::fill(m_sourceTags.begin() + begin, m_sourceTags.begin() + end, tag);
+	}
+}
+
+void PointCloudBuffer::toOpen3D(open3d::geometry::PointCloud& pcd) const
+{
+	pcd.Clear();
+	pcd.points_.resize(m_size);
+	for (size_t m = 0; m < m_size; ++m)
+	{
+		pcd.points_[m] = getPoint(m).cast<double>();
+	}
+	if (m_hasColor)
+	{
+		pcd.colors_.resize(m_size);
+		for (size_t m = 0; m < m_size; ++m)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				pcd.colors_[m](k) = m_colors[3 * m + k] / 255.0;
+			}
+		}
+	}
+}
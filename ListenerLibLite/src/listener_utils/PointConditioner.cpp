@@ -0,0 +1,134 @@
+#include "listener_utils/PointConditioner.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+namespace
+{
+    constexpr uint32_t emptySlot = 0xffffffffu;
+
+    uint64_t mixKey(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    /*!
+     * @brief Maps a coordinate to the integer identifying its duplicate cell, or to its exact bits if not quantized.
+     */
+    template <typename T>
+    int64_t cellOf(const T value, const T inv_resolution)
+    {
+        if (inv_resolution > 0)
+        {
+            return static_cast<int64_t>(std::floor(value * inv_resolution));
+        }
+        const auto exact = static_cast<double>(value) == 0.0 ? 0.0 : static_cast<double>(value);
+        int64_t bits;
+        std::memcpy(&bits, &exact, sizeof(double));
+        return bits;
+    }
+}
+
+PointConditioner::PointConditioner(const ConditionerParameters& params)
+    : m_params(params)
+{
+}
+
+const ConditionerParameters& PointConditioner::getParams() const
+{
+    return m_params;
+}
+
+template <typename T>
+size_t PointConditioner::apply(T* p_xyz, const size_t num_points, uint32_t* p_source_indices) const
+{
+    const size_t decimation = static_cast<size_t>(std::max(1, m_params.m_decimation));
+    const int axis_x = m_params.m_axisOrder[0];
+    const int axis_y = m_params.m_axisOrder[1];
+    const int axis_z = m_params.m_axisOrder[2];
+    const T signs[3] = {static_cast<T>(m_params.m_axisSigns[0]), static_cast<T>(m_params.m_axisSigns[1]), static_cast<T>(m_params.m_axisSigns[2])};
+    const T box_min[3] = {static_cast<T>(m_params.m_boxMin[0]), static_cast<T>(m_params.m_boxMin[1]), static_cast<T>(m_params.m_boxMin[2])};
+    const T box_max[3] = {static_cast<T>(m_params.m_boxMax[0]), static_cast<T>(m_params.m_boxMax[1]), static_cast<T>(m_params.m_boxMax[2])};
+    const T min_range_sq = static_cast<T>(m_params.m_minRange) * static_cast<T>(m_params.m_minRange);
+    const T max_range_sq = m_params.m_maxRange > 0.0f ? static_cast<T>(m_params.m_maxRange) * static_cast<T>(m_params.m_maxRange) : std::numeric_limits<T>::infinity();
+    const T inv_resolution = m_params.m_duplicateResolution > 0.0f ? static_cast<T>(1.0 / m_params.m_duplicateResolution) : static_cast<T>(0);
+
+    // Open addressing table of kept point indices, sized to a power of two at most half full
+    std::vector<uint32_t> table;
+    size_t table_mask = 0;
+    if (m_params.m_removeDuplicates)
+    {
+        size_t table_size = 16;
+        while (table_size < 2 * (num_points / decimation + 1))
+        {
+            table_size *= 2;
+        }
+        table.assign(table_size, emptySlot);
+        table_mask = table_size - 1;
+    }
+
+    size_t kept = 0;
+    for (size_t n = 0; n < num_points; n += decimation)
+    {
+        const T* p_in = p_xyz + 3 * n;
+        const T point[3] = {signs[0] * p_in[axis_x], signs[1] * p_in[axis_y], signs[2] * p_in[axis_z]};
+
+        // NaN coordinates fail the strict box comparisons and are dropped
+        bool inside = true;
+        for (int k = 0; k < 3; ++k)
+        {
+            inside &= point[k] > box_min[k] && point[k] < box_max[k];
+        }
+        const T range_sq = point[0] * point[0] + point[1] * point[1] + point[2] * point[2];
+        if (!inside || range_sq < min_range_sq || range_sq > max_range_sq)
+        {
+            continue;
+        }
+
+        if (m_params.m_removeDuplicates)
+        {
+            const int64_t cell[3] = {cellOf(point[0], inv_resolution), cellOf(point[1], inv_resolution), cellOf(point[2], inv_resolution)};
+            size_t slot = mixKey(static_cast<uint64_t>(cell[0]) ^ mixKey(static_cast<uint64_t>(cell[1]) ^ mixKey(static_cast<uint64_t>(cell[2])))) & table_mask;
+            bool duplicate = false;
+            while (table[slot] != emptySlot)
+            {
+                const T* p_kept = p_xyz + 3 * static_cast<size_t>(table[slot]);
+                if (cellOf(p_kept[0], inv_resolution) == cell[0] && cellOf(p_kept[1], inv_resolution) == cell[1] && cellOf(p_kept[2], inv_resolution) == cell[2])
+                {
+                    duplicate = true;
+                    break;
+                }
+                slot = (slot + 1) & table_mask;
+            }
+            if (duplicate)
+            {
+                continue;
+            }
+            table[slot] = static_cast<uint32_t>(kept);
+        }
+
+        // Kept points never overtake the read position, so compaction can happen in place
+        T* p_out = p_xyz + 3 * kept;
+        p_out[0] = point[0];
+        p_out[1] = point[1];
+        p_out[2] = point[2];
+        if (p_source_indices != nullptr)
+        {
+            p_source_indices[kept] = static_cast<uint32_t>(n);
+        }
+        ++kept;
+    }
+    return kept;
+}
+
+template size_t PointConditioner::apply<float>(float*, size_t, uint32_t*) const;
+template size_t PointConditioner::apply<double>(double*, size_t, uint32_t*) const;
@@ -0,0 +1,267 @@
+#include "listener_utils/RecordingReader.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <filesystem>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/RecordingFormat.hpp"
+#include "listener_utils/RecordingWriter.h"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/GrayFrame.h"
+#include "listener_frames/RGBFrame.h"
+#include "listener_frames/TempFrame.h"
+#include "listener_frames/MaskFrame.h"
+#include "listener_frames/NormalFrame.h"
+
+using namespace recording_format;
+
+namespace
+{
+    /*!
+     * @brief Helper function to copy a chunk's payload into a new data frame of a concrete type.
+     *
+     * @tparam FrameType GenericDataFrame subclass to create
+     * @tparam T Primitive data type of the subclass's internal data tensor
+     * @param header Header of the chunk
+     * @param p_payload Pointer to the chunk's mapped tensor contents
+     * @param p_cam_params Pointer to container for intrinsic matrix and distortion coefficients given to the data frame
+     * @param p_extrinsic Pointer to the 4x4 extrinsic matrix given to the data frame
+     * @return Pointer to the new data frame
+     */
+    template <typename FrameType, typename T>
+    std::shared_ptr<GenericDataFrame> makeFrame(const ChunkHeader& header, const unsigned char* p_payload, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic)
+    {
+        if (header.m_scalarType != static_cast<uint8_t>(std::is_same_v<T, float> ? ScalarType::FLOAT32 : std::is_same_v<T, bool> ? ScalarType::BOOL : ScalarType::UINT8))
+        {
+            throw std::runtime_error("Recorded scalar type does not match frame type.");
+        }
+        auto p_tensor = std::make_shared<Eigen::Tensor<T, 3>>(header.m_rows, header.m_cols, header.m_channels);
+        std::memcpy(p_tensor->data(), p_payload, header.m_payloadSize);
+        return std::make_shared<FrameType>(p_tensor, p_cam_params, p_extrinsic);
+    }
+}
+
+void RecordingReader::readHeader()
+{
+    FileHeader header;
+    if (m_file.getSize() < sizeof(FileHeader))
+    {
+        throw std::runtime_error("File is too small to be a recording.");
+    }
+    std::memcpy(&header, m_file.getData(), sizeof(FileHeader));
+    if (std::memcmp(header.m_magic, fileMagic, sizeof(fileMagic)) != 0)
+    {
+        throw std::runtime_error("File is not a recording.");
+    }
+    if (header.m_version != formatVersion)
+    {
+        throw std::runtime_error("Unsupported recording version " + std::to_string(header.m_version) + ".");
+    }
+    if (header.m_dataOffset > m_file.getSize() || sizeof(FileHeader) + (9 + 16 + header.m_numDistortion) * sizeof(float) > header.m_dataOffset)
+    {
+        throw std::runtime_error("Recording header is corrupt.");
+    }
+
+    std::vector<float> params(9 + 16 + header.m_numDistortion);
+    std::memcpy(params.data(), m_file.getData() + sizeof(FileHeader), params.size() * sizeof(float));
+    m_camParamsPtr = std::make_shared<CamParameters>(
+        std::make_shared<Eigen::Matrix3f>(Eigen::Map<const Eigen::Matrix<float, 3, 3, Eigen::RowMajor>>(params.data())),
+        std::make_shared<std::vector<float>>(params.begin() + 25, params.end()));
+    m_extrinsicPtr = std::make_shared<Eigen::Matrix4f>(Eigen::Map<const Eigen::Matrix<float, 4, 4, Eigen::RowMajor>>(params.data() + 9));
+}
+
+void RecordingReader::readIndex(std::vector<IndexEntry>& entries) const
+{
+    const uint64_t file_size = m_file.getSize();
+    FileHeader header;
+    std::memcpy(&header, m_file.getData(), sizeof(FileHeader));
+    if (file_size < header.m_dataOffset + sizeof(Trailer))
+    {
+        return;
+    }
+    Trailer trailer;
+    std::memcpy(&trailer, m_file.getData() + file_size - sizeof(Trailer), sizeof(Trailer));
+    if (std::memcmp(trailer.m_magic, trailerMagic, sizeof(trailerMagic)) != 0 ||
+        trailer.m_indexOffset + trailer.m_numEntries * sizeof(IndexEntry) + sizeof(Trailer) != file_size)
+    {
+        return;
+    }
+    entries.resize(trailer.m_numEntries);
+    std::memcpy(entries.data(), m_file.getData() + trailer.m_indexOffset, entries.size() * sizeof(IndexEntry));
+}
+
+void RecordingReader::scanChunks(std::vector<IndexEntry>& entries) const
+{
+    const uint64_t file_size = m_file.getSize();
+    FileHeader header;
+    std::memcpy(&header, m_file.getData(), sizeof(FileHeader));
+
+    // Unclosed recordings are read up to the first incomplete chunk
+    uint64_t offset = header.m_dataOffset;
+    ChunkHeader chunk;
+    while (offset + alignUp(sizeof(ChunkHeader)) <= file_size)
+    {
+        std::memcpy(&chunk, m_file.getData() + offset, sizeof(ChunkHeader));
+        const uint64_t chunk_end = offset + alignUp(sizeof(ChunkHeader)) + chunk.m_payloadSize;
+        if (chunk.m_magic != chunkMagic || chunk_end > file_size)
+        {
+            break;
+        }
+        entries.push_back({chunk.m_frameNumber, chunk.m_frameID, chunk.m_scalarType, 0, chunk.m_timestamp, offset});
+        offset = alignUp(chunk_end);
+    }
+}
+
+RecordingReader::RecordingReader(const std::string& file_path)
+    : m_file(file_path)
+{
+    readHeader();
+
+    std::vector<IndexEntry> entries;
+    readIndex(entries);
+    m_indexed = !entries.empty();
+    if (!m_indexed)
+    {
+        scanChunks(entries);
+    }
+
+    // Chunks of a frame are grouped by frame number; a chunk appended later replaces an earlier one of the same FrameID
+    std::stable_sort(entries.begin(), entries.end(), [](const IndexEntry& a, const IndexEntry& b) { return a.m_frameNumber < b.m_frameNumber; });
+    bool present[numFrameIDs] = {};
+    for (const IndexEntry& entry : entries)
+    {
+        if (entry.m_frameID >= numFrameIDs)
+        {
+            continue;
+        }
+        if (m_frames.empty() || m_frames.back().m_frameNumber != entry.m_frameNumber)
+        {
+            FrameRecord record{entry.m_frameNumber, std::chrono::microseconds(entry.m_timestamp), {}};
+            record.m_chunkOffsets.fill(-1);
+            m_frames.push_back(record);
+        }
+        m_frames.back().m_chunkOffsets[entry.m_frameID] = static_cast<int64_t>(entry.m_chunkOffset);
+        present[entry.m_frameID] = true;
+    }
+    for (size_t i = 0; i < numFrameIDs; ++i)
+    {
+        if (present[i])
+        {
+            m_frameIDs.push_back(static_cast<FrameID>(i));
+        }
+    }
+}
+
+bool RecordingReader::isRecording(const std::string& file_path)
+{
+    const std::filesystem::path path(file_path);
+    return path.extension() == RecordingWriter::fileExtension && std::filesystem::is_regular_file(path);
+}
+
+std::shared_ptr<CamParameters> RecordingReader::getCamParams() const
+{
+    return std::make_shared<CamParameters>(std::make_shared<Eigen::Matrix3f>(*m_camParamsPtr->m_intrinsicPtr),
+                                           std::make_shared<std::vector<float>>(*m_camParamsPtr->m_distortionPtr));
+}
+
+std::shared_ptr<Eigen::Matrix4f> RecordingReader::getExtrinsic() const
+{
+    return std::make_shared<Eigen::Matrix4f>(*m_extrinsicPtr);
+}
+
+bool RecordingReader::isIndexed() const
+{
+    return m_indexed;
+}
+
+size_t RecordingReader::getNumFrames() const
+{
+    return m_frames.size();
+}
+
+const std::vector<FrameID>& RecordingReader::getFrameIDs() const
+{
+    return m_frameIDs;
+}
+
+unsigned int RecordingReader::getFrameNumber(const size_t index) const
+{
+    return m_frames.at(index).m_frameNumber;
+}
+
+std::chrono::microseconds RecordingReader::getTimestamp(const size_t index) const
+{
+    return m_frames.at(index).m_timestamp;
+}
+
+bool RecordingReader::has(const size_t index, const FrameID frame_id) const
+{
+    return m_frames.at(index).m_chunkOffsets[static_cast<size_t>(frame_id)] >= 0;
+}
+
+std::shared_ptr<GenericDataFrame> RecordingReader::readFrame(const size_t index, const FrameID frame_id, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic) const
+{
+    const int64_t chunk_offset = m_frames.at(index).m_chunkOffsets[static_cast<size_t>(frame_id)];
+    if (chunk_offset < 0)
+    {
+        throw std::runtime_error("Frame " + std::to_string(m_frames[index].m_frameNumber) + " has no recorded " + FrameIDUtils::toString(frame_id) + " data.");
+    }
+
+    // Chunk offsets from the footer index are not trusted, so the chunk must be valid and lie within the file
+    const uint64_t file_size = m_file.getSize();
+    const uint64_t payload_offset = static_cast<uint64_t>(chunk_offset) + alignUp(sizeof(ChunkHeader));
+    if (payload_offset > file_size)
+    {
+        throw std::runtime_error("Recorded chunk of frame " + std::to_string(m_frames[index].m_frameNumber) + " lies outside the recording.");
+    }
+    ChunkHeader header;
+    std::memcpy(&header, m_file.getData() + chunk_offset, sizeof(ChunkHeader));
+    if (header.m_magic != chunkMagic || header.m_frameID != static_cast<uint8_t>(frame_id))
+    {
+        throw std::runtime_error("Recorded chunk of frame " + std::to_string(m_frames[index].m_frameNumber) + " is corrupt.");
+    }
+    if (header.m_payloadSize > file_size - payload_offset)
+    {
+        throw std::runtime_error("Recorded chunk of frame " + std::to_string(m_frames[index].m_frameNumber) + " is truncated.");
+    }
+    if (header.m_rows < 0 || header.m_cols < 0 || header.m_channels < 0 ||
+        header.m_payloadSize != static_cast<uint64_t>(header.m_rows) * static_cast<uint64_t>(header.m_cols) * static_cast<uint64_t>(header.m_channels) * scalarSize(static_cast<ScalarType>(header.m_scalarType)))
+    {
+        throw std::runtime_error("Recorded chunk of frame " + std::to_string(m_frames[index].m_frameNumber) + " has a payload size that does not match its dimensions.");
+    }
+    const unsigned char* p_payload = m_file.getData() + chunk_offset + alignUp(sizeof(ChunkHeader));
+
+    std::shared_ptr<GenericDataFrame> p_data_frame;
+    switch (frame_id)
+    {
+    case FrameID::POINTCLOUD_GRID:
+        p_data_frame = makeFrame<GridFrame, float>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    case FrameID::GRAYSCALE_IMAGE:
+        p_data_frame = makeFrame<GrayFrame, unsigned char>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    case FrameID::RGB_IMAGE:
+        p_data_frame = makeFrame<RGBFrame, unsigned char>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    case FrameID::TEMPERATURE_GRID:
+        p_data_frame = makeFrame<TempFrame, float>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    case FrameID::POINTCLOUD_MASK:
+        p_data_frame = makeFrame<MaskFrame, bool>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    case FrameID::NORMAL_GRID:
+        p_data_frame = makeFrame<NormalFrame, float>(header, p_payload, p_cam_params, p_extrinsic);
+        break;
+    }
+    p_data_frame->setLoadedTimestamp(m_frames[index].m_timestamp);
+    return p_data_frame;
+}
@@ -0,0 +1,271 @@
+#include "listener_utils/RecordingWriter.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <filesystem>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/RecordingFormat.hpp"
+#include "listener_frames/CompositeFrame.h"
+#include "listener_frames/DataFrame.hpp"
+
+using namespace recording_format;
+
+namespace
+{
+    /*!
+     * @brief Helper function to find the scalar type and raw contents of a data frame's tensor.
+     *
+     * @param data_frame Data frame to inspect
+     * @param type Scalar type of the tensor, set by this function
+     * @return Pointer to the first value of the tensor
+     */
+    const void* getPayload(const GenericDataFrame& data_frame, ScalarType& type)
+    {
+        if (const auto* p_frame = dynamic_cast<const DataFrame<float>*>(&data_frame))
+        {
+            type = ScalarType::FLOAT32;
+            return p_frame->getData().data();
+        }
+        if (const auto* p_frame = dynamic_cast<const DataFrame<unsigned char>*>(&data_frame))
+        {
+            type = ScalarType::UINT8;
+            return p_frame->getData().data();
+        }
+        if (const auto* p_frame = dynamic_cast<const DataFrame<bool>*>(&data_frame))
+        {
+            type = ScalarType::BOOL;
+            return p_frame->getData().data();
+        }
+        throw std::runtime_error("Data frame type cannot be recorded.");
+    }
+
+    /*!
+     * @brief Helper function to lay out a stream's parameters as stored in the file header.
+     *
+     * @param cam_params Container for intrinsic matrix and distortion coefficients of the recorded sensor
+     * @param extrinsic 4x4 extrinsic matrix of the recorded sensor relative to its identity sensor
+     * @return Row-major intrinsic matrix, row-major extrinsic matrix, and distortion coefficients
+     */
+    std::vector<float> packStreamParams(const CamParameters& cam_params, const Eigen::Matrix4f& extrinsic)
+    {
+        // Stream parameters are stored row-major, independently of Eigen's storage order
+        const std::vector<float>& distortion = *cam_params.m_distortionPtr;
+        std::vector<float> params;
+        params.reserve(9 + 16 + distortion.size());
+        for (int i = 0; i < 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                params.push_back((*cam_params.m_intrinsicPtr)(i, j));
+            }
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                params.push_back(extrinsic(i, j));
+            }
+        }
+        params.insert(params.end(), distortion.begin(), distortion.end());
+        return params;
+    }
+
+    /*!
+     * @brief Helper function to recover the index of an existing recording so that frames can be appended to it.
+     *
+     * The footer index is used when the trailer is valid, otherwise chunks are scanned up to the first incomplete one.
+     *
+     * @param file_path Path to the recording file
+     * @param params Stream parameters of the appended frames, which must equal the recorded ones
+     * @param index Vector to fill with one entry per recorded chunk
+     * @return Offset at which the next chunk is written, where the file is truncated
+     */
+    uint64_t recoverIndex(const std::string& file_path, const std::vector<float>& params, std::vector<IndexEntry>& index)
+    {
+        std::ifstream file(file_path, std::ios::binary);
+        const uint64_t file_size = std::filesystem::file_size(file_path);
+
+        FileHeader header;
+        if (file_size < sizeof(FileHeader) || !file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) ||
+            std::memcmp(header.m_magic, fileMagic, sizeof(fileMagic)) != 0 || header.m_version != formatVersion)
+        {
+            throw std::runtime_error("Cannot append to " + file_path + ": not a recording of a supported version.");
+        }
+        std::vector<float> recorded_params(9 + 16 + header.m_numDistortion);
+        if (header.m_dataOffset < sizeof(FileHeader) + recorded_params.size() * sizeof(float) || header.m_dataOffset > file_size ||
+            !file.read(reinterpret_cast<char*>(recorded_params.data()), static_cast<std::streamsize>(recorded_params.size() * sizeof(float))))
+        {
+            throw std::runtime_error("Cannot append to " + file_path + ": recording header is corrupt.");
+        }
+        if (recorded_params != params)
+        {
+            throw std::runtime_error("Cannot append to " + file_path + ": camera parameters or extrinsic matrix differ from the recorded stream.");
+        }
+
+        Trailer trailer;
+        if (file_size >= header.m_dataOffset + sizeof(Trailer))
+        {
+            file.seekg(file_size - sizeof(Trailer));
+            file.read(reinterpret_cast<char*>(&trailer), sizeof(Trailer));
+            if (std::memcmp(trailer.m_magic, trailerMagic, sizeof(trailerMagic)) == 0 &&
+                trailer.m_indexOffset + trailer.m_numEntries * sizeof(IndexEntry) + sizeof(Trailer) == file_size)
+            {
+                index.resize(trailer.m_numEntries);
+                file.seekg(trailer.m_indexOffset);
+                file.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(IndexEntry));
+                return trailer.m_indexOffset;
+            }
+        }
+
+        uint64_t offset = header.m_dataOffset;
+        ChunkHeader chunk;
+        while (offset + alignUp(sizeof(ChunkHeader)) <= file_size)
+        {
+            file.seekg(offset);
+            file.read(reinterpret_cast<char*>(&chunk), sizeof(ChunkHeader));
+            const uint64_t chunk_end = offset + alignUp(sizeof(ChunkHeader)) + chunk.m_payloadSize;
+            if (chunk.m_magic != chunkMagic || chunk_end > file_size)
+            {
+                break;
+            }
+            index.push_back({chunk.m_frameNumber, chunk.m_frameID, chunk.m_scalarType, 0, chunk.m_timestamp, offset});
+            offset = alignUp(chunk_end);
+        }
+        return offset;
+    }
+}
+
+void RecordingWriter::writePadding(const uint64_t aligned_offset)
+{
+    static const char zeros[alignment] = {};
+    m_file.write(zeros, static_cast<std::streamsize>(aligned_offset - m_offset));
+    m_offset = aligned_offset;
+}
+
+RecordingWriter::RecordingWriter(const std::string& file_path, const std::shared_ptr<CamParameters> p_cam_params, const std::shared_ptr<Eigen::Matrix4f> p_extrinsic, const bool append)
+{
+    const std::vector<float> params = packStreamParams(*p_cam_params, *p_extrinsic);
+    if (append && std::filesystem::is_regular_file(file_path))
+    {
+        m_offset = recoverIndex(file_path, params, m_index);
+        std::filesystem::resize_file(file_path, m_offset);
+        m_file.open(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        m_file.seekp(static_cast<std::streamoff>(m_offset));
+        if (!m_file)
+        {
+            throw std::runtime_error("Failed to open recording " + file_path + " for appending.");
+        }
+        return;
+    }
+
+    m_file.open(file_path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to create recording " + file_path + ".");
+    }
+
+    FileHeader header{};
+    std::memcpy(header.m_magic, fileMagic, sizeof(fileMagic));
+    header.m_version = formatVersion;
+    header.m_numDistortion = static_cast<uint32_t>(params.size() - 9 - 16);
+    header.m_dataOffset = alignUp(sizeof(FileHeader) + params.size() * sizeof(float));
+
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+    m_file.write(reinterpret_cast<const char*>(params.data()), static_cast<std::streamsize>(params.size() * sizeof(float)));
+    m_offset = sizeof(FileHeader) + params.size() * sizeof(float);
+    writePadding(header.m_dataOffset);
+}
+
+RecordingWriter::~RecordingWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to close recording: " << e.what() << std::endl;
+    }
+}
+
+void RecordingWriter::append(const unsigned int frame_number, const std::chrono::microseconds& timestamp, const FrameID frame_id, const GenericDataFrame& data_frame)
+{
+    ScalarType type;
+    const void* p_payload = getPayload(data_frame, type);
+
+    ChunkHeader header{};
+    header.m_magic = chunkMagic;
+    header.m_frameID = static_cast<uint8_t>(frame_id);
+    header.m_scalarType = static_cast<uint8_t>(type);
+    header.m_frameNumber = frame_number;
+    header.m_rows = data_frame.getRows();
+    header.m_cols = data_frame.getCols();
+    header.m_channels = data_frame.getChannels();
+    header.m_timestamp = timestamp.count();
+    header.m_payloadSize = static_cast<uint64_t>(header.m_rows) * header.m_cols * header.m_channels * scalarSize(type);
+
+    std::lock_guard lock(m_mutex);
+    if (m_closed)
+    {
+        throw std::runtime_error("Cannot append to a closed recording.");
+    }
+    const uint64_t chunk_offset = m_offset;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(ChunkHeader));
+    m_offset += sizeof(ChunkHeader);
+    writePadding(chunk_offset + alignUp(sizeof(ChunkHeader)));
+    m_file.write(static_cast<const char*>(p_payload), static_cast<std::streamsize>(header.m_payloadSize));
+    m_offset += header.m_payloadSize;
+    writePadding(alignUp(m_offset));
+    if (!m_file)
+    {
+        throw std::runtime_error("Failed to write chunk of frame " + std::to_string(frame_number) + " to recording.");
+    }
+    m_index.push_back({frame_number, header.m_frameID, header.m_scalarType, 0, header.m_timestamp, chunk_offset});
+}
+
+void RecordingWriter::append(const unsigned int frame_number, const CompositeFrame& composite_frame)
+{
+    for (const FrameID frame_id : composite_frame.getFrameIDs())
+    {
+        append(frame_number, composite_frame.getTimestamp(), frame_id, *composite_frame.getFrame(frame_id));
+    }
+}
+
+size_t RecordingWriter::getNumChunks()
+{
+    std::lock_guard lock(m_mutex);
+    return m_index.size();
+}
+
+void RecordingWriter::close()
+{
+    std::lock_guard lock(m_mutex);
+    if (m_closed)
+    {
+        return;
+    }
+    m_closed = true;
+
+    Trailer trailer{};
+    trailer.m_numEntries = m_index.size();
+    trailer.m_indexOffset = m_offset;
+    std::memcpy(trailer.m_magic, trailerMagic, sizeof(trailerMagic));
+    m_file.write(reinterpret_cast<const char*>(m_index.data()), static_cast<std::streamsize>(m_index.size() * sizeof(IndexEntry)));
+    m_file.write(reinterpret_cast<const char*>(&trailer), sizeof(Trailer));
+    m_file.close();
+    if (m_file.fail())
+    {
+        throw std::runtime_error("Failed to write recording index.");
+    }
+}
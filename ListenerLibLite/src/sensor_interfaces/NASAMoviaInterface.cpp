@@ -3,8 +3,6 @@
 #include <string>
 #include <unordered_map>
 
-#include <Eigen/Dense>
-
 #include "listener_utils/general_utils.hpp"
 #include "sensor_interfaces/ScanningLidarInterface.h"
 
@@ -20,20 +18,10 @@ NASAMoviaInterface::NASAMoviaInterface(const int mode, const int framerate, cons
     : ScanningLidarInterface(SensorID::MOVIA, framerate, mode, apply_processing)
 {
     m_propertyMap = modeMap.at(mode);
-}
 
-void NASAMoviaInterface::pcdConditioner(open3d::geometry::PointCloud& pcd) const
-{
-    pcd.RemoveDuplicatedPoints();
-    const std::vector<Eigen::Vector3d> points = pcd.points_;
-    std::vector<Eigen::Vector3d> new_points;
-    for (Eigen::Vector3d point : points)
-    {
-        Eigen::Vector3d new_point = {point[1], point[2], point[0]};
-        if (0.2 < new_point[2] && new_point[2] < 84.0)
-        {
-            new_points.push_back(new_point);
-        }
-    }
-    pcd.points_ = new_points;
+    // Movia files store (z, x, y) coordinates, keep unique points with depth between 0.2 and 84 meters
+    m_conditionerParams.m_axisOrder = {1, 2, 0};
+    m_conditionerParams.m_boxMin[2] = 0.2f;
+    m_conditionerParams.m_boxMax[2] = 84.0f;
+    m_conditionerParams.m_removeDuplicates = true;
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 #include "sensor_interfaces/ScanningLidarInterface.h"
 
 #include <string>
+#include <vector>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <cstdint>
 #include <cmath>
+#include <stdexcept>
 
 #include <Eigen/Dense>
 
 #include "listener_utils/general_utils.hpp"
 #include "listener_utils/CamParameters.hpp"
+#include "listener_utils/PointConditioner.h"
+#include "listener_processing/ProjectionLut.h"
 
 const std::unordered_map<int, std::unordered_map<std::string, float>> ScanningLidarInterface::modeMap = {
     { 0, { {"filter_size", 1.0f} } },
@@ -29,6 +35,16 @@ int ScanningLidarInterface::getFilterSize() const
     return 0;
 }
 
+void ScanningLidarInterface::setHoleFiller(const std::shared_ptr<const DepthHoleFiller> p_hole_filler)
+{
+    m_holeFillerPtr = p_hole_filler;
+}
+
+std::shared_ptr<const DepthHoleFiller> ScanningLidarInterface::getHoleFiller() const
+{
+    return m_holeFillerPtr;
+}
+
 std::shared_ptr<CamParameters> ScanningLidarInterface::getDefaultCamParams() const
 {
     // Get camera parameters from property dictionary of preset values per mode
@@ -55,6 +71,72 @@ std::shared_ptr<CamParameters> ScanningLidarInterface::getDefaultCamParams() con
     return std::make_shared<CamParameters>(p_intrinsic, p_distortion);
 }
 
+const ConditionerParameters& ScanningLidarInterface::getConditionerParams() const
+{
+    return m_conditionerParams;
+}
+
+void ScanningLidarInterface::setConditionerParams(const ConditionerParameters& params)
+{
+    m_conditionerParams = params;
+    std::atomic_store(&m_projectionLutPtr, std::shared_ptr<ProjectionLut>());
+}
+
+void ScanningLidarInterface::conditionPoints(std::vector<float>& points) const
+{
+    const size_t num_kept = PointConditioner(m_conditionerParams).apply(points.data(), points.size() / 3);
+    points.resize(3 * num_kept);
+}
+
+void ScanningLidarInterface::conditionPoints(std::vector<float>& points, std::vector<uint32_t>& source_indices) const
+{
+    source_indices.resize(points.size() / 3);
+    const size_t num_kept = PointConditioner(m_conditionerParams).apply(points.data(), points.size() / 3, source_indices.data());
+    points.resize(3 * num_kept);
+    source_indices.resize(num_kept);
+}
+
+bool ScanningLidarInterface::getUseProjectionLut() const
+{
+    return m_useProjectionLut;
+}
+
+void ScanningLidarInterface::setUseProjectionLut(const bool use_projection_lut, const size_t num_beams, const std::string& beam_id_property)
+{
+    if (use_projection_lut && num_beams == 0)
+    {
+        throw std::runtime_error("Projection lookup table requires the number of beams reported by the sensor.");
+    }
+    m_useProjectionLut = use_projection_lut;
+    m_numBeams = num_beams;
+    m_beamIDProperty = beam_id_property;
+    std::atomic_store(&m_projectionLutPtr, std::shared_ptr<ProjectionLut>());
+}
+
+const std::string& ScanningLidarInterface::getBeamIDProperty() const
+{
+    return m_beamIDProperty;
+}
+
+std::shared_ptr<ProjectionLut> ScanningLidarInterface::getProjectionLut(const Eigen::Matrix3f& intrinsic, const int rows, const int cols) const
+{
+    if (!m_useProjectionLut)
+    {
+        return nullptr;
+    }
+
+    // Frames may be loaded from several threads, so the cached table is swapped atomically
+    std::shared_ptr<ProjectionLut> p_lut = std::atomic_load(&m_projectionLutPtr);
+    if (p_lut == nullptr || !p_lut->matches(intrinsic, rows, cols, m_numBeams))
+    {
+        p_lut = std::make_shared<ProjectionLut>(intrinsic, rows, cols, m_numBeams);
+        std::atomic_store(&m_projectionLutPtr, p_lut);
+    }
+    return p_lut;
+}
+
 void ScanningLidarInterface::pcdConditioner(open3d::geometry::PointCloud& pcd) const
 {
+    const size_t num_kept = PointConditioner(m_conditionerParams).apply(pcd.points_.empty() ? nullptr : pcd.points_.front().data(), pcd.points_.size());
+    pcd.points_.resize(num_kept);
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_frames/CompositeFrame.h"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/NormalFrame.h"
+#include "listener_processing/NormalEstimator.h"
+
+namespace
+{
+    // Organized point cloud of a plane facing the sensor at a depth of two metres
+    std::shared_ptr<GridFrame> makePlaneFrame(const int rows, const int cols)
+    {
+        const auto p_grid = std::make_shared<Eigen::Tensor<float, 3>>(rows, cols, 3);
+        for (int col = 0; col < cols; ++col)
+        {
+            for (int row = 0; row < rows; ++row)
+            {
+                (*p_grid)(row, col, 0) = 0.01f * (col - cols / 2);
+                (*p_grid)(row, col, 1) = 0.01f * (row - rows / 2);
+                (*p_grid)(row, col, 2) = 2.0f;
+            }
+        }
+        return std::make_shared<GridFrame>(p_grid, std::make_shared<CamParameters>(), std::make_shared<Eigen::Matrix4f>(Eigen::Matrix4f::Identity()));
+    }
+}
+
+TEST(CompositeFrame, EstimatesNormalsOnlyOnFirstAccess)
+{
+    CompositeFrame composite_frame(std::chrono::microseconds(1));
+    composite_frame.addFrame(FrameID::POINTCLOUD_GRID, makePlaneFrame(8, 12));
+    ASSERT_FALSE(composite_frame.has(FrameID::NORMAL_GRID));
+
+    const NormalEstimator estimator;
+    const std::shared_ptr<NormalFrame> p_normals = composite_frame.getOrEstimateNormals(estimator);
+    ASSERT_TRUE(composite_frame.has(FrameID::NORMAL_GRID));
+    EXPECT_EQ(composite_frame.getFrame(FrameID::NORMAL_GRID), p_normals);
+    EXPECT_EQ(composite_frame.getOrEstimateNormals(estimator), p_normals);
+
+    // The plane faces the sensor, so every normal points back along the optical axis
+    const Eigen::Tensor<float, 3>& normals = p_normals->getData();
+    for (int col = 0; col < 12; ++col)
+    {
+        for (int row = 0; row < 8; ++row)
+        {
+            EXPECT_NEAR(normals(row, col, 2), -1.0f, 1e-5f) << "pixel " << row << ", " << col;
+        }
+    }
+}
+
+TEST(CompositeFrame, KeepsNormalsAddedByAProcessingStage)
+{
+    CompositeFrame composite_frame(std::chrono::microseconds(1));
+    composite_frame.addFrame(FrameID::POINTCLOUD_GRID, makePlaneFrame(8, 12));
+    NormalEstimator stage;
+    stage.process(composite_frame);
+    const auto p_stored = composite_frame.getFrame(FrameID::NORMAL_GRID);
+
+    NormalEstimationParameters params;
+    params.m_method = NormalMethod::CENTRAL_DIFFERENCE;
+    EXPECT_EQ(composite_frame.getOrEstimateNormals(NormalEstimator(params)), p_stored);
+}
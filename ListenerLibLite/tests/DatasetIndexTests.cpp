@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <filesystem>
+#include <unordered_map>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/DatasetIndex.h"
+
+/*!
+ * @brief Fixture providing a temporary dataset directory with one directory per FrameID.
+ *
+ * The index only lists file names, so the data files are left empty.
+ */
+class DatasetIndexTest : public ::testing::Test
+{
+protected:
+
+    std::filesystem::path m_dir;
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "DatasetIndexTest";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(getFrameDir(FrameID::TEMPERATURE_GRID));
+        std::filesystem::create_directories(getFrameDir(FrameID::RGB_IMAGE));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    std::filesystem::path getFrameDir(const FrameID frame_id) const
+    {
+        return m_dir / FrameIDUtils::toString(frame_id);
+    }
+
+    void writeFile(const FrameID frame_id, const std::string& name) const
+    {
+        std::ofstream(getFrameDir(frame_id) / name).put('\0');
+    }
+
+    // Writes numbered files of both FrameIDs, leaving out one frame of the RGB images
+    void writeNumberedFrames(const int num_frames, const int missing_rgb_frame) const
+    {
+        for (int f = 0; f < num_frames; ++f)
+        {
+            writeFile(FrameID::TEMPERATURE_GRID, "frame_" + std::to_string(f) + ".npy");
+            if (f != missing_rgb_frame)
+            {
+                writeFile(FrameID::RGB_IMAGE, "frame_" + std::to_string(f) + ".png");
+            }
+        }
+    }
+
+    // Moves the modification time of a FrameID directory, since listing it again can happen within the clock resolution
+    void touchFrameDir(const FrameID frame_id) const
+    {
+        const std::filesystem::path frame_dir = getFrameDir(frame_id);
+        std::filesystem::last_write_time(frame_dir, std::filesystem::last_write_time(frame_dir) + std::chrono::hours(1));
+    }
+
+    std::string readIndexFile() const
+    {
+        std::ifstream file(m_dir / DatasetIndex::fileName, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    static std::chrono::microseconds getTimestamp(const int frame)
+    {
+        return std::chrono::microseconds(1700000000000000 + frame * 33333);
+    }
+};
+
+TEST_F(DatasetIndexTest, DropsFramesMissingFromANumberedFrameID)
+{
+    writeNumberedFrames(12, 10);
+    const DatasetIndex index = DatasetIndex::scan(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE});
+
+    // Frames are in natural order and the missing frame does not shift the frames after it
+    ASSERT_EQ(index.getNumFrames(), 11u);
+    for (size_t i = 0; i < index.getNumFrames(); ++i)
+    {
+        const unsigned int frame_number = i < 10 ? static_cast<unsigned int>(i) : 11u;
+        EXPECT_EQ(index.getFrameNumber(i), frame_number);
+        EXPECT_EQ(index.getPath(i, FrameID::TEMPERATURE_GRID), (getFrameDir(FrameID::TEMPERATURE_GRID) / ("frame_" + std::to_string(frame_number) + ".npy")).string());
+        EXPECT_EQ(index.getPath(i, FrameID::RGB_IMAGE), (getFrameDir(FrameID::RGB_IMAGE) / ("frame_" + std::to_string(frame_number) + ".png")).string());
+    }
+    EXPECT_FALSE(index.hasTimestamps());
+    EXPECT_THROW(index.getPath(0, FrameID::POINTCLOUD_GRID), std::runtime_error);
+}
+
+TEST_F(DatasetIndexTest, RejectsUnnumberedFrameIDsOfDifferentLengths)
+{
+    for (const std::string& name : {"first", "second", "third"})
+    {
+        writeFile(FrameID::TEMPERATURE_GRID, name + ".npy");
+        writeFile(FrameID::RGB_IMAGE, name + ".png");
+    }
+    const DatasetIndex index = DatasetIndex::scan(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE});
+    ASSERT_EQ(index.getNumFrames(), 3u);
+    for (size_t i = 0; i < index.getNumFrames(); ++i)
+    {
+        EXPECT_EQ(index.getFrameNumber(i), i);
+        EXPECT_EQ(std::filesystem::path(index.getPath(i, FrameID::TEMPERATURE_GRID)).stem(), std::filesystem::path(index.getPath(i, FrameID::RGB_IMAGE)).stem());
+    }
+
+    std::filesystem::remove(getFrameDir(FrameID::RGB_IMAGE) / "second.png");
+    EXPECT_THROW(DatasetIndex::scan(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE}), std::runtime_error);
+    EXPECT_THROW(DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE}), std::runtime_error);
+}
+
+TEST_F(DatasetIndexTest, RebuildsAStaleIndexKeepingTimestamps)
+{
+    writeNumberedFrames(3, -1);
+    DatasetIndex index = DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE});
+    std::unordered_map<unsigned int, std::chrono::microseconds> timestamps;
+    for (int f = 0; f < 3; ++f)
+    {
+        timestamps[f] = getTimestamp(f);
+    }
+    index.setTimestamps(timestamps);
+    index.save();
+    EXPECT_TRUE(index.isCurrent());
+
+    writeFile(FrameID::TEMPERATURE_GRID, "frame_3.npy");
+    writeFile(FrameID::RGB_IMAGE, "frame_3.png");
+    touchFrameDir(FrameID::RGB_IMAGE);
+    EXPECT_FALSE(index.isCurrent());
+
+    const DatasetIndex reopened = DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE});
+    EXPECT_TRUE(reopened.isCurrent());
+    ASSERT_EQ(reopened.getNumFrames(), 4u);
+    EXPECT_TRUE(reopened.hasTimestamps());
+    for (int f = 0; f < 3; ++f)
+    {
+        EXPECT_EQ(reopened.getTimestamp(f), getTimestamp(f));
+    }
+    EXPECT_EQ(reopened.getTimestamp(3), std::chrono::microseconds(0));
+}
+
+TEST_F(DatasetIndexTest, OpensSubsetsWithoutReplacingTheCachedIndex)
+{
+    writeNumberedFrames(4, 2);
+    const DatasetIndex full = DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE});
+    EXPECT_EQ(full.getNumFrames(), 3u);
+    const std::string cached = readIndexFile();
+    ASSERT_FALSE(cached.empty());
+
+    // Frame 2 is only missing from the RGB images, so the temperature grids alone keep it
+    const DatasetIndex subset = DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID});
+    ASSERT_EQ(subset.getFrameIDs(), std::vector<FrameID>{FrameID::TEMPERATURE_GRID});
+    EXPECT_EQ(subset.getNumFrames(), 4u);
+    EXPECT_EQ(readIndexFile(), cached);
+
+    // The cached index is reused for its own FrameIDs in either order, and replaced when opened with more of them
+    const DatasetIndex reordered = DatasetIndex::open(m_dir.string(), {FrameID::RGB_IMAGE, FrameID::TEMPERATURE_GRID});
+    EXPECT_EQ(reordered.getNumFrames(), 3u);
+    EXPECT_EQ(readIndexFile(), cached);
+
+    std::filesystem::create_directories(getFrameDir(FrameID::POINTCLOUD_GRID));
+    for (int f = 0; f < 4; ++f)
+    {
+        writeFile(FrameID::POINTCLOUD_GRID, "frame_" + std::to_string(f) + ".npy");
+    }
+    const DatasetIndex superset = DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE, FrameID::POINTCLOUD_GRID});
+    EXPECT_EQ(superset.getNumFrames(), 3u);
+    EXPECT_NE(readIndexFile(), cached);
+    EXPECT_EQ(DatasetIndex::open(m_dir.string(), {FrameID::TEMPERATURE_GRID, FrameID::RGB_IMAGE}).getNumFrames(), 3u);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include <opencv2/core.hpp>
+
+#include "listener_processing/DepthMedianFilter.h"
+
+namespace
+{
+    // Reference copy of the median filter GridFrame applied before DepthMedianFilter replaced it
+    float floorMedianFilter(std::vector<float>& window)
+    {
+        const auto max_it = std::max_element(window.begin(), window.end());
+        if (max_it != window.end() && *max_it > 0.0f)
+        {
+            std::sort(window.begin(), window.end());
+            const size_t length = window.size();
+            if (length % 2 == 1)
+            {
+                return window[std::floor(length / 2)];
+            }
+            return window[std::floor(length / 2) - 1];
+        }
+        return 0.0f;
+    }
+
+    cv::Mat applyCustomFilter(const cv::Mat& image, const int kernel_size)
+    {
+        cv::Mat new_image = image.clone();
+        const int rows = image.rows;
+        const int cols = image.cols;
+        const int half_kernel_size = std::floor((kernel_size + 1) / 2);
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                const int window_top = std::max(0, i - half_kernel_size);
+                const int window_lft = std::max(0, j - half_kernel_size);
+                const int window_btm = std::min(rows, i + half_kernel_size);
+                const int window_rgt = std::min(cols, j + half_kernel_size);
+                std::vector<float> window;
+                for (int n = window_top; n < window_btm; ++n)
+                {
+                    for (int m = window_lft; m < window_rgt; ++m)
+                    {
+                        float pixel = image.at<float>(n, m);
+                        if (pixel > 0)
+                        {
+                            window.push_back(pixel);
+                        }
+                    }
+                }
+                new_image.at<float>(i, j) = floorMedianFilter(window);
+            }
+        }
+        return new_image;
+    }
+
+    // Sparse depth image with the given fraction of valid depths, sized so that rows end in a partial batch of pixels
+    cv::Mat makeDepthImage(const int rows, const int cols, const float density, const unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> depth(0.5f, 30.0f);
+        std::bernoulli_distribution valid(density);
+        cv::Mat image(rows, cols, CV_32FC1);
+        for (int i = 0; i < rows; ++i)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                image.at<float>(i, j) = valid(rng) ? depth(rng) : 0.0f;
+            }
+        }
+        return image;
+    }
+
+    void expectBitwiseEqual(const cv::Mat& expected, const cv::Mat& actual)
+    {
+        ASSERT_EQ(expected.rows, actual.rows);
+        ASSERT_EQ(expected.cols, actual.cols);
+        ASSERT_EQ(actual.type(), CV_32FC1);
+        for (int i = 0; i < expected.rows; ++i)
+        {
+            for (int j = 0; j < expected.cols; ++j)
+            {
+                ASSERT_EQ(expected.at<float>(i, j), actual.at<float>(i, j)) << "pixel " << i << ", " << j;
+            }
+        }
+    }
+}
+
+TEST(DepthMedianFilter, MatchesTheFormerGridFrameFilter)
+{
+    unsigned int seed = 0;
+    for (const int kernel_size : {3, 5, 7})
+    {
+        for (const float density : {0.05f, 0.15f, 0.5f, 1.0f})
+        {
+            SCOPED_TRACE("k = " + std::to_string(kernel_size) + ", density " + std::to_string(density));
+            const cv::Mat depth_image = makeDepthImage(37, 53, density, ++seed);
+            cv::Mat filtered_image;
+            DepthMedianFilter(kernel_size).filter(depth_image, filtered_image);
+            expectBitwiseEqual(applyCustomFilter(depth_image, kernel_size), filtered_image);
+        }
+    }
+}
+
+TEST(DepthMedianFilter, UsesTheAsymmetricWindowAtTheBorders)
+{
+    // A single depth lies in the windows of pixels up to half a window after it, but only half a window minus one before
+    // it, and the windows are clamped at the image bounds instead of wrapping
+    for (const int kernel_size : {3, 5, 7})
+    {
+        SCOPED_TRACE("k = " + std::to_string(kernel_size));
+        const int half_window = (kernel_size + 1) / 2;
+        for (const auto& pixel : {std::make_pair(0, 0), std::make_pair(0, 10), std::make_pair(11, 19), std::make_pair(11, 0), std::make_pair(5, 9)})
+        {
+            cv::Mat depth_image(12, 20, CV_32FC1, cv::Scalar(0.0f));
+            depth_image.at<float>(pixel.first, pixel.second) = 4.0f;
+            cv::Mat filtered_image;
+            DepthMedianFilter(kernel_size).filter(depth_image, filtered_image);
+            expectBitwiseEqual(applyCustomFilter(depth_image, kernel_size), filtered_image);
+            for (int i = 0; i < depth_image.rows; ++i)
+            {
+                for (int j = 0; j < depth_image.cols; ++j)
+                {
+                    const bool covered = i - pixel.first >= -(half_window - 1) && i - pixel.first <= half_window && j - pixel.second >= -(half_window - 1) && j - pixel.second <= half_window;
+                    ASSERT_EQ(filtered_image.at<float>(i, j), covered ? 4.0f : 0.0f) << "pixel " << i << ", " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST(DepthMedianFilter, FiltersInPlaceAndAcrossThreadsLikeTheFormerFilter)
+{
+    const cv::Mat depth_image = makeDepthImage(64, 41, 0.3f, 7);
+    const cv::Mat expected = applyCustomFilter(depth_image, 5);
+
+    cv::Mat single_thread_image;
+    DepthMedianFilter(5, 1).filter(depth_image, single_thread_image);
+    expectBitwiseEqual(expected, single_thread_image);
+
+    cv::Mat in_place_image = depth_image.clone();
+    DepthMedianFilter(5, 4).filter(in_place_image, in_place_image);
+    expectBitwiseEqual(expected, in_place_image);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/GridCodec.h"
+
+namespace
+{
+    // Depth-like grid: a smooth surface with noise and invalid zero points, so blocks get a spread of bit widths
+    Eigen::Tensor<float, 3> makeGrid(const int rows, const int cols, const int channels, const unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+        std::uniform_real_distribution<float> hole(0.0f, 1.0f);
+        Eigen::Tensor<float, 3> grid(rows, cols, channels);
+        for (int c = 0; c < channels; ++c)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                for (int row = 0; row < rows; ++row)
+                {
+                    grid(row, col, c) = hole(rng) < 0.1f ? 0.0f : 2.0f + 0.01f * row - 0.005f * col + c + noise(rng);
+                }
+            }
+        }
+        return grid;
+    }
+
+    void expectBitwiseEqual(const Eigen::Tensor<float, 3>& expected, const Eigen::Tensor<float, 3>& actual)
+    {
+        ASSERT_EQ(expected.dimensions(), actual.dimensions());
+        for (Eigen::Index i = 0; i < expected.size(); ++i)
+        {
+            uint32_t expected_bits;
+            uint32_t actual_bits;
+            std::memcpy(&expected_bits, expected.data() + i, sizeof(float));
+            std::memcpy(&actual_bits, actual.data() + i, sizeof(float));
+            ASSERT_EQ(expected_bits, actual_bits) << "at value " << i;
+        }
+    }
+}
+
+TEST(GridCodec, RoundTripsRandomGridsExactly)
+{
+    const Eigen::Tensor<float, 3> grid = makeGrid(48, 64, 3, 1);
+    const std::vector<uint8_t> data = grid_codec::encode(grid);
+    EXPECT_LT(data.size(), grid.size() * sizeof(float));
+    expectBitwiseEqual(grid, *grid_codec::decode(data.data(), data.size()));
+}
+
+TEST(GridCodec, RoundTripsUniformRandomBits)
+{
+    // Uncorrelated values need the full 32-bit width in every block
+    std::mt19937 rng(2);
+    Eigen::Tensor<float, 3> grid(37, 29, 1);
+    for (Eigen::Index i = 0; i < grid.size(); ++i)
+    {
+        const uint32_t bits = rng();
+        std::memcpy(grid.data() + i, &bits, sizeof(float));
+    }
+    const std::vector<uint8_t> data = grid_codec::encode(grid);
+    expectBitwiseEqual(grid, *grid_codec::decode(data.data(), data.size()));
+}
+
+TEST(GridCodec, RoundTripsSizesAcrossBlockAndSegmentBoundaries)
+{
+    // Blocks hold 32 values and segments 32768, sizes just around both exercise partial blocks and segments
+    const int sizes[] = {0, 1, 31, 32, 33, 32767, 32768, 32769, 3 * 32768 + 5};
+    for (const int size : sizes)
+    {
+        const Eigen::Tensor<float, 3> grid = makeGrid(size, 1, 1, static_cast<unsigned int>(size));
+        const std::vector<uint8_t> data = grid_codec::encode(grid);
+        expectBitwiseEqual(grid, *grid_codec::decode(data.data(), data.size()));
+        expectBitwiseEqual(grid, *grid_codec::decode(data.data(), data.size(), 1));
+    }
+}
+
+TEST(GridCodec, KeepsNonFiniteValuesWhenUnquantized)
+{
+    Eigen::Tensor<float, 3> grid = makeGrid(40, 40, 1, 3);
+    grid(0, 0, 0) = std::numeric_limits<float>::quiet_NaN();
+    grid(5, 7, 0) = -std::numeric_limits<float>::quiet_NaN();
+    grid(9, 2, 0) = std::numeric_limits<float>::infinity();
+    grid(9, 3, 0) = -std::numeric_limits<float>::infinity();
+    grid(10, 10, 0) = -0.0f;
+    grid(11, 11, 0) = std::numeric_limits<float>::denorm_min();
+    const std::vector<uint8_t> data = grid_codec::encode(grid);
+    expectBitwiseEqual(grid, *grid_codec::decode(data.data(), data.size()));
+}
+
+TEST(GridCodec, QuantizesToNearestStep)
+{
+    const float step = 0.001f;
+    Eigen::Tensor<float, 3> grid(33, 35, 1);
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> steps(0, 65535);
+    for (Eigen::Index i = 0; i < grid.size(); ++i)
+    {
+        grid.data()[i] = static_cast<float>(steps(rng)) * step;
+    }
+    grid(1, 1, 0) = 1.23449f;
+    const std::vector<uint8_t> data = grid_codec::encode(grid, step);
+    const auto p_decoded = grid_codec::decode(data.data(), data.size());
+    ASSERT_EQ(grid.dimensions(), p_decoded->dimensions());
+    for (Eigen::Index i = 0; i < grid.size(); ++i)
+    {
+        EXPECT_NEAR(grid.data()[i], p_decoded->data()[i], 0.5f * step + 1e-6f);
+    }
+    EXPECT_FLOAT_EQ((*p_decoded)(1, 1, 0), 1.234f);
+}
+
+TEST(GridCodec, QuantizedNonFiniteValuesDecodeAsInvalid)
+{
+    Eigen::Tensor<float, 3> grid(4, 4, 1);
+    grid.setConstant(1.0f);
+    grid(0, 0, 0) = std::numeric_limits<float>::quiet_NaN();
+    grid(1, 0, 0) = std::numeric_limits<float>::infinity();
+    grid(2, 0, 0) = 1e30f;
+    grid(3, 0, 0) = -1e30f;
+    const std::vector<uint8_t> data = grid_codec::encode(grid, 0.5f);
+    const auto p_decoded = grid_codec::decode(data.data(), data.size());
+    EXPECT_EQ((*p_decoded)(0, 0, 0), 0.0f);
+    EXPECT_EQ((*p_decoded)(1, 0, 0), 0.0f);
+    EXPECT_GT((*p_decoded)(2, 0, 0), 1e9f);
+    EXPECT_LT((*p_decoded)(3, 0, 0), -1e9f);
+    EXPECT_EQ((*p_decoded)(0, 1, 0), 1.0f);
+}
+
+TEST(GridCodec, RejectsNegativeQuantization)
+{
+    const Eigen::Tensor<float, 3> grid = makeGrid(4, 4, 1, 5);
+    EXPECT_THROW(grid_codec::encode(grid, -1.0f), std::runtime_error);
+}
+
+TEST(GridCodec, RejectsTruncatedInput)
+{
+    const Eigen::Tensor<float, 3> grid = makeGrid(200, 200, 1, 6);
+    const std::vector<uint8_t> data = grid_codec::encode(grid);
+    const size_t sizes[] = {0, 16, 32, 40, data.size() / 2, data.size() - 1};
+    for (const size_t size : sizes)
+    {
+        EXPECT_THROW(grid_codec::decode(data.data(), size), std::runtime_error) << "at size " << size;
+    }
+}
+
+TEST(GridCodec, RejectsCorruptInput)
+{
+    const Eigen::Tensor<float, 3> grid = makeGrid(64, 64, 1, 7);
+    const std::vector<uint8_t> data = grid_codec::encode(grid);
+
+    std::vector<uint8_t> bad_magic = data;
+    bad_magic[0] = 'X';
+    EXPECT_THROW(grid_codec::decode(bad_magic.data(), bad_magic.size()), std::runtime_error);
+
+    // The first block width follows the 32-byte header and one 8-byte segment offset
+    std::vector<uint8_t> bad_width = data;
+    bad_width[40] = 33;
+    EXPECT_THROW(grid_codec::decode(bad_width.data(), bad_width.size()), std::runtime_error);
+
+    std::vector<uint8_t> bad_rows = data;
+    const int32_t negative_rows = -1;
+    std::memcpy(bad_rows.data() + 8, &negative_rows, sizeof(negative_rows));
+    EXPECT_THROW(grid_codec::decode(bad_rows.data(), bad_rows.size()), std::runtime_error);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/ImageCodec.h"
+#include "listener_utils/EncodingParameters.hpp"
+
+namespace
+{
+    // Image with flat areas, gradients, and noise, so QOI uses runs, index hits, diffs, lumas, and full pixels
+    Eigen::Tensor<unsigned char, 3> makeImage(const int rows, const int cols, const int channels, const unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        Eigen::Tensor<unsigned char, 3> image(rows, cols, channels);
+        for (int c = 0; c < channels; ++c)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                for (int row = 0; row < rows; ++row)
+                {
+                    unsigned char value = 40;
+                    if (col >= cols / 4 && col < cols / 2)
+                    {
+                        value = static_cast<unsigned char>(row + col + 3 * c);
+                    }
+                    else if (col >= cols / 2)
+                    {
+                        value = static_cast<unsigned char>(rng());
+                    }
+                    image(row, col, c) = value;
+                }
+            }
+        }
+        return image;
+    }
+
+    void expectEqualImages(const Eigen::Tensor<unsigned char, 3>& expected, const Eigen::Tensor<unsigned char, 3>& actual)
+    {
+        ASSERT_EQ(expected.dimensions(), actual.dimensions());
+        EXPECT_EQ(std::memcmp(expected.data(), actual.data(), expected.size()), 0);
+    }
+}
+
+/*!
+ * @brief Fixture providing a temporary directory for saved images.
+ */
+class ImageCodecTest : public ::testing::Test
+{
+protected:
+
+    std::filesystem::path m_dir;
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "ImageCodecTest";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    std::shared_ptr<Eigen::Tensor<unsigned char, 3>> saveAndLoad(const Eigen::Tensor<unsigned char, 3>& image, const EncodingParameters& encoding_params, const std::string& extension, const bool binary = false) const
+    {
+        const std::string file_path = (m_dir / "image").string();
+        image_codec::save(file_path, image.data(), static_cast<int>(image.dimension(0)), static_cast<int>(image.dimension(1)), static_cast<int>(image.dimension(2)), encoding_params, binary);
+        return image_codec::load(file_path + extension, static_cast<int>(image.dimension(2)));
+    }
+};
+
+TEST(ImageCodec, EncodesEveryQoiOperation)
+{
+    // One row of pixels: two equal to the initial pixel (run), a diff, a luma, a full RGB pixel, and an index hit
+    const unsigned char pixels[6][3] = {{0, 0, 0}, {0, 0, 0}, {1, 1, 0}, {11, 10, 9}, {200, 50, 100}, {1, 1, 0}};
+    Eigen::Tensor<unsigned char, 3> image(1, 6, 3);
+    for (int col = 0; col < 6; ++col)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            image(0, col, c) = pixels[col][c];
+        }
+    }
+
+    const std::vector<uint8_t> data = image_codec::encodeQoi(image.data(), 1, 6, 3);
+    const std::vector<uint8_t> chunks(data.begin() + 14, data.end() - 8);
+    const std::vector<uint8_t> expected_chunks = {0xc1, 0x7e, 0xa9, 0x98, 0xfe, 200, 50, 100, 0x3d};
+    EXPECT_EQ(chunks, expected_chunks);
+    expectEqualImages(image, *image_codec::decodeQoi(data.data(), data.size(), 3));
+}
+
+TEST(ImageCodec, RoundTripsQoiRunsLongerThanOneChunk)
+{
+    Eigen::Tensor<unsigned char, 3> image(3, 100, 3);
+    image.setConstant(7);
+    image(1, 50, 2) = 8;
+    const std::vector<uint8_t> data = image_codec::encodeQoi(image.data(), 3, 100, 3);
+    EXPECT_LT(data.size(), 40u);
+    expectEqualImages(image, *image_codec::decodeQoi(data.data(), data.size(), 3));
+}
+
+TEST(ImageCodec, RoundTripsQoiColorAndGrayImages)
+{
+    for (const int channels : {1, 3})
+    {
+        const Eigen::Tensor<unsigned char, 3> image = makeImage(37, 53, channels, static_cast<unsigned int>(channels));
+        const std::vector<uint8_t> data = image_codec::encodeQoi(image.data(), 37, 53, channels);
+        expectEqualImages(image, *image_codec::decodeQoi(data.data(), data.size(), channels));
+    }
+
+    // Gray images are stored as gray RGB, and a color image decoded to one channel keeps its first channel
+    const Eigen::Tensor<unsigned char, 3> image = makeImage(16, 16, 3, 3);
+    const std::vector<uint8_t> data = image_codec::encodeQoi(image.data(), 16, 16, 3);
+    const Eigen::Tensor<unsigned char, 3> first_channel = image.slice(Eigen::array<Eigen::Index, 3>{0, 0, 0}, Eigen::array<Eigen::Index, 3>{16, 16, 1});
+    expectEqualImages(first_channel, *image_codec::decodeQoi(data.data(), data.size(), 1));
+}
+
+TEST(ImageCodec, RejectsTruncatedQoi)
+{
+    const Eigen::Tensor<unsigned char, 3> image = makeImage(64, 64, 3, 4);
+    const std::vector<uint8_t> data = image_codec::encodeQoi(image.data(), 64, 64, 3);
+    EXPECT_THROW(image_codec::decodeQoi(data.data(), 10, 3), std::runtime_error);
+    EXPECT_THROW(image_codec::decodeQoi(data.data(), 30, 3), std::runtime_error);
+
+    std::vector<uint8_t> bad_magic = data;
+    bad_magic[0] = 'x';
+    EXPECT_THROW(image_codec::decodeQoi(bad_magic.data(), bad_magic.size(), 3), std::runtime_error);
+}
+
+TEST_F(ImageCodecTest, RoundTripsQoiAndRawFiles)
+{
+    for (const ImageEncoding encoding : {ImageEncoding::QOI, ImageEncoding::RAW})
+    {
+        EncodingParameters encoding_params;
+        encoding_params.m_imageEncoding = encoding;
+        const std::string extension = encoding == ImageEncoding::QOI ? image_codec::qoiExtension : image_codec::rawExtension;
+        for (const int channels : {1, 3})
+        {
+            const Eigen::Tensor<unsigned char, 3> image = makeImage(24, 31, channels, static_cast<unsigned int>(channels) + 10);
+            expectEqualImages(image, *saveAndLoad(image, encoding_params, extension));
+        }
+    }
+}
+
+TEST_F(ImageCodecTest, ScalesBinaryImagesInQoiButNotRaw)
+{
+    Eigen::Tensor<unsigned char, 3> mask(8, 8, 1);
+    for (Eigen::Index i = 0; i < mask.size(); ++i)
+    {
+        mask.data()[i] = static_cast<unsigned char>(i % 3 == 0);
+    }
+    const Eigen::Tensor<unsigned char, 3> scaled = mask * static_cast<unsigned char>(255);
+
+    EncodingParameters encoding_params;
+    encoding_params.m_imageEncoding = ImageEncoding::QOI;
+    expectEqualImages(scaled, *saveAndLoad(mask, encoding_params, image_codec::qoiExtension, true));
+    encoding_params.m_imageEncoding = ImageEncoding::RAW;
+    expectEqualImages(mask, *saveAndLoad(mask, encoding_params, image_codec::rawExtension, true));
+}
+
+TEST_F(ImageCodecTest, RoundTripsPngAtEveryLevelAndStrategy)
+{
+    const PngStrategy strategies[] = {PngStrategy::DEFAULT, PngStrategy::FILTERED, PngStrategy::HUFFMAN_ONLY, PngStrategy::RLE, PngStrategy::FIXED};
+    for (const int channels : {1, 3})
+    {
+        const Eigen::Tensor<unsigned char, 3> image = makeImage(29, 41, channels, static_cast<unsigned int>(channels) + 20);
+        for (const int level : {-1, 0, 1, 6, 9})
+        {
+            for (const PngStrategy strategy : strategies)
+            {
+                EncodingParameters encoding_params;
+                encoding_params.m_pngCompression = level;
+                encoding_params.m_pngStrategy = strategy;
+                SCOPED_TRACE("channels " + std::to_string(channels) + ", level " + std::to_string(level) + ", strategy " + std::to_string(static_cast<int>(strategy)));
+                expectEqualImages(image, *saveAndLoad(image, encoding_params, ".png"));
+            }
+        }
+    }
+}
+
+TEST_F(ImageCodecTest, RejectsRawFilesWithTooFewChannels)
+{
+    const Eigen::Tensor<unsigned char, 3> image = makeImage(4, 4, 1, 30);
+    EncodingParameters encoding_params;
+    encoding_params.m_imageEncoding = ImageEncoding::RAW;
+    const std::string file_path = (m_dir / "image").string();
+    image_codec::save(file_path, image.data(), 4, 4, 1, encoding_params);
+    EXPECT_THROW(image_codec::load(file_path + image_codec::rawExtension, 3), std::runtime_error);
+    std::filesystem::resize_file(file_path + image_codec::rawExtension, 20);
+    EXPECT_THROW(image_codec::load(file_path + image_codec::rawExtension, 1), std::runtime_error);
+}
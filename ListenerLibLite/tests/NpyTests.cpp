@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/NpyReader.h"
+#include "listener_utils/NpyWriter.h"
+
+namespace
+{
+    // Distinct value for every element, so that any transposed or shifted copy is caught
+    float valueAt(const int row, const int col, const int channel)
+    {
+        return static_cast<float>(row) + 0.001f * static_cast<float>(col) + 1000.0f * static_cast<float>(channel);
+    }
+
+    Eigen::Tensor<float, 3> makeTensor(const int rows, const int cols, const int channels)
+    {
+        Eigen::Tensor<float, 3> tensor(rows, cols, channels);
+        for (int k = 0; k < channels; ++k)
+        {
+            for (int j = 0; j < cols; ++j)
+            {
+                for (int i = 0; i < rows; ++i)
+                {
+                    tensor(i, j, k) = valueAt(i, j, k);
+                }
+            }
+        }
+        return tensor;
+    }
+
+    // Writes a version 1.0 NPY file with the given header dictionary, padded to keep the array aligned
+    void writeNpy(const std::filesystem::path& file_path, std::string dict, const std::vector<float>& values)
+    {
+        const size_t total_size = (10 + dict.size() + 1 + 63) / 64 * 64;
+        dict.append(total_size - 10 - dict.size() - 1, ' ');
+        dict.push_back('\n');
+        std::ofstream file(file_path, std::ios::binary);
+        file.write("\x93NUMPY\x01\x00", 8);
+        file.put(static_cast<char>(dict.size() & 0xff));
+        file.put(static_cast<char>(dict.size() >> 8));
+        file.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+        file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(float)));
+    }
+
+    void expectEqualTensors(const Eigen::Tensor<float, 3>& expected, const Eigen::Tensor<float, 3>& actual)
+    {
+        ASSERT_EQ(expected.dimensions(), actual.dimensions());
+        for (Eigen::Index i = 0; i < expected.size(); ++i)
+        {
+            ASSERT_EQ(expected.data()[i], actual.data()[i]) << "at value " << i;
+        }
+    }
+
+    Eigen::Tensor<float, 3> readTensor(const NpyReader& reader, const unsigned int num_threads = 0)
+    {
+        const std::vector<size_t>& shape = reader.getShape();
+        Eigen::Tensor<float, 3> tensor(static_cast<Eigen::Index>(shape[0]), static_cast<Eigen::Index>(shape[1]), static_cast<Eigen::Index>(shape[2]));
+        reader.readTensor(tensor, num_threads);
+        return tensor;
+    }
+}
+
+/*!
+ * @brief Fixture providing a temporary directory for NPY files.
+ */
+class NpyTest : public ::testing::Test
+{
+protected:
+
+    std::filesystem::path m_dir;
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "NpyTest";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+};
+
+TEST_F(NpyTest, RoundTripsNonSquareTensors)
+{
+    const int shapes[][3] = {{5, 7, 3}, {13, 2, 1}, {1, 9, 2}, {70, 33, 3}};
+    for (const auto& shape : shapes)
+    {
+        const Eigen::Tensor<float, 3> tensor = makeTensor(shape[0], shape[1], shape[2]);
+        const std::string file_path = (m_dir / "tensor.npy").string();
+        NpyWriter::save(file_path, tensor);
+
+        const NpyReader reader(file_path);
+        EXPECT_TRUE(reader.isFortranOrder());
+        EXPECT_EQ(reader.getShape(), (std::vector<size_t>{static_cast<size_t>(shape[0]), static_cast<size_t>(shape[1]), static_cast<size_t>(shape[2])}));
+        expectEqualTensors(tensor, readTensor(reader));
+    }
+}
+
+TEST_F(NpyTest, RoundTripsBatchesForEverySyncPolicy)
+{
+    for (const NpySync sync : {NpySync::NONE, NpySync::DATASYNC, NpySync::DROP_CACHE})
+    {
+        const auto p_batch = std::make_shared<NpyWriter>(sync);
+        for (int f = 0; f < 3; ++f)
+        {
+            NpyWriter::save((m_dir / (std::to_string(f) + ".npy")).string(), makeTensor(4 + f, 6, 3), p_batch);
+        }
+        p_batch->finish();
+        for (int f = 0; f < 3; ++f)
+        {
+            expectEqualTensors(makeTensor(4 + f, 6, 3), readTensor(NpyReader((m_dir / (std::to_string(f) + ".npy")).string())));
+        }
+    }
+}
+
+TEST_F(NpyTest, ReadsCOrderFiles)
+{
+    // Rows past the 32-row transpose tile and several threads exercise partial tiles and chunk boundaries
+    const int rows = 75;
+    const int cols = 11;
+    const int channels = 3;
+    std::vector<float> values;
+    for (int i = 0; i < rows; ++i)
+    {
+        for (int j = 0; j < cols; ++j)
+        {
+            for (int k = 0; k < channels; ++k)
+            {
+                values.push_back(valueAt(i, j, k));
+            }
+        }
+    }
+    const std::filesystem::path file_path = m_dir / "c_order.npy";
+    writeNpy(file_path, "{'descr': '<f4', 'fortran_order': False, 'shape': (75, 11, 3), }", values);
+
+    const NpyReader reader(file_path.string());
+    EXPECT_FALSE(reader.isFortranOrder());
+    for (const unsigned int num_threads : {1u, 4u})
+    {
+        expectEqualTensors(makeTensor(rows, cols, channels), readTensor(reader, num_threads));
+    }
+}
+
+TEST_F(NpyTest, ReadsFortranOrderFilesWithFewerDimensions)
+{
+    const Eigen::Tensor<float, 3> tensor = makeTensor(4, 9, 1);
+    const std::filesystem::path file_path = m_dir / "fortran_order.npy";
+    writeNpy(file_path, "{\"descr\": \"<f4\", \"fortran_order\": True, \"shape\": (4, 9)}", std::vector<float>(tensor.data(), tensor.data() + tensor.size()));
+
+    const NpyReader reader(file_path.string());
+    EXPECT_TRUE(reader.isFortranOrder());
+    EXPECT_EQ(reader.getShape(), (std::vector<size_t>{4, 9, 1}));
+    expectEqualTensors(tensor, readTensor(reader));
+
+    writeNpy(file_path, "{'descr': '<f4', 'fortran_order': False, 'shape': (6,), }", {1, 2, 3, 4, 5, 6});
+    EXPECT_EQ(NpyReader(file_path.string()).getShape(), (std::vector<size_t>{6, 1, 1}));
+}
+
+TEST_F(NpyTest, RejectsMalformedHeaders)
+{
+    const std::filesystem::path file_path = m_dir / "malformed.npy";
+    const std::vector<float> values(24, 1.0f);
+    const std::string malformed_dicts[] = {
+        "{'descr': '<f8', 'fortran_order': True, 'shape': (2, 3, 4), }",
+        "{'descr': '>f4', 'fortran_order': True, 'shape': (2, 3, 4), }",
+        "{'fortran_order': True, 'shape': (2, 3, 4), }",
+        "{'descr': '<f4', 'fortran_order': True, }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': 2, 3, 4, }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': (), }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3, 2, 2), }",
+        "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3, 5), }"};
+    for (const std::string& dict : malformed_dicts)
+    {
+        writeNpy(file_path, dict, values);
+        EXPECT_THROW(NpyReader reader(file_path.string()), std::runtime_error) << dict;
+    }
+
+    writeNpy(file_path, "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3, 4), }", values);
+    {
+        std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.put('x');
+    }
+    EXPECT_THROW(NpyReader reader(file_path.string()), std::runtime_error);
+
+    writeNpy(file_path, "{'descr': '<f4', 'fortran_order': True, 'shape': (2, 3, 4), }", values);
+    std::filesystem::resize_file(file_path, 40);
+    EXPECT_THROW(NpyReader reader(file_path.string()), std::runtime_error);
+    std::filesystem::resize_file(file_path, 8);
+    EXPECT_THROW(NpyReader reader(file_path.string()), std::runtime_error);
+}
+
+TEST_F(NpyTest, RejectsMismatchedTensorDimensions)
+{
+    const std::string file_path = (m_dir / "tensor.npy").string();
+    NpyWriter::save(file_path, makeTensor(5, 7, 3));
+    const NpyReader reader(file_path);
+    Eigen::Tensor<float, 3> transposed(7, 5, 3);
+    EXPECT_THROW(reader.readTensor(transposed), std::runtime_error);
+}
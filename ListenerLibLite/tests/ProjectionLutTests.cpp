@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/PlyReader.h"
+#include "listener_processing/GridProjector.h"
+#include "listener_processing/ProjectionLut.h"
+
+namespace
+{
+    // Cepton mode 2 projection, matching the sensor that recorded the sample cloud
+    constexpr int rows = 184;
+    constexpr int cols = 500;
+
+    Eigen::Matrix3f makeIntrinsic()
+    {
+        Eigen::Matrix3f intrinsic;
+        intrinsic << 433.0f, 0.0f, cols / 2.0f, 0.0f, 433.0f, rows / 2.0f, 0.0f, 0.0f, 1.0f;
+        return intrinsic;
+    }
+
+    std::vector<float> loadSamplePoints()
+    {
+        const PlyReader ply_reader(std::string(LISTENERLIBLITE_RESOURCES_DIR) + "/cepton_test_data.ply");
+        std::vector<float> points(3 * ply_reader.getVertexCount());
+        ply_reader.readPoints(points.data());
+        return points;
+    }
+
+    /*!
+     * @brief One frame of the sample scan pattern, in which every beam is the vertex index of the sample cloud.
+     */
+    struct Frame
+    {
+        std::vector<float> m_points;
+        std::vector<uint32_t> m_beamIDs;
+    };
+
+    // Drops a tenth of the beams and scales the range of every other one by up to a percent, keeping its direction
+    Frame makeJitteredFrame(const std::vector<float>& pattern, std::mt19937& rng)
+    {
+        std::bernoulli_distribution returned(0.9);
+        std::uniform_real_distribution<float> range_scale(0.99f, 1.01f);
+        Frame frame;
+        for (size_t b = 0; b < pattern.size() / 3; ++b)
+        {
+            if (!returned(rng))
+            {
+                continue;
+            }
+            const float scale = range_scale(rng);
+            frame.m_points.insert(frame.m_points.end(), {scale * pattern[3 * b], scale * pattern[3 * b + 1], scale * pattern[3 * b + 2]});
+            frame.m_beamIDs.push_back(static_cast<uint32_t>(b));
+        }
+        return frame;
+    }
+
+    // Row-major pixel of a point, following the projection of GridProjector
+    int32_t projectPixel(const Eigen::Matrix3f& intrinsic, const float* p_point)
+    {
+        const float inv_z = 1.0f / p_point[2];
+        const float u = intrinsic(0, 0) * p_point[0] * inv_z + intrinsic(0, 2);
+        const float v = intrinsic(1, 1) * p_point[1] * inv_z + intrinsic(1, 2);
+        if (!(u >= 0.0f && u < static_cast<float>(cols) && v >= 0.0f && v < static_cast<float>(rows)))
+        {
+            return -1;
+        }
+        return static_cast<int32_t>(v) * cols + static_cast<int32_t>(u);
+    }
+
+    std::vector<int32_t> lookupFrame(ProjectionLut& lut, const Frame& frame)
+    {
+        std::vector<int32_t> pixels(frame.m_beamIDs.size());
+        lut.verify(frame.m_points.data(), frame.m_beamIDs.data(), frame.m_beamIDs.size());
+        lut.lookup(frame.m_points.data(), frame.m_beamIDs.data(), frame.m_beamIDs.size(), pixels.data());
+        return pixels;
+    }
+}
+
+TEST(ProjectionLut, FollowsJitteredSampleBeamsWithoutResets)
+{
+    const std::vector<float> pattern = loadSamplePoints();
+    const Eigen::Matrix3f intrinsic = makeIntrinsic();
+    ProjectionLut lut(intrinsic, rows, cols, pattern.size() / 3);
+    std::mt19937 rng(1);
+
+    size_t num_looked_up = 0;
+    size_t num_moved = 0;
+    for (int f = 0; f < 200; ++f)
+    {
+        const Frame frame = makeJitteredFrame(pattern, rng);
+        const std::vector<int32_t> pixels = lookupFrame(lut, frame);
+        for (size_t n = 0; n < pixels.size(); ++n)
+        {
+            // A cached pixel may only differ from the direct projection by rounding across a pixel boundary
+            const int32_t projected = projectPixel(intrinsic, &frame.m_points[3 * n]);
+            if (pixels[n] == projected)
+            {
+                continue;
+            }
+            ++num_moved;
+            ASSERT_GE(pixels[n], 0);
+            ASSERT_GE(projected, 0);
+            EXPECT_LE(std::abs(pixels[n] / cols - projected / cols), 1);
+            EXPECT_LE(std::abs(pixels[n] % cols - projected % cols), 1);
+        }
+        num_looked_up += pixels.size();
+    }
+    EXPECT_EQ(lut.getNumResets(), 0u);
+    EXPECT_LT(num_moved, num_looked_up / 1000);
+}
+
+TEST(ProjectionLut, RestoresOnlyTheBeamThatMoved)
+{
+    const std::vector<float> pattern = loadSamplePoints();
+    const Eigen::Matrix3f intrinsic = makeIntrinsic();
+    ProjectionLut lut(intrinsic, rows, cols, pattern.size() / 3);
+    Frame frame;
+    frame.m_points = pattern;
+    frame.m_beamIDs.resize(pattern.size() / 3);
+    std::iota(frame.m_beamIDs.begin(), frame.m_beamIDs.end(), 0u);
+    const std::vector<int32_t> first_pixels = lookupFrame(lut, frame);
+
+    // Point beam 0 somewhere else, it is checked within one rotation through the beams and only its entry is replaced
+    frame.m_points[0] = 0.0f;
+    frame.m_points[1] = 0.0f;
+    frame.m_points[2] = 10.0f;
+    const int32_t moved_pixel = projectPixel(intrinsic, frame.m_points.data());
+    ASSERT_NE(first_pixels[0], moved_pixel);
+    std::vector<int32_t> pixels;
+    for (int f = 0; f < 64; ++f)
+    {
+        pixels = lookupFrame(lut, frame);
+    }
+    EXPECT_EQ(pixels[0], moved_pixel);
+    EXPECT_EQ(lut.getNumRestores(), 1u);
+    EXPECT_EQ(lut.getNumResets(), 0u);
+    EXPECT_TRUE(std::equal(pixels.begin() + 1, pixels.end(), first_pixels.begin() + 1));
+}
+
+TEST(ProjectionLut, ClearsTheTableForIDsThatAreNotBeams)
+{
+    const std::vector<float> pattern = loadSamplePoints();
+    const Eigen::Matrix3f intrinsic = makeIntrinsic();
+    ProjectionLut lut(intrinsic, rows, cols, pattern.size() / 3);
+    std::mt19937 rng(2);
+    for (int f = 0; f < 3; ++f)
+    {
+        // Shuffled IDs name a different direction in every frame
+        Frame frame;
+        frame.m_points = pattern;
+        frame.m_beamIDs.resize(pattern.size() / 3);
+        std::iota(frame.m_beamIDs.begin(), frame.m_beamIDs.end(), 0u);
+        std::shuffle(frame.m_beamIDs.begin(), frame.m_beamIDs.end(), rng);
+
+        const std::vector<int32_t> pixels = lookupFrame(lut, frame);
+        for (size_t n = 0; n < pixels.size(); ++n)
+        {
+            ASSERT_EQ(pixels[n], projectPixel(intrinsic, &frame.m_points[3 * n])) << "frame " << f << ", point " << n;
+        }
+        EXPECT_EQ(lut.getNumResets(), static_cast<size_t>(f));
+    }
+}
+
+TEST(ProjectionLut, OrganizesTheSampleLikeTheDirectProjection)
+{
+    const std::vector<float> pattern = loadSamplePoints();
+    const Eigen::Matrix3f intrinsic = makeIntrinsic();
+    ProjectionLut lut(intrinsic, rows, cols, pattern.size() / 3);
+    std::mt19937 rng(3);
+    const Frame frame = makeJitteredFrame(pattern, rng);
+
+    GridProjector projector(intrinsic, rows, cols);
+    Eigen::Tensor<float, 3> direct_grid(rows, cols, 3);
+    direct_grid.setZero();
+    projector.project(frame.m_points.data(), frame.m_beamIDs.size(), direct_grid);
+    for (int f = 0; f < 2; ++f)
+    {
+        // The first frame fills the table and the second one is looked up from it
+        Eigen::Tensor<float, 3> lut_grid(rows, cols, 3);
+        lut_grid.setZero();
+        projector.project(frame.m_points.data(), frame.m_beamIDs.data(), frame.m_beamIDs.size(), lut, lut_grid);
+        ASSERT_TRUE(std::equal(direct_grid.data(), direct_grid.data() + direct_grid.size(), lut_grid.data())) << "frame " << f;
+    }
+
+    ProjectionLut other_lut(intrinsic, rows / 2, cols / 2, pattern.size() / 3);
+    Eigen::Tensor<float, 3> grid(rows, cols, 3);
+    EXPECT_THROW(projector.project(frame.m_points.data(), frame.m_beamIDs.data(), frame.m_beamIDs.size(), other_lut, grid), std::runtime_error);
+}
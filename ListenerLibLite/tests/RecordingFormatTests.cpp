@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <filesystem>
+
+#include <Eigen/Dense>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/CamParameters.hpp"
+#include "listener_utils/RecordingFormat.hpp"
+#include "listener_utils/RecordingWriter.h"
+#include "listener_utils/RecordingReader.h"
+#include "listener_frames/GridFrame.h"
+#include "listener_frames/RGBFrame.h"
+#include "listener_frames/MaskFrame.h"
+
+/*!
+ * @brief Fixture recording three frames of grid, RGB, and mask data to a temporary recording.
+ */
+class RecordingFormatTest : public ::testing::Test
+{
+protected:
+
+    static constexpr int numFrames = 3;
+
+    std::filesystem::path m_dir;
+    std::string m_filePath;
+    std::shared_ptr<CamParameters> m_camParamsPtr;
+    std::shared_ptr<Eigen::Matrix4f> m_extrinsicPtr;
+    std::vector<std::shared_ptr<GridFrame>> m_grids;
+    std::vector<std::shared_ptr<RGBFrame>> m_images;
+    std::vector<std::shared_ptr<MaskFrame>> m_masks;
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "RecordingFormatTest";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+        m_filePath = (m_dir / (std::string("recording") + RecordingWriter::fileExtension)).string();
+
+        auto p_intrinsic = std::make_shared<Eigen::Matrix3f>();
+        *p_intrinsic << 500.0f, 0.0f, 320.0f, 0.0f, 510.0f, 240.0f, 0.0f, 0.0f, 1.0f;
+        m_camParamsPtr = std::make_shared<CamParameters>(p_intrinsic, std::make_shared<std::vector<float>>(std::vector<float>{0.1f, -0.2f, 0.0f, 0.0f, 0.3f}));
+        m_extrinsicPtr = std::make_shared<Eigen::Matrix4f>(Eigen::Matrix4f::Identity());
+        (*m_extrinsicPtr)(0, 3) = 0.25f;
+
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> depth(0.5f, 10.0f);
+        for (int f = 0; f < numFrames; ++f)
+        {
+            auto p_grid = std::make_shared<Eigen::Tensor<float, 3>>(7, 5, 3);
+            auto p_image = std::make_shared<Eigen::Tensor<unsigned char, 3>>(7, 5, 3);
+            auto p_mask = std::make_shared<Eigen::Tensor<bool, 3>>(7, 5, 1);
+            for (Eigen::Index i = 0; i < p_grid->size(); ++i)
+            {
+                p_grid->data()[i] = depth(rng);
+                p_image->data()[i] = static_cast<unsigned char>(rng());
+            }
+            for (Eigen::Index i = 0; i < p_mask->size(); ++i)
+            {
+                p_mask->data()[i] = (rng() & 1) != 0;
+            }
+            m_grids.push_back(std::make_shared<GridFrame>(p_grid, m_camParamsPtr, m_extrinsicPtr));
+            m_images.push_back(std::make_shared<RGBFrame>(p_image, m_camParamsPtr, m_extrinsicPtr));
+            m_masks.push_back(std::make_shared<MaskFrame>(p_mask, m_camParamsPtr, m_extrinsicPtr));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    static std::chrono::microseconds getTimestamp(const int frame)
+    {
+        return std::chrono::microseconds(1700000000000000 + frame * 33333);
+    }
+
+    void writeFrames(RecordingWriter& writer, const int first, const int last) const
+    {
+        for (int f = first; f < last; ++f)
+        {
+            writer.append(f, getTimestamp(f), FrameID::POINTCLOUD_GRID, *m_grids[f]);
+            writer.append(f, getTimestamp(f), FrameID::RGB_IMAGE, *m_images[f]);
+            writer.append(f, getTimestamp(f), FrameID::POINTCLOUD_MASK, *m_masks[f]);
+        }
+    }
+
+    template <typename T>
+    static void expectEqualData(const DataFrame<T>& expected, const GenericDataFrame& actual)
+    {
+        const auto* p_actual = dynamic_cast<const DataFrame<T>*>(&actual);
+        ASSERT_NE(p_actual, nullptr);
+        ASSERT_EQ(expected.getData().dimensions(), p_actual->getData().dimensions());
+        EXPECT_EQ(std::memcmp(expected.getData().data(), p_actual->getData().data(), expected.getData().size() * sizeof(T)), 0);
+    }
+
+    void expectFrames(const RecordingReader& reader, const int num_frames) const
+    {
+        ASSERT_EQ(reader.getNumFrames(), static_cast<size_t>(num_frames));
+        EXPECT_EQ(reader.getFrameIDs(), (std::vector<FrameID>{FrameID::POINTCLOUD_GRID, FrameID::RGB_IMAGE, FrameID::POINTCLOUD_MASK}));
+        for (int f = 0; f < num_frames; ++f)
+        {
+            EXPECT_EQ(reader.getFrameNumber(f), static_cast<unsigned int>(f));
+            EXPECT_EQ(reader.getTimestamp(f), getTimestamp(f));
+            EXPECT_FALSE(reader.has(f, FrameID::TEMPERATURE_GRID));
+            expectEqualData(*m_grids[f], *reader.readFrame(f, FrameID::POINTCLOUD_GRID, m_camParamsPtr, m_extrinsicPtr));
+            expectEqualData(*m_images[f], *reader.readFrame(f, FrameID::RGB_IMAGE, m_camParamsPtr, m_extrinsicPtr));
+            expectEqualData(*m_masks[f], *reader.readFrame(f, FrameID::POINTCLOUD_MASK, m_camParamsPtr, m_extrinsicPtr));
+        }
+    }
+
+    std::vector<char> readFile() const
+    {
+        std::ifstream file(m_filePath, std::ios::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::vector<char>& data) const
+    {
+        std::ofstream file(m_filePath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+};
+
+TEST_F(RecordingFormatTest, ReadsWrittenFramesAndStreamParameters)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, numFrames);
+        EXPECT_EQ(writer.getNumChunks(), 3u * numFrames);
+    }
+
+    const RecordingReader reader(m_filePath);
+    EXPECT_TRUE(RecordingReader::isRecording(m_filePath));
+    EXPECT_TRUE(reader.isIndexed());
+    expectFrames(reader, numFrames);
+    EXPECT_EQ(*reader.getCamParams()->m_intrinsicPtr, *m_camParamsPtr->m_intrinsicPtr);
+    EXPECT_EQ(*reader.getCamParams()->m_distortionPtr, *m_camParamsPtr->m_distortionPtr);
+    EXPECT_EQ(*reader.getExtrinsic(), *m_extrinsicPtr);
+}
+
+TEST_F(RecordingFormatTest, RecoversFramesOfTruncatedFooterByChunkScan)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, numFrames);
+    }
+    std::filesystem::resize_file(m_filePath, std::filesystem::file_size(m_filePath) - sizeof(recording_format::Trailer) / 2);
+
+    const RecordingReader reader(m_filePath);
+    EXPECT_FALSE(reader.isIndexed());
+    expectFrames(reader, numFrames);
+}
+
+TEST_F(RecordingFormatTest, RecoversCompleteChunksOfInterruptedRecording)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, numFrames);
+    }
+    // Cutting into the last chunk, the mask of the last frame, leaves only the chunks before it
+    const uint64_t index_size = 3 * numFrames * sizeof(recording_format::IndexEntry) + sizeof(recording_format::Trailer);
+    std::filesystem::resize_file(m_filePath, std::filesystem::file_size(m_filePath) - index_size - recording_format::alignment - 1);
+
+    const RecordingReader reader(m_filePath);
+    EXPECT_FALSE(reader.isIndexed());
+    ASSERT_EQ(reader.getNumFrames(), static_cast<size_t>(numFrames));
+    EXPECT_TRUE(reader.has(numFrames - 1, FrameID::RGB_IMAGE));
+    EXPECT_FALSE(reader.has(numFrames - 1, FrameID::POINTCLOUD_MASK));
+}
+
+TEST_F(RecordingFormatTest, AppendsToClosedAndInterruptedRecordings)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, 1);
+    }
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr, true);
+        EXPECT_EQ(writer.getNumChunks(), 3u);
+        writeFrames(writer, 1, 2);
+    }
+    std::filesystem::resize_file(m_filePath, std::filesystem::file_size(m_filePath) - 1);
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr, true);
+        EXPECT_EQ(writer.getNumChunks(), 6u);
+        writeFrames(writer, 2, numFrames);
+    }
+
+    const RecordingReader reader(m_filePath);
+    EXPECT_TRUE(reader.isIndexed());
+    expectFrames(reader, numFrames);
+}
+
+TEST_F(RecordingFormatTest, RejectsAppendWithDifferentStreamParameters)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, 1);
+    }
+
+    auto p_other_intrinsic = std::make_shared<Eigen::Matrix3f>(*m_camParamsPtr->m_intrinsicPtr);
+    (*p_other_intrinsic)(0, 2) += 1.0f;
+    const auto p_other_cam_params = std::make_shared<CamParameters>(p_other_intrinsic, m_camParamsPtr->m_distortionPtr);
+    EXPECT_THROW(RecordingWriter writer(m_filePath, p_other_cam_params, m_extrinsicPtr, true), std::runtime_error);
+
+    const auto p_other_distortion = std::make_shared<CamParameters>(m_camParamsPtr->m_intrinsicPtr, std::make_shared<std::vector<float>>(5, 0.0f));
+    EXPECT_THROW(RecordingWriter writer(m_filePath, p_other_distortion, m_extrinsicPtr, true), std::runtime_error);
+
+    const auto p_other_extrinsic = std::make_shared<Eigen::Matrix4f>(Eigen::Matrix4f::Identity());
+    EXPECT_THROW(RecordingWriter writer(m_filePath, m_camParamsPtr, p_other_extrinsic, true), std::runtime_error);
+
+    // A rejected append leaves the recording untouched
+    const RecordingReader reader(m_filePath);
+    EXPECT_TRUE(reader.isIndexed());
+    expectFrames(reader, 1);
+}
+
+TEST_F(RecordingFormatTest, RejectsCorruptFileMagic)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, 1);
+    }
+    std::vector<char> data = readFile();
+    data[0] = 'X';
+    writeFile(data);
+
+    EXPECT_THROW(RecordingReader reader(m_filePath), std::runtime_error);
+    EXPECT_THROW(RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr, true), std::runtime_error);
+}
+
+TEST_F(RecordingFormatTest, RejectsCorruptChunks)
+{
+    {
+        RecordingWriter writer(m_filePath, m_camParamsPtr, m_extrinsicPtr);
+        writeFrames(writer, 0, 1);
+    }
+    std::vector<char> data = readFile();
+    recording_format::FileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    // The first chunk holds the grid, so its footer entry no longer matches a chunk of another FrameID
+    data[header.m_dataOffset + offsetof(recording_format::ChunkHeader, m_frameID)] = static_cast<char>(FrameID::TEMPERATURE_GRID);
+    writeFile(data);
+    {
+        const RecordingReader reader(m_filePath);
+        ASSERT_TRUE(reader.isIndexed());
+        EXPECT_THROW(reader.readFrame(0, FrameID::POINTCLOUD_GRID, m_camParamsPtr, m_extrinsicPtr), std::runtime_error);
+        EXPECT_NO_THROW(reader.readFrame(0, FrameID::RGB_IMAGE, m_camParamsPtr, m_extrinsicPtr));
+    }
+
+    data[header.m_dataOffset + offsetof(recording_format::ChunkHeader, m_frameID)] = static_cast<char>(FrameID::POINTCLOUD_GRID);
+    data[header.m_dataOffset] ^= 0x55;
+    writeFile(data);
+    {
+        const RecordingReader reader(m_filePath);
+        EXPECT_THROW(reader.readFrame(0, FrameID::POINTCLOUD_GRID, m_camParamsPtr, m_extrinsicPtr), std::runtime_error);
+    }
+
+    // Without the footer, scanning stops at the corrupt first chunk
+    std::filesystem::resize_file(m_filePath, data.size() - 1);
+    {
+        const RecordingReader reader(m_filePath);
+        EXPECT_FALSE(reader.isIndexed());
+        EXPECT_EQ(reader.getNumFrames(), 0u);
+    }
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/general_utils.hpp"
+#include "listener_utils/NpyWriter.h"
+#include "listener_utils/DatasetIndex.h"
+#include "listener_frames/CompositeFrame.h"
+#include "listener_frames/GenericDataFrame.h"
+#include "listener_frames/TempFrame.h"
+#include "emulation_listeners/SavedListener.h"
+#include "sensor_interfaces/CeptonInterface.h"
+
+/*!
+ * @brief Fixture providing a temporary dataset of temperature grids recorded with known timestamps.
+ *
+ * Every grid is filled with its frame number, so that published frames can be traced back to the file they came from.
+ */
+class SavedListenerTest : public ::testing::Test
+{
+protected:
+
+    static constexpr int numFrames = 3;
+
+    std::filesystem::path m_dir;
+
+    void SetUp() override
+    {
+        m_dir = std::filesystem::temp_directory_path() / "SavedListenerTest";
+        std::filesystem::remove_all(m_dir);
+        const std::filesystem::path frame_dir = m_dir / FrameIDUtils::toString(FrameID::TEMPERATURE_GRID);
+        std::filesystem::create_directories(frame_dir);
+
+        std::unordered_map<unsigned int, std::chrono::microseconds> timestamps;
+        for (int f = 0; f < numFrames; ++f)
+        {
+            Eigen::Tensor<float, 3> grid(4, 6, 1);
+            grid.setConstant(static_cast<float>(f));
+            NpyWriter::save((frame_dir / ("frame_" + std::to_string(f) + ".npy")).string(), grid);
+            timestamps[f] = recordedTimestamp(f);
+        }
+        DatasetIndex index = DatasetIndex::scan(m_dir.string(), {FrameID::TEMPERATURE_GRID});
+        index.setTimestamps(timestamps);
+        index.save();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_dir);
+    }
+
+    static std::chrono::microseconds recordedTimestamp(const int frame_number)
+    {
+        return std::chrono::microseconds(1000000 + 1000 * frame_number);
+    }
+
+    std::unique_ptr<SavedListener> makeListener(const bool repeat, const PlaybackParameters& playback_params) const
+    {
+        auto p_listener = std::make_unique<SavedListener>(std::vector<FrameID>{FrameID::TEMPERATURE_GRID}, m_dir.string(), std::make_shared<CeptonInterface>(2, 50, false), "SavedListenerTest", 1.0f, repeat, playback_params);
+        p_listener->setTimeoutDuration(std::chrono::milliseconds(5000));
+        return p_listener;
+    }
+
+    // Replaces the grid of a frame with bytes that are not an NPY file, so that decoding it fails
+    void corruptFrame(const int frame_number) const
+    {
+        std::ofstream file(m_dir / FrameIDUtils::toString(FrameID::TEMPERATURE_GRID) / ("frame_" + std::to_string(frame_number) + ".npy"), std::ios::binary | std::ios::trunc);
+        file << "not an npy file";
+    }
+
+    // Waits for the stream to stop by itself, returning whether it did within the timeout
+    static bool waitForStop(const SavedListener& listener, const std::chrono::milliseconds& timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (listener.getIsStreaming() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return !listener.getIsStreaming();
+    }
+
+    static int frameNumberOf(const CompositeFrame& composite_frame)
+    {
+        return static_cast<int>(std::dynamic_pointer_cast<TempFrame>(composite_frame.getFrame(FrameID::TEMPERATURE_GRID))->getData()(0, 0, 0));
+    }
+};
+
+TEST_F(SavedListenerTest, KeepsRecordedTimestampsOnlyForTheFirstLoopPass)
+{
+    PlaybackParameters playback_params;
+    playback_params.m_loop = true;
+    playback_params.m_timing = PlaybackTiming::AS_FAST_AS_POSSIBLE;
+    const auto p_listener = makeListener(false, playback_params);
+    p_listener->startStream();
+    std::vector<std::shared_ptr<CompositeFrame>> frames;
+    for (int f = 0; f < 3 * numFrames + 1; ++f)
+    {
+        frames.push_back(p_listener->getNextFrame());
+    }
+    p_listener->stopStream();
+
+    for (size_t f = 0; f < frames.size(); ++f)
+    {
+        SCOPED_TRACE("frame " + std::to_string(f));
+        const int frame_number = static_cast<int>(f) % numFrames;
+        EXPECT_EQ(frameNumberOf(*frames[f]), frame_number);
+        EXPECT_EQ(frames[f]->getSequenceNumber(), f);
+
+        // The last frame of the first pass is published before the pass wraps, so it keeps its recorded timestamp as well
+        const std::chrono::microseconds loaded = frames[f]->getFrame(FrameID::TEMPERATURE_GRID)->getLoadedTimestamp();
+        EXPECT_EQ(loaded, f < numFrames ? recordedTimestamp(frame_number) : std::chrono::microseconds::zero());
+        if (f > 0)
+        {
+            EXPECT_GT(frames[f]->getTimestamp(), frames[f - 1]->getTimestamp());
+        }
+    }
+}
+
+TEST_F(SavedListenerTest, StopsRepeatingALastFrameThatFailsToLoad)
+{
+    corruptFrame(numFrames - 1);
+    PlaybackParameters playback_params;
+    playback_params.m_timing = PlaybackTiming::AS_FAST_AS_POSSIBLE;
+    const auto p_listener = makeListener(true, playback_params);
+    p_listener->startStream();
+    for (int f = 0; f < numFrames - 1; ++f)
+    {
+        EXPECT_EQ(frameNumberOf(*p_listener->getNextFrame()), f);
+    }
+    EXPECT_TRUE(waitForStop(*p_listener, std::chrono::milliseconds(2000)));
+    p_listener->stopStream();
+}
+
+TEST_F(SavedListenerTest, StopsLoopingWhenEveryFrameFailsToLoad)
+{
+    for (int f = 0; f < numFrames; ++f)
+    {
+        corruptFrame(f);
+    }
+    PlaybackParameters playback_params;
+    playback_params.m_loop = true;
+    playback_params.m_timing = PlaybackTiming::AS_FAST_AS_POSSIBLE;
+    const auto p_listener = makeListener(false, playback_params);
+    p_listener->startStream();
+    EXPECT_TRUE(waitForStop(*p_listener, std::chrono::milliseconds(2000)));
+    p_listener->stopStream();
+}
+
+TEST_F(SavedListenerTest, KeepsLoopingPastAFrameThatFailsToLoad)
+{
+    corruptFrame(1);
+    PlaybackParameters playback_params;
+    playback_params.m_loop = true;
+    playback_params.m_timing = PlaybackTiming::AS_FAST_AS_POSSIBLE;
+    const auto p_listener = makeListener(false, playback_params);
+    p_listener->startStream();
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        EXPECT_EQ(frameNumberOf(*p_listener->getNextFrame()), 0);
+        EXPECT_EQ(frameNumberOf(*p_listener->getNextFrame()), 2);
+    }
+    p_listener->stopStream();
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include "listener_utils/TensorPool.hpp"
+
+using listener_utils::TensorPool;
+
+TEST(TensorPool, ReusesTensorsOnlyAfterTheirLastOwnerReleasesThem)
+{
+    TensorPool<float> pool(2);
+    auto p_first = pool.acquire(4, 5, 3);
+    const Eigen::Tensor<float, 3>* p_first_address = p_first.get();
+    auto p_frame_copy = p_first;
+
+    // Still held by the frame copy, so a new tensor is allocated
+    p_first.reset();
+    auto p_second = pool.acquire(4, 5, 3);
+    EXPECT_NE(p_second.get(), p_first_address);
+
+    p_frame_copy.reset();
+    auto p_third = pool.acquire(4, 5, 3);
+    EXPECT_EQ(p_third.get(), p_first_address);
+    EXPECT_EQ(p_third->dimension(0), 4);
+    EXPECT_EQ(p_third->dimension(1), 5);
+    EXPECT_EQ(p_third->dimension(2), 3);
+}
+
+TEST(TensorPool, KeepsAtMostItsCapacity)
+{
+    TensorPool<float> pool(1);
+    auto p_first = pool.acquire(2, 2, 1);
+    auto p_second = pool.acquire(2, 2, 1);
+    const Eigen::Tensor<float, 3>* p_first_address = p_first.get();
+    p_first.reset();
+    p_second.reset();
+
+    auto p_reused = pool.acquire(2, 2, 1);
+    auto p_allocated = pool.acquire(2, 2, 1);
+    EXPECT_EQ(p_reused.get(), p_first_address);
+    EXPECT_NE(p_allocated.get(), p_first_address);
+}
+
+TEST(TensorPool, DropsTensorsOfAnotherSize)
+{
+    TensorPool<bool> pool(2);
+    auto p_old = pool.acquire(3, 3, 1);
+    auto p_new = pool.acquire(6, 3, 1);
+    p_old.reset();
+    p_new.reset();
+
+    auto p_tensor = pool.acquire(6, 3, 1);
+    EXPECT_EQ(p_tensor->dimension(0), 6);
+    auto p_other = pool.acquire(6, 3, 1);
+    EXPECT_EQ(p_other->dimension(0), 6);
+    EXPECT_NE(p_tensor.get(), p_other.get());
+}
+
+TEST(TensorPool, ReleasesTensorsThatOutliveThePool)
+{
+    std::shared_ptr<Eigen::Tensor<float, 3>> p_tensor;
+    {
+        TensorPool<float> pool(2);
+        p_tensor = pool.acquire(8, 8, 3);
+        p_tensor->setConstant(1.0f);
+    }
+    EXPECT_EQ((*p_tensor)(7, 7, 2), 1.0f);
+    p_tensor.reset();
+}
+
+TEST(TensorPool, TakesBackTensorsReleasedOnOtherThreads)
+{
+    TensorPool<float> pool(4);
+    for (int round = 0; round < 50; ++round)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([p_tensor = pool.acquire(16, 16, 3)]() mutable
+            {
+                p_tensor->setZero();
+                p_tensor.reset();
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    EXPECT_NE(pool.acquire(16, 16, 3), nullptr);
+}